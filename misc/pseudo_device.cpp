@@ -0,0 +1,554 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Creates a pseudo terminal and streams test data over it at high
+  rates. This is a faster replacement for `pseudo_device.py` that can
+  also generate binary and framed data, intended for load testing the
+  readers through the real serial port path. Only works on unix like
+  systems.
+
+  Open the printed slave terminal (or the --link path) in serialplot.
+  Run with --help for options.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+enum class Mode {ascii, binary, framed};
+enum class Format {u8, i8, u16, i16, u32, i32, f32, f64};
+enum class Checksum {none, sum8, crc16, crc32};
+
+struct Options
+{
+    Mode mode = Mode::ascii;
+    Format format = Format::i16;
+    bool bigEndian = false;
+    unsigned channels = 4;
+    double rate = 1000;         ///< samples per second per channel, 0: unlimited
+    double duration = 0;        ///< seconds, 0: forever
+    std::vector<uint8_t> sync = {0xAA, 0xBB};
+    unsigned sizeField = 0;     ///< 0: fixed size frame, 1 or 2 bytes
+    unsigned frameSamples = 10; ///< samples (per channel) in a frame
+    Checksum checksum = Checksum::sum8;
+    bool sequence = false;      ///< add 1 byte sequence number to frames
+    double corruption = 0;      ///< probability of corrupting a frame/line
+    double period = 100;        ///< waveform period in samples
+    std::string link;           ///< symlink to create for slave terminal
+};
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int)
+{
+    stopRequested = 1;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --mode ascii|binary|framed  data format (default: ascii)\n"
+            "  --format FMT           u8, i8, u16, i16, u32, i32, float, double (default: i16)\n"
+            "  --big-endian           use big endian byte order\n"
+            "  --channels N           number of channels (default: 4)\n"
+            "  --rate N               samples per second per channel, 0 for unlimited (default: 1000)\n"
+            "  --duration S           stop after S seconds (default: run until interrupted)\n"
+            "  --period N             waveform period in samples (default: 100)\n"
+            "  --sync HEX             frame sync word (default: AABB)\n"
+            "  --size-field 0|1|2     frame size field length, 0 for fixed size (default: 0)\n"
+            "  --frame-samples N      samples per channel in a frame (default: 10)\n"
+            "  --checksum TYPE        none, sum8, crc16, crc32 (default: sum8)\n"
+            "  --no-checksum          don't append checksum to frames\n"
+            "  --sequence             add 1 byte sequence number after frame size\n"
+            "  --corrupt P            corrupt a byte in a frame/line with probability P\n"
+            "  --link PATH            create a symbolic link to slave terminal\n",
+            name);
+}
+
+static bool parseHex(const char* text, std::vector<uint8_t>& bytes)
+{
+    size_t len = strlen(text);
+    if (len == 0 || len % 2 != 0) return false;
+
+    bytes.clear();
+    for (size_t i = 0; i < len; i += 2)
+    {
+        char byte[3] = {text[i], text[i+1], 0};
+        char* end;
+        bytes.push_back(strtoul(byte, &end, 16));
+        if (*end != 0) return false;
+    }
+    return true;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        const char* value = hasValue ? argv[i+1] : "";
+
+        if (arg == "--help" || arg == "-h")
+        {
+            return false;
+        }
+        else if (arg == "--big-endian")
+        {
+            opt.bigEndian = true;
+            continue;
+        }
+        else if (arg == "--no-checksum")
+        {
+            opt.checksum = Checksum::none;
+            continue;
+        }
+        else if (arg == "--sequence")
+        {
+            opt.sequence = true;
+            continue;
+        }
+
+        if (!hasValue)
+        {
+            fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        i++;
+
+        std::string v = value;
+        if (arg == "--mode")
+        {
+            if (v == "ascii") opt.mode = Mode::ascii;
+            else if (v == "binary") opt.mode = Mode::binary;
+            else if (v == "framed") opt.mode = Mode::framed;
+            else return false;
+        }
+        else if (arg == "--format")
+        {
+            if (v == "u8") opt.format = Format::u8;
+            else if (v == "i8") opt.format = Format::i8;
+            else if (v == "u16") opt.format = Format::u16;
+            else if (v == "i16") opt.format = Format::i16;
+            else if (v == "u32") opt.format = Format::u32;
+            else if (v == "i32") opt.format = Format::i32;
+            else if (v == "float") opt.format = Format::f32;
+            else if (v == "double") opt.format = Format::f64;
+            else return false;
+        }
+        else if (arg == "--checksum")
+        {
+            if (v == "none") opt.checksum = Checksum::none;
+            else if (v == "sum8") opt.checksum = Checksum::sum8;
+            else if (v == "crc16") opt.checksum = Checksum::crc16;
+            else if (v == "crc32") opt.checksum = Checksum::crc32;
+            else return false;
+        }
+        else if (arg == "--channels") opt.channels = atoi(value);
+        else if (arg == "--rate") opt.rate = atof(value);
+        else if (arg == "--duration") opt.duration = atof(value);
+        else if (arg == "--period") opt.period = atof(value);
+        else if (arg == "--size-field") opt.sizeField = atoi(value);
+        else if (arg == "--frame-samples") opt.frameSamples = atoi(value);
+        else if (arg == "--corrupt") opt.corruption = atof(value);
+        else if (arg == "--link") opt.link = v;
+        else if (arg == "--sync")
+        {
+            if (!parseHex(value, opt.sync))
+            {
+                fprintf(stderr, "Invalid sync word: %s\n", value);
+                return false;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (opt.channels == 0 || opt.sizeField > 2 || opt.frameSamples == 0 ||
+        opt.period <= 0 || opt.rate < 0)
+    {
+        fprintf(stderr, "Invalid option value.\n");
+        return false;
+    }
+    return true;
+}
+
+static unsigned sampleSize(Format format)
+{
+    switch (format)
+    {
+        case Format::u8: case Format::i8: return 1;
+        case Format::u16: case Format::i16: return 2;
+        case Format::u32: case Format::i32: case Format::f32: return 4;
+        case Format::f64: return 8;
+    }
+    return 1;
+}
+
+/// Appends `size` bytes of `value` in selected byte order
+static void appendBytes(std::vector<uint8_t>& out, uint64_t value, unsigned size, bool bigEndian)
+{
+    for (unsigned i = 0; i < size; i++)
+    {
+        unsigned shift = 8 * (bigEndian ? size - 1 - i : i);
+        out.push_back((value >> shift) & 0xFF);
+    }
+}
+
+/// Appends checksum of bytes from `start`, multi byte checksums in selected byte order
+static void appendChecksum(std::vector<uint8_t>& out, size_t start, const Options& opt)
+{
+    switch (opt.checksum)
+    {
+        case Checksum::none:
+            break;
+        case Checksum::sum8:
+        {
+            uint8_t sum = 0;
+            for (size_t i = start; i < out.size(); i++) sum += out[i];
+            out.push_back(sum);
+            break;
+        }
+        case Checksum::crc16: // CCITT-FALSE
+        {
+            uint16_t crc = 0xFFFF;
+            for (size_t i = start; i < out.size(); i++)
+            {
+                crc ^= out[i] << 8;
+                for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+            }
+            appendBytes(out, crc, 2, opt.bigEndian);
+            break;
+        }
+        case Checksum::crc32:
+        {
+            uint32_t crc = 0xFFFFFFFF;
+            for (size_t i = start; i < out.size(); i++)
+            {
+                crc ^= out[i];
+                for (int b = 0; b < 8; b++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+            }
+            appendBytes(out, ~crc, 4, opt.bigEndian);
+            break;
+        }
+    }
+}
+
+/// Appends a sample in [-1, 1] range scaled to the selected number format
+static void appendSample(std::vector<uint8_t>& out, double v, const Options& opt)
+{
+    uint64_t raw = 0;
+    switch (opt.format)
+    {
+        case Format::u8:  raw = uint8_t(lround((v + 1) * 127.5)); break;
+        case Format::i8:  raw = uint8_t(int8_t(lround(v * 127))); break;
+        case Format::u16: raw = uint16_t(lround((v + 1) * 32767.5)); break;
+        case Format::i16: raw = uint16_t(int16_t(lround(v * 32767))); break;
+        case Format::u32: raw = uint32_t(llround((v + 1) * 2147483647.5)); break;
+        case Format::i32: raw = uint32_t(int32_t(lround(v * 2147483647.))); break;
+        case Format::f32:
+        {
+            float f = v;
+            uint32_t u;
+            memcpy(&u, &f, sizeof(u));
+            raw = u;
+            break;
+        }
+        case Format::f64:
+            memcpy(&raw, &v, sizeof(raw));
+            break;
+    }
+    appendBytes(out, raw, sampleSize(opt.format), opt.bigEndian);
+}
+
+class Generator
+{
+public:
+    explicit Generator(const Options& options) :
+        opt(options), rng(12345), corruptDist(0., 1.)
+    {
+        sampleIndex = 0;
+        corruptedUnits = 0;
+        frameSequence = 0;
+
+        // one period of a sine, channels are harmonics
+        table.resize(4096);
+        for (size_t i = 0; i < table.size(); i++)
+        {
+            table[i] = sin(2 * M_PI * i / table.size());
+        }
+    }
+
+    /// Number of samples (per channel) that are generated in one unit
+    unsigned unitSamples() const
+    {
+        return opt.mode == Mode::framed ? opt.frameSamples : 1;
+    }
+
+    /// Appends a line (ascii), a set of samples (binary) or a frame
+    void appendUnit(std::vector<uint8_t>& out)
+    {
+        size_t start = out.size();
+
+        switch (opt.mode)
+        {
+            case Mode::ascii:
+            {
+                char buf[32];
+                for (unsigned ci = 0; ci < opt.channels; ci++)
+                {
+                    int n = snprintf(buf, sizeof(buf), ci ? ",%.4f" : "%.4f", value(ci));
+                    out.insert(out.end(), buf, buf + n);
+                }
+                out.push_back('\r');
+                out.push_back('\n');
+                sampleIndex++;
+                break;
+            }
+            case Mode::binary:
+                for (unsigned ci = 0; ci < opt.channels; ci++)
+                {
+                    appendSample(out, value(ci), opt);
+                }
+                sampleIndex++;
+                break;
+            case Mode::framed:
+            {
+                unsigned payloadSize = opt.frameSamples * opt.channels * sampleSize(opt.format);
+                out.insert(out.end(), opt.sync.begin(), opt.sync.end());
+                if (opt.sizeField > 0)
+                {
+                    appendBytes(out, payloadSize, opt.sizeField, opt.bigEndian);
+                }
+
+                // sequence number is covered by checksum
+                size_t payloadStart = out.size();
+                if (opt.sequence) out.push_back(frameSequence++);
+
+                for (unsigned i = 0; i < opt.frameSamples; i++)
+                {
+                    for (unsigned ci = 0; ci < opt.channels; ci++)
+                    {
+                        appendSample(out, value(ci), opt);
+                    }
+                    sampleIndex++;
+                }
+
+                appendChecksum(out, payloadStart, opt);
+                break;
+            }
+        }
+
+        // flip a random bit in a random byte of the unit
+        if (opt.corruption > 0 && corruptDist(rng) < opt.corruption)
+        {
+            size_t pos = start + rng() % (out.size() - start);
+            out[pos] ^= 1 << (rng() % 8);
+            corruptedUnits++;
+        }
+    }
+
+    uint64_t corrupted() const {return corruptedUnits;}
+
+private:
+    const Options& opt;
+    std::vector<double> table;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> corruptDist;
+    uint64_t sampleIndex;
+    uint64_t corruptedUnits;
+    uint8_t frameSequence;
+
+    double value(unsigned channel) const
+    {
+        double pos = fmod(sampleIndex * (channel + 1) / opt.period, 1.);
+        return table[size_t(pos * table.size()) % table.size()];
+    }
+};
+
+static double now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Writes all of the buffer. Waits while the terminal buffer is full,
+ * which happens when nobody is reading or reader is slow.
+ *
+ * @return false on error or when stop is requested before completing
+ */
+static bool writeAll(int fd, const std::vector<uint8_t>& data, double deadline)
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        if (stopRequested || (deadline > 0 && now() >= deadline)) return false;
+
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR)
+            {
+                pollfd pfd = {fd, POLLOUT, 0};
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            perror("write");
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+        perror("Creating pseudo terminal failed");
+        return 1;
+    }
+    const char* slaveName = ptsname(master);
+
+    // Keep slave open so that master doesn't get EIO when serialplot
+    // closes the port. Raw mode prevents line ending conversions.
+    int slave = open(slaveName, O_RDWR | O_NOCTTY);
+    if (slave < 0)
+    {
+        perror("Opening slave terminal failed");
+        return 1;
+    }
+    termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    printf("Slave terminal: %s\n", slaveName);
+    if (!opt.link.empty())
+    {
+        unlink(opt.link.c_str());
+        if (symlink(slaveName, opt.link.c_str()) != 0)
+        {
+            perror("Creating link failed");
+        }
+        else
+        {
+            printf("Link: %s\n", opt.link.c_str());
+        }
+    }
+    fflush(stdout);
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    Generator gen(opt);
+    std::vector<uint8_t> buffer;
+    buffer.reserve(1 << 20);
+
+    const double tick = 0.001;  // pacing interval in seconds
+    const unsigned unitSamples = gen.unitSamples();
+    uint64_t samplesSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t lastSamples = 0, lastBytes = 0;
+    const double startTime = now();
+    const double deadline = opt.duration > 0 ? startTime + opt.duration : 0;
+    double lastReport = startTime;
+
+    while (!stopRequested)
+    {
+        double t = now();
+        double elapsed = t - startTime;
+        if (opt.duration > 0 && elapsed >= opt.duration) break;
+
+        // number of units to generate in this round
+        uint64_t units;
+        if (opt.rate > 0)
+        {
+            uint64_t due = elapsed * opt.rate;
+            units = due > samplesSent ? (due - samplesSent) / unitSamples : 0;
+            // don't build a huge backlog if reader is too slow
+            units = std::min<uint64_t>(units, opt.rate * 0.1 / unitSamples + 1);
+        }
+        else
+        {
+            units = 1024 / unitSamples + 1;
+        }
+
+        buffer.clear();
+        for (uint64_t i = 0; i < units; i++) gen.appendUnit(buffer);
+        if (!writeAll(master, buffer, deadline)) break;
+        samplesSent += units * unitSamples;
+        bytesSent += buffer.size();
+
+        if (t - lastReport >= 1.)
+        {
+            double dt = t - lastReport;
+            fprintf(stderr, "%.0f samples/s, %.1f kB/s, %llu corrupted\n",
+                    (samplesSent - lastSamples) / dt,
+                    (bytesSent - lastBytes) / dt / 1000.,
+                    (unsigned long long) gen.corrupted());
+            lastReport = t;
+            lastSamples = samplesSent;
+            lastBytes = bytesSent;
+        }
+
+        if (opt.rate > 0 && units == 0)
+        {
+            timespec ts = {0, long(tick * 1e9)};
+            nanosleep(&ts, nullptr);
+        }
+    }
+
+    fprintf(stderr, "Sent %llu samples, %llu bytes\n",
+            (unsigned long long) samplesSent, (unsigned long long) bytesSent);
+
+    if (!opt.link.empty()) unlink(opt.link.c_str());
+    close(slave);
+    close(master);
+    return 0;
+}
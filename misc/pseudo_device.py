@@ -4,7 +4,9 @@
 # it for testing purposes. Note that pseuodo terminal is a unix thing,
 # this script will not work on Windows.
 #
-# Currently this script only outputs ASCII(comma separated) data.
+# Currently this script only outputs ASCII(comma separated) data. See
+# `pseudo_device.cpp` for a faster simulator that can also output
+# binary and framed data.
 #
 # Copyright © 2023 Hasan Yavuz Özderya
 #
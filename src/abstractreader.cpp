@@ -17,13 +17,40 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <limits>
+
 #include "abstractreader.h"
+#include "rawcapture.h"
+#include "latencytracer.h"
+#include "perfcounters.h"
+
+/// Byte rate estimation is updated at this interval (ms)
+#define RATE_INTERVAL 100
+/// Upper limit of the adaptive batch size
+#define MAX_ADAPTIVE_BATCH (64*1024)
 
 AbstractReader::AbstractReader(QIODevice* device, QObject* parent) :
-    QObject(parent)
+    QObject(parent),
+    batchTimer(this)
 {
     _device = device;
     bytesRead = 0;
+    _enabled = false;
+    rawCapture = nullptr;
+    capturedPending = 0;
+    latencyTracer = nullptr;
+    perfCounters = nullptr;
+    readTime = 0;
+    batchStart = 0;
+    byteRate = 0;
+    rateBytes = 0;
+    statBatches = 0;
+    statBytes = 0;
+    statDelayNs = 0;
+
+    batchTimer.setSingleShot(true);
+    connect(&batchTimer, &QTimer::timeout, this, &AbstractReader::onDataReady);
 }
 
 void AbstractReader::pause(bool enabled)
@@ -33,10 +60,13 @@ void AbstractReader::pause(bool enabled)
 
 void AbstractReader::enable(bool enabled)
 {
+    _enabled = enabled;
+    capturedPending = 0;
+    batchTimer.stop();
+    batchStart = 0;
     if (enabled)
     {
-        QObject::connect(_device, &QIODevice::readyRead,
-                         this, &AbstractReader::onDataReady);
+        connectDevice();
     }
     else
     {
@@ -45,9 +75,207 @@ void AbstractReader::enable(bool enabled)
     }
 }
 
+void AbstractReader::setDevice(QIODevice* device)
+{
+    if (_enabled)
+    {
+        QObject::disconnect(_device, 0, this, 0);
+    }
+    _device = device;
+    capturedPending = 0;
+    batchTimer.stop();
+    batchStart = 0;
+    if (_enabled) connectDevice();
+}
+
+void AbstractReader::connectDevice()
+{
+    QObject::connect(_device, &QIODevice::readyRead,
+                     this, &AbstractReader::onReadyRead);
+}
+
+void AbstractReader::setRawCapture(RawCapture* capture)
+{
+    rawCapture = capture;
+    capturedPending = 0;
+}
+
+void AbstractReader::setLatencyTracer(LatencyTracer* tracer)
+{
+    latencyTracer = tracer;
+}
+
+void AbstractReader::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+}
+
+void AbstractReader::setBatchPolicy(BatchPolicy policy)
+{
+    _batchPolicy = policy;
+    byteRate = 0;
+    rateBytes = 0;
+    rateTimer.invalidate();
+
+    // don't leave already arrived bytes waiting for the old policy
+    flushBatch();
+}
+
+void AbstractReader::flushBatch()
+{
+    if (batchTimer.isActive())
+    {
+        batchTimer.stop();
+        onDataReady();
+    }
+}
+
+AbstractReader::BatchStats AbstractReader::takeBatchStats()
+{
+    BatchStats stats;
+    stats.batches = statBatches;
+    stats.avgBytes = statBatches ? double(statBytes) / statBatches : 0;
+    stats.avgDelay = statBatches ? statDelayNs / 1e6 / statBatches : 0;
+
+    statBatches = 0;
+    statBytes = 0;
+    statDelayNs = 0;
+    return stats;
+}
+
+unsigned AbstractReader::batchThreshold() const
+{
+    if (_batchPolicy.mode == BatchMode::Fixed) return _batchPolicy.minBytes;
+
+    // adaptive: wait for the bytes expected in half of the delay
+    // budget, so that a batch is usually complete before the timeout
+    double expected = byteRate * _batchPolicy.maxDelay / 2;
+    return unsigned(std::max(1., std::min(expected, double(MAX_ADAPTIVE_BATCH))));
+}
+
+void AbstractReader::updateByteRate(unsigned n)
+{
+    if (!rateTimer.isValid())
+    {
+        rateTimer.start();
+        rateBytes = 0;
+        return;
+    }
+
+    rateBytes += n;
+    qint64 elapsed = rateTimer.elapsed();
+    if (elapsed >= RATE_INTERVAL)
+    {
+        double rate = double(rateBytes) / elapsed;
+        byteRate = byteRate ? (byteRate + rate) / 2 : rate;
+        rateBytes = 0;
+        rateTimer.restart();
+    }
+}
+
+void AbstractReader::onReadyRead()
+{
+    if (_batchPolicy.mode == BatchMode::Off)
+    {
+        onDataReady();
+        return;
+    }
+
+    if (!batchStart) batchStart = LatencyTracer::now();
+
+    if (_device->bytesAvailable() >= batchThreshold())
+    {
+        batchTimer.stop();
+        onDataReady();
+    }
+    else if (!batchTimer.isActive())
+    {
+        batchTimer.start(_batchPolicy.maxDelay);
+    }
+}
+
 void AbstractReader::onDataReady()
 {
-    bytesRead += readData();
+    bool tracing = latencyTracer != nullptr && latencyTracer->isEnabled();
+    qint64 startTime = LatencyTracer::now();
+    // bytes waiting for a batch arrived earlier than now
+    qint64 arrival = batchStart ? batchStart : startTime;
+    if (tracing) readTime = arrival;
+
+    bool capturing = rawCapture != nullptr && rawCapture->isCapturing();
+    if (capturing) captureNewBytes();
+
+    unsigned n = readData();
+    bytesRead += n;
+
+    statBatches++;
+    statBytes += n;
+    statDelayNs += startTime - arrival;
+    batchStart = 0;
+    if (_batchPolicy.mode == BatchMode::Adaptive) updateByteRate(n);
+
+    if (perfCounters != nullptr)
+    {
+        PerfCounters::inc(perfCounters->readerNs, LatencyTracer::now() - startTime);
+        PerfCounters::set(perfCounters->deviceQueue, _device->bytesAvailable());
+    }
+
+    capturedPending = capturing ? std::max(qint64(0), capturedPending - n) : 0;
+    readTime = 0;
+}
+
+void AbstractReader::feedOut(SamplePack& data) const
+{
+    if (latencyTracer != nullptr && latencyTracer->isEnabled())
+    {
+        qint64 t = LatencyTracer::now();
+        qint64 arrival = readTime ? readTime : t;
+        if (readTime) latencyTracer->record(LatencyTracer::ReadToDecode, t - readTime);
+
+        // stamping here saves each reader from doing it
+        data.setTimestamp(arrival);
+    }
+
+    Source::feedOut(data);
+}
+
+void AbstractReader::feedGap(unsigned numSamples)
+{
+    if (!numSamples) return;
+
+    unsigned nc = numChannels();
+    SamplePack gap(numSamples, nc);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        std::fill_n(gap.data(ci), numSamples, nan);
+    }
+
+    // not traced, these samples never arrived
+    Source::feedOut(gap);
+}
+
+void AbstractReader::captureNewBytes()
+{
+    // Readers may leave some bytes in the device (ex: an incomplete
+    // line or frame), those are already captured in previous call.
+    qint64 avail = _device->bytesAvailable();
+    if (avail <= capturedPending) return;
+
+    QByteArray data = _device->peek(avail);
+    rawCapture->write(data.constData() + capturedPending,
+                      data.size() - capturedPending);
+    capturedPending = data.size();
+}
+
+void AbstractReader::countDecodeError()
+{
+    if (perfCounters != nullptr) PerfCounters::inc(perfCounters->decodeErrors);
+}
+
+void AbstractReader::countSyncLoss()
+{
+    if (perfCounters != nullptr) PerfCounters::inc(perfCounters->syncLosses);
 }
 
 unsigned AbstractReader::getBytesRead()
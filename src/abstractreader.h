@@ -24,9 +24,14 @@
 #include <QIODevice>
 #include <QWidget>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "source.h"
 
+class RawCapture;
+class LatencyTracer;
+class PerfCounters;
+
 /**
  * All reader classes must inherit this class.
  */
@@ -52,6 +57,65 @@ public:
     /// Read and 'zero' the byte counter
     unsigned getBytesRead();
 
+    /// Changes the device that reader reads from. Reader stays
+    /// enabled if it was enabled.
+    void setDevice(QIODevice* device);
+    QIODevice* device() const {return _device;};
+
+    /**
+     * Sets the raw capture sink. When capture is active, all bytes
+     * received from the device are written to it as they arrive,
+     * before they are decoded. Set to `nullptr` to remove.
+     */
+    void setRawCapture(RawCapture* capture);
+
+    /// Sets the latency tracer, can be `nullptr`
+    void setLatencyTracer(LatencyTracer* tracer);
+
+    /// Sets the performance counters, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
+
+    /// How `readyRead` signals are batched into `readData()` calls
+    enum class BatchMode
+    {
+        Off,                    ///< read on every `readyRead`
+        Fixed,                  ///< wait for `minBytes` or `maxDelay`
+        Adaptive                ///< `minBytes` is estimated from byte rate
+    };
+
+    struct BatchPolicy
+    {
+        BatchMode mode = BatchMode::Off;
+        unsigned minBytes = 0;
+        unsigned maxDelay = 0;  ///< in milliseconds
+    };
+
+    /**
+     * Sets the read batching policy. When batching, reading is
+     * delayed until at least `minBytes` are available, but no longer
+     * than `maxDelay` after the first unread `readyRead`. This trades
+     * a bounded amount of latency for fewer and bigger decode
+     * batches. In adaptive mode `minBytes` is set to the number of
+     * bytes expected to arrive in half of `maxDelay`.
+     */
+    void setBatchPolicy(BatchPolicy policy);
+    BatchPolicy batchPolicy() const {return _batchPolicy;};
+
+    /// True if arrived bytes are waiting for a batch to fill
+    bool batchPending() const {return batchTimer.isActive();};
+    /// Reads pending bytes now instead of waiting for the batch
+    void flushBatch();
+
+    struct BatchStats
+    {
+        unsigned batches;       ///< number of `readData()` calls
+        double avgBytes;        ///< average bytes read per batch
+        double avgDelay;        ///< average wait before reading (ms)
+    };
+
+    /// Returns batch statistics since last call and resets them
+    BatchStats takeBatchStats();
+
 signals:
     // TODO: should we keep this?
     void numOfChannelsChanged(unsigned);
@@ -80,10 +144,67 @@ protected:
      */
     virtual unsigned readData() = 0;
 
+    /**
+     * Stamps the pack with arrival time of the bytes being read and
+     * records read→decode latency. Timer driven readers (no device)
+     * are stamped with the time they feed.
+     *
+     * Takes a non-const pack since it is modified; packs are always
+     * built by the reader itself.
+     */
+    void feedOut(SamplePack& data) const;
+
+    /**
+     * Feeds `numSamples` NaN samples to mark data that is known to be
+     * lost (ex: a gap in frame sequence numbers). Keeps the timeline
+     * intact, plots show a break and recordings an empty line.
+     */
+    void feedGap(unsigned numSamples);
+
+    /// Readers should call this when a frame or line can't be decoded
+    void countDecodeError();
+    /// Readers should call this when synchronization is lost
+    void countSyncLoss();
+
 private:
+    /// Readers must feed through the stamping `feedOut`, base version
+    /// is only used internally
+    using Source::feedOut;
+
     unsigned bytesRead;
+    bool _enabled;
+    RawCapture* rawCapture;
+    /// Number of bytes at the start of device buffer that are already
+    /// captured but not yet consumed by the reader
+    qint64 capturedPending;
+    LatencyTracer* latencyTracer;
+    PerfCounters* perfCounters;
+    /// Arrival time of bytes being read, only valid during `onDataReady`
+    qint64 readTime;
+
+    BatchPolicy _batchPolicy;
+    QTimer batchTimer;
+    /// Time of the first `readyRead` not yet read, 0 if none
+    qint64 batchStart;
+    /// Estimated input rate in bytes per millisecond (adaptive mode)
+    double byteRate;
+    QElapsedTimer rateTimer;
+    quint64 rateBytes;
+    unsigned statBatches;
+    quint64 statBytes;
+    qint64 statDelayNs;
+
+    /// Writes newly arrived bytes to `rawCapture`
+    void captureNewBytes();
+    /// Number of bytes to wait for before reading
+    unsigned batchThreshold() const;
+    /// Updates `byteRate` estimation with `n` bytes read
+    void updateByteRate(unsigned n);
+    /// Connects `readyRead` of current device
+    void connectDevice();
 
 private slots:
+    void onReadyRead();
     void onDataReady();
 };
 
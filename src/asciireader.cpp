@@ -136,7 +136,7 @@ unsigned AsciiReader::readData()
                 break;
         }
 
-        const SamplePack* samples = parseLine(line);
+        SamplePack* samples = parseLine(line);
         if (samples != nullptr) {
             // update number of channels if in auto mode
             if (autoNumOfChannels ) {
@@ -155,6 +155,10 @@ unsigned AsciiReader::readData()
             feedOut(*samples);
             delete samples;
         }
+        else
+        {
+            countDecodeError();
+        }
     }
 
     return numBytesRead;
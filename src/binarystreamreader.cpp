@@ -17,10 +17,10 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <QtEndian>
 #include <QtDebug>
 
 #include "binarystreamreader.h"
+#include "packedformat.h"
 
 BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
     AbstractReader(device, parent)
@@ -30,6 +30,7 @@ BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
     skipSampleRequested = false;
 
     _numChannels = _settingsWidget.numOfChannels();
+    numberFormat = NumberFormat_INVALID;
     connect(&_settingsWidget, &BinaryStreamReaderSettings::numOfChannelsChanged,
                      this, &BinaryStreamReader::onNumOfChannelsChanged);
 
@@ -38,6 +39,10 @@ BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &BinaryStreamReaderSettings::numberFormatChanged,
             this, &BinaryStreamReader::onNumberFormatChanged);
 
+    bigEndian = _settingsWidget.endianness() == BigEndian;
+    connect(&_settingsWidget, &BinaryStreamReaderSettings::endiannessChanged,
+            this, [this](Endianness e){bigEndian = (e == BigEndian);});
+
     // enable skip byte and sample buttons
     connect(&_settingsWidget, &BinaryStreamReaderSettings::skipByteRequested,
             [this]()
@@ -63,57 +68,45 @@ unsigned BinaryStreamReader::numChannels() const
 
 void BinaryStreamReader::onNumberFormatChanged(NumberFormat numberFormat)
 {
-    switch(numberFormat)
+    this->numberFormat = numberFormat;
+    if (isPackedFormat(numberFormat))
+    {
+        sampleSize = packedGroupBytes(numberFormat);
+    }
+    else
     {
-        case NumberFormat_uint8:
-            sampleSize = sizeof(quint8);
-            readSample = &BinaryStreamReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            sampleSize = sizeof(qint8);
-            readSample = &BinaryStreamReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            sampleSize = sizeof(quint16);
-            readSample = &BinaryStreamReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            sampleSize = sizeof(qint16);
-            readSample = &BinaryStreamReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            sampleSize = sizeof(quint32);
-            readSample = &BinaryStreamReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            sampleSize = sizeof(qint32);
-            readSample = &BinaryStreamReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            sampleSize = sizeof(float);
-            readSample = &BinaryStreamReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            sampleSize = sizeof(double);
-            readSample = &BinaryStreamReader::readSampleAs<double>;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
+        sampleSize = numberFormatSize(numberFormat);
     }
+    compileDecodePlan();
 }
 
 void BinaryStreamReader::onNumOfChannelsChanged(unsigned value)
 {
     _numChannels = value;
+    compileDecodePlan();
     updateNumChannels();
     emit numOfChannelsChanged(value);
 }
 
+void BinaryStreamReader::compileDecodePlan()
+{
+    decodePlan.clear();
+    if (isPackedFormat(numberFormat)) return;
+
+    for (unsigned ci = 0; ci < _numChannels; ci++)
+    {
+        decodePlan.addField(numberFormat, ci * sampleSize, ci);
+    }
+    decodePlan.setSampleSetSize(_numChannels * sampleSize);
+}
+
 unsigned BinaryStreamReader::readData()
 {
-    // a package is a set of channel data like {CHAN0_SAMPLE, CHAN1_SAMPLE...}
-    unsigned packageSize = sampleSize * _numChannels;
+    // a package is a set of channel data like {CHAN0_SAMPLE,
+    // CHAN1_SAMPLE...}, for packed formats enough sets to fill whole
+    // groups
+    unsigned setsPerPackage = packedSetsPerPackage(numberFormat, _numChannels);
+    unsigned packageSize = setsPerPackage * _numChannels * numberFormatBits(numberFormat) / 8;
     unsigned bytesAvailable = _device->bytesAvailable();
     unsigned totalRead = 0;
 
@@ -126,7 +119,7 @@ unsigned BinaryStreamReader::readData()
         bytesAvailable--;
     }
 
-    // skip 1 sample (channel) if requested
+    // skip 1 sample (channel) if requested, 1 group for packed formats
     if (skipSampleRequested && bytesAvailable >= sampleSize)
     {
         _device->read(sampleSize);
@@ -135,7 +128,7 @@ unsigned BinaryStreamReader::readData()
         bytesAvailable -= sampleSize;
     }
 
-    if (bytesAvailable < packageSize) return totalRead;
+    if (packageSize == 0 || bytesAvailable < packageSize) return totalRead;
 
     unsigned numOfPackagesToRead =
         (bytesAvailable - (bytesAvailable % packageSize)) / packageSize;
@@ -150,36 +143,23 @@ unsigned BinaryStreamReader::readData()
         return totalRead;
     }
 
-    // actual reading
-    SamplePack samples(numOfPackagesToRead, _numChannels);
-    for (unsigned i = 0; i < numOfPackagesToRead; i++)
-    {
-        for (unsigned ci = 0; ci < _numChannels; ci++)
-        {
-            samples.data(ci)[i] = (this->*readSample)();
-        }
-    }
-    feedOut(samples);
-
-    return totalRead;
-}
+    // actual reading, whole chunk at once
+    readBuffer.resize(numBytesToRead);
+    _device->read(readBuffer.data(), numBytesToRead);
+    const uchar* data = (const uchar*) readBuffer.constData();
 
-template<typename T> double BinaryStreamReader::readSampleAs()
-{
-    T data;
-
-    _device->read((char*) &data, sizeof(data));
-
-    if (_settingsWidget.endianness() == LittleEndian)
+    SamplePack samples(numOfPackagesToRead * setsPerPackage, _numChannels);
+    if (isPackedFormat(numberFormat))
     {
-        data = qFromLittleEndian(data);
+        unpackToChannels(numberFormat, data, numBytesToRead / sampleSize, bigEndian, samples);
     }
     else
     {
-        data = qFromBigEndian(data);
+        decodePlan.decode(data, samples.numSamples(), bigEndian, samples);
     }
+    feedOut(samples);
 
-    return double(data);
+    return totalRead;
 }
 
 void BinaryStreamReader::saveSettings(QSettings* settings)
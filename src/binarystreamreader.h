@@ -24,6 +24,7 @@
 
 #include "abstractreader.h"
 #include "binarystreamreadersettings.h"
+#include "decodeplan.h"
 
 /**
  * Reads a simple stream of samples in binary form from the
@@ -45,20 +46,18 @@ public:
 private:
     BinaryStreamReaderSettings _settingsWidget;
     unsigned _numChannels;
-    unsigned sampleSize;
+    NumberFormat numberFormat;
+    bool bigEndian;
+    unsigned sampleSize;        /// size of a packed group for packed formats
     bool skipByteRequested;
     bool skipSampleRequested;
 
-    /// points to the readSampleAs function for currently selected number format
-    double (BinaryStreamReader::*readSample)();
+    /// not used for packed formats
+    DecodePlan decodePlan;
+    QByteArray readBuffer;
 
-    /**
-     * Reads 1 sample from the device in given format.
-     *
-     * @note Device should already have enough bytes present before
-     * calling this function.
-     */
-    template<typename T> double readSampleAs();
+    /// Rebuilds `decodePlan` after a change in number format or channels
+    void compileDecodePlan();
 
     unsigned readData() override;
 
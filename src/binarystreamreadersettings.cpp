@@ -41,6 +41,9 @@ BinaryStreamReaderSettings::BinaryStreamReaderSettings(QWidget *parent) :
     connect(ui->nfBox, SIGNAL(selectionChanged(NumberFormat)),
             this, SIGNAL(numberFormatChanged(NumberFormat)));
 
+    connect(ui->endiBox, &EndiannessBox::selectionChanged,
+            this, &BinaryStreamReaderSettings::endiannessChanged);
+
     connect(ui->pbSkipByte, SIGNAL(clicked()), this, SIGNAL(skipByteRequested()));
     connect(ui->pbSkipSample, SIGNAL(clicked()), this, SIGNAL(skipSampleRequested()));
 }
@@ -0,0 +1,193 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <QtEndian>
+#include <QtDebug>
+
+#include "capturereplaydevice.h"
+#include "rawcapture.h"
+
+/// When replaying at maximum speed, control is returned to the event
+/// loop after this many milliseconds so that the UI stays responsive.
+#define MAX_SPEED_TIME_SLICE 20
+
+CaptureReplayDevice::CaptureReplayDevice(QObject* parent) :
+    QIODevice(parent)
+{
+    map = nullptr;
+    mapSize = 0;
+    chunkPos = 0;
+    pendingPos = 0;
+    _speed = 1.;
+    _bytesReplayed = 0;
+
+    releaseTimer.setSingleShot(true);
+    releaseTimer.setTimerType(Qt::PreciseTimer);
+    connect(&releaseTimer, &QTimer::timeout,
+            this, &CaptureReplayDevice::releaseChunks);
+}
+
+CaptureReplayDevice::~CaptureReplayDevice()
+{
+    close();
+}
+
+bool CaptureReplayDevice::openCapture(QString fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Opening capture file" << fileName
+                    << "failed:" << file.errorString();
+        return false;
+    }
+
+    mapSize = file.size();
+    if (mapSize < RawCapture::HeaderSize ||
+        (map = file.map(0, mapSize)) == nullptr)
+    {
+        qCritical() << "Can't read capture file" << fileName;
+        file.close();
+        return false;
+    }
+
+    if (memcmp(map, RawCapture::Magic, sizeof(RawCapture::Magic)) != 0 ||
+        qFromLittleEndian<quint32>(map + 8) != RawCapture::Version)
+    {
+        qCritical() << fileName << "is not a raw capture file";
+        close();
+        return false;
+    }
+
+    chunkPos = RawCapture::HeaderSize;
+    return QIODevice::open(QIODevice::ReadOnly);
+}
+
+void CaptureReplayDevice::close()
+{
+    releaseTimer.stop();
+    if (isOpen()) QIODevice::close();
+    if (map != nullptr)
+    {
+        file.unmap(const_cast<uchar*>(map));
+        map = nullptr;
+    }
+    file.close();
+    mapSize = 0;
+    pending.clear();
+    pendingPos = 0;
+}
+
+void CaptureReplayDevice::setSpeed(double speed)
+{
+    _speed = speed < 0 ? 0 : speed;
+}
+
+void CaptureReplayDevice::start()
+{
+    Q_ASSERT(map != nullptr);
+
+    chunkPos = RawCapture::HeaderSize;
+    pending.clear();
+    pendingPos = 0;
+    _bytesReplayed = 0;
+    playTimer.start();
+    releaseTimer.start(0);
+}
+
+void CaptureReplayDevice::releaseChunks()
+{
+    const qint64 now = playTimer.nsecsElapsed();
+    QElapsedTimer slice;
+    slice.start();
+
+    while (chunkPos + RawCapture::ChunkHeaderSize <= mapSize)
+    {
+        const uchar* chunk = map + chunkPos;
+        quint64 timestamp = qFromLittleEndian<quint64>(chunk);
+        quint32 length = qFromLittleEndian<quint32>(chunk + 8);
+
+        if (chunkPos + RawCapture::ChunkHeaderSize + length > mapSize)
+        {
+            qWarning() << "Capture file is truncated, last chunk is dropped.";
+            break;
+        }
+
+        if (_speed > 0)
+        {
+            qint64 due = timestamp / _speed;
+            if (due > now)
+            {
+                // rounded up, a 0 ms timer would spin until due
+                releaseTimer.start((due - now + 999999) / 1000000);
+                return;
+            }
+        }
+
+        // drop already read bytes before appending
+        if (pendingPos > 0)
+        {
+            pending.remove(0, pendingPos);
+            pendingPos = 0;
+        }
+        pending.append((const char*) chunk + RawCapture::ChunkHeaderSize, length);
+        chunkPos += RawCapture::ChunkHeaderSize + length;
+        _bytesReplayed += length;
+
+        emit readyRead();
+
+        if (_speed == 0 && slice.hasExpired(MAX_SPEED_TIME_SLICE))
+        {
+            releaseTimer.start(0);
+            return;
+        }
+    }
+
+    chunkPos = mapSize;
+    emit finished();
+}
+
+qint64 CaptureReplayDevice::bytesAvailable() const
+{
+    return (pending.size() - pendingPos) + QIODevice::bytesAvailable();
+}
+
+bool CaptureReplayDevice::canReadLine() const
+{
+    return pending.indexOf('\n', pendingPos) >= 0 || QIODevice::canReadLine();
+}
+
+qint64 CaptureReplayDevice::readData(char* data, qint64 maxSize)
+{
+    qint64 n = std::min(maxSize, qint64(pending.size() - pendingPos));
+    memcpy(data, pending.constData() + pendingPos, n);
+    pendingPos += n;
+    return n;
+}
+
+qint64 CaptureReplayDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTUREREPLAYDEVICE_H
+#define CAPTUREREPLAYDEVICE_H
+
+#include <QIODevice>
+#include <QFile>
+#include <QByteArray>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * A sequential device that plays back a file created by `RawCapture`.
+ *
+ * Readers can be connected to this device in place of the serial
+ * port. Each captured chunk is made available with a separate
+ * `readyRead` signal so that readers see the same read boundaries as
+ * they did during capture.
+ */
+class CaptureReplayDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureReplayDevice(QObject* parent = nullptr);
+    ~CaptureReplayDevice();
+
+    /**
+     * Opens the capture file for playback. Playback doesn't start
+     * until `start()` is called.
+     *
+     * @return false if file can't be opened or isn't a valid capture
+     */
+    bool openCapture(QString fileName);
+
+    /**
+     * Sets the playback speed. 1 is the original timing, 2 is twice
+     * as fast etc. 0 means as fast as possible.
+     */
+    void setSpeed(double speed);
+
+    /// Starts (or restarts) the playback from the beginning
+    void start();
+
+    /// Number of payload bytes released so far
+    quint64 bytesReplayed() const {return _bytesReplayed;};
+
+    bool isSequential() const override {return true;};
+    qint64 bytesAvailable() const override;
+    bool canReadLine() const override;
+    void close() override;
+
+signals:
+    /// Emitted when all chunks are released
+    void finished();
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QFile file;
+    const uchar* map;           ///< memory mapped capture file
+    qint64 mapSize;
+    qint64 chunkPos;            ///< position of next chunk in map
+    QByteArray pending;         ///< released but not read bytes
+    qint64 pendingPos;          ///< read position in `pending`
+    double _speed;
+    QTimer releaseTimer;
+    QElapsedTimer playTimer;
+    quint64 _bytesReplayed;
+
+    /// Releases chunks that are due
+    void releaseChunks();
+};
+
+#endif // CAPTUREREPLAYDEVICE_H
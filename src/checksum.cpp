@@ -0,0 +1,220 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QMap>
+#include <QtEndian>
+
+#include "checksum.h"
+
+#define CRC16_POLY 0x1021      // MSB first
+#define CRC32_POLY 0xEDB88320  // reflected
+
+/*
+ * CRC calculations use slice-by-8 tables. `table[k][x]` is the CRC
+ * of byte `x` followed by `k` zero bytes, that way 8 bytes are
+ * processed with 8 independent lookups instead of 8 dependent ones.
+ */
+struct Crc16Tables
+{
+    quint16 table[8][256];
+
+    Crc16Tables()
+    {
+        for (unsigned x = 0; x < 256; x++)
+        {
+            quint16 c = x << 8;
+            for (int b = 0; b < 8; b++)
+            {
+                c = (c & 0x8000) ? (c << 1) ^ CRC16_POLY : (c << 1);
+            }
+            table[0][x] = c;
+        }
+        for (unsigned x = 0; x < 256; x++)
+        {
+            for (int k = 1; k < 8; k++)
+            {
+                quint16 prev = table[k-1][x];
+                table[k][x] = (prev << 8) ^ table[0][prev >> 8];
+            }
+        }
+    }
+};
+
+struct Crc32Tables
+{
+    quint32 table[8][256];
+
+    Crc32Tables()
+    {
+        for (unsigned x = 0; x < 256; x++)
+        {
+            quint32 c = x;
+            for (int b = 0; b < 8; b++)
+            {
+                c = (c & 1) ? (c >> 1) ^ CRC32_POLY : (c >> 1);
+            }
+            table[0][x] = c;
+        }
+        for (unsigned x = 0; x < 256; x++)
+        {
+            for (int k = 1; k < 8; k++)
+            {
+                quint32 prev = table[k-1][x];
+                table[k][x] = (prev >> 8) ^ table[0][prev & 0xFF];
+            }
+        }
+    }
+};
+
+static const Crc16Tables& crc16Tables()
+{
+    static const Crc16Tables tables;
+    return tables;
+}
+
+static const Crc32Tables& crc32Tables()
+{
+    static const Crc32Tables tables;
+    return tables;
+}
+
+static const QMap<ChecksumType, QString> typeNames({
+        {Checksum_none, "none"},
+        {Checksum_sum8, "sum8"},
+        {Checksum_crc16, "crc16"},
+        {Checksum_crc32, "crc32"}
+    });
+
+unsigned checksumSize(ChecksumType type)
+{
+    switch (type)
+    {
+        case Checksum_sum8:
+            return 1;
+        case Checksum_crc16:
+            return 2;
+        case Checksum_crc32:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+QString checksumTypeToStr(ChecksumType type)
+{
+    return typeNames.value(type);
+}
+
+ChecksumType strToChecksumType(QString str)
+{
+    // older versions stored a boolean
+    if (str == "true") return Checksum_sum8;
+    if (str == "false") return Checksum_none;
+
+    return typeNames.key(str, Checksum_INVALID);
+}
+
+quint8 checksumSum8(const uchar* data, size_t len, quint8 sum)
+{
+    // wider accumulator lets compiler vectorize the loop
+    unsigned s = sum;
+    for (size_t i = 0; i < len; i++)
+    {
+        s += data[i];
+    }
+    return s & 0xFF;
+}
+
+quint16 checksumCrc16(const uchar* data, size_t len, quint16 crc)
+{
+    const auto& t = crc16Tables().table;
+
+    while (len >= 8)
+    {
+        crc = t[7][data[0] ^ (crc >> 8)] ^
+              t[6][data[1] ^ (crc & 0xFF)] ^
+              t[5][data[2]] ^ t[4][data[3]] ^
+              t[3][data[4]] ^ t[2][data[5]] ^
+              t[1][data[6]] ^ t[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+
+    while (len--)
+    {
+        crc = (crc << 8) ^ t[0][(crc >> 8) ^ *data++];
+    }
+
+    return crc;
+}
+
+quint32 checksumCrc32(const uchar* data, size_t len, quint32 crc)
+{
+    const auto& t = crc32Tables().table;
+    crc = ~crc;
+
+    while (len >= 8)
+    {
+        quint32 one = qFromLittleEndian<quint32>(data) ^ crc;
+        quint32 two = qFromLittleEndian<quint32>(data + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        data += 8;
+        len -= 8;
+    }
+
+    while (len--)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return ~crc;
+}
+
+quint32 checksum(ChecksumType type, const uchar* data, size_t len)
+{
+    switch (type)
+    {
+        case Checksum_sum8:
+            return checksumSum8(data, len);
+        case Checksum_crc16:
+            return checksumCrc16(data, len);
+        case Checksum_crc32:
+            return checksumCrc32(data, len);
+        default:
+            return 0;
+    }
+}
+
+quint32 readChecksum(ChecksumType type, const uchar* data, bool bigEndian)
+{
+    switch (type)
+    {
+        case Checksum_sum8:
+            return data[0];
+        case Checksum_crc16:
+            return bigEndian ? qFromBigEndian<quint16>(data) : qFromLittleEndian<quint16>(data);
+        case Checksum_crc32:
+            return bigEndian ? qFromBigEndian<quint32>(data) : qFromLittleEndian<quint32>(data);
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <QString>
+#include <QtGlobal>
+
+/// Frame checksum algorithms
+enum ChecksumType
+{
+    Checksum_none,
+    Checksum_sum8,     ///< 8 bit sum of bytes
+    Checksum_crc16,    ///< CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+    Checksum_crc32,    ///< CRC-32 (IEEE 802.3, as in zlib)
+    Checksum_INVALID   ///< used for error cases
+};
+
+/// Size of the checksum field in bytes
+unsigned checksumSize(ChecksumType type);
+
+/// Convert `ChecksumType` to string for representation
+QString checksumTypeToStr(ChecksumType type);
+
+/**
+ * Convert string to `ChecksumType`. For backward compatibility
+ * boolean strings are accepted as well ("true" means 8 bit sum).
+ */
+ChecksumType strToChecksumType(QString str);
+
+/// 8 bit sum of bytes
+quint8 checksumSum8(const uchar* data, size_t len, quint8 sum = 0);
+
+/**
+ * CRC-16/CCITT-FALSE of data. Pass the result of the previous call
+ * as `crc` to continue calculation over multiple spans.
+ */
+quint16 checksumCrc16(const uchar* data, size_t len, quint16 crc = 0xFFFF);
+
+/**
+ * CRC-32 of data. Pass the result of the previous call as `crc` to
+ * continue calculation over multiple spans.
+ */
+quint32 checksumCrc32(const uchar* data, size_t len, quint32 crc = 0);
+
+/// Calculates checksum of given type over data, result is zero extended
+quint32 checksum(ChecksumType type, const uchar* data, size_t len);
+
+/// Reads a received checksum field of given type, result is zero extended
+quint32 readChecksum(ChecksumType type, const uchar* data, bool bigEndian);
+
+#endif // CHECKSUM_H
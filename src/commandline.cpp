@@ -0,0 +1,102 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <QFileInfo>
+#include <QtDebug>
+
+#include "commandline.h"
+#include "portcontrol.h"
+
+CommandLine::CommandLine() :
+    configOpt({"c", "config"}, "Load configuration from file.", "filename"),
+    portOpt({"p", "port"}, "Set port name.", "port name"),
+    baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate"),
+    openPortOpt({"o", "open"}, "Open serial port."),
+    headlessOpt("headless", "Run without GUI and record to the file given with --record. "
+                "Port is opened at start."),
+    recordOpt({"r", "record"}, "Recording file for headless mode.", "filename"),
+    statsOpt("stats", "Interval of throughput logs in headless mode, 0 disables.",
+             "seconds", "10")
+{
+    parser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsCompactedShortOptions);
+    parser.setApplicationDescription("Small and simple software for plotting data from serial port in realtime.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    parser.addOption(configOpt);
+    parser.addOption(portOpt);
+    parser.addOption(baudrateOpt);
+    parser.addOption(openPortOpt);
+    parser.addOption(headlessOpt);
+    parser.addOption(recordOpt);
+    parser.addOption(statsOpt);
+}
+
+bool CommandLine::isHeadless(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0) return true;
+    }
+    return false;
+}
+
+void CommandLine::process(const QCoreApplication& app)
+{
+    parser.process(app);
+}
+
+void CommandLine::loadConfig(std::function<void(QSettings*)> load) const
+{
+    if (!parser.isSet(configOpt)) return;
+
+    QString fileName = parser.value(configOpt);
+    QFileInfo fileInfo(fileName);
+
+    if (fileInfo.exists() && fileInfo.isFile())
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        load(&settings);
+    }
+    else
+    {
+        qCritical() << "Configuration file not exist. Closing application.";
+        std::exit(1);
+    }
+}
+
+void CommandLine::applyPortOptions(PortControl* portControl) const
+{
+    if (parser.isSet(portOpt))
+    {
+        portControl->selectPort(parser.value(portOpt));
+    }
+
+    if (parser.isSet(baudrateOpt))
+    {
+        portControl->selectBaudrate(parser.value(baudrateOpt));
+    }
+
+    if (parser.isSet(openPortOpt))
+    {
+        portControl->openPort();
+    }
+}
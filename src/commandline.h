@@ -0,0 +1,64 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <functional>
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QSettings>
+
+class PortControl;
+
+/// Command line options shared by GUI and headless modes
+class CommandLine
+{
+public:
+    CommandLine();
+
+    /// Returns true if `--headless` is given, can be called before
+    /// the application object is created.
+    static bool isHeadless(int argc, char* argv[]);
+
+    /// Parses arguments, exits on `--help`, `--version` and errors
+    void process(const QCoreApplication& app);
+
+    /// Calls `load` with the file given with `-c`, exits if the file doesn't exist
+    void loadConfig(std::function<void(QSettings*)> load) const;
+    /// Applies `-p`, `-b` and `-o` options
+    void applyPortOptions(PortControl* portControl) const;
+
+    bool isSet(const QCommandLineOption& option) const {return parser.isSet(option);};
+    QString value(const QCommandLineOption& option) const {return parser.value(option);};
+
+    const QCommandLineOption configOpt;
+    const QCommandLineOption portOpt;
+    const QCommandLineOption baudrateOpt;
+    const QCommandLineOption openPortOpt;
+    const QCommandLineOption headlessOpt;
+    const QCommandLineOption recordOpt;
+    const QCommandLineOption statsOpt;
+
+private:
+    QCommandLineParser parser;
+};
+
+#endif // COMMANDLINE_H
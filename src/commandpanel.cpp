@@ -84,6 +84,11 @@ void CommandPanel::reAssignShortcuts()
     }
 }
 
+void CommandPanel::setPort(QIODevice* port)
+{
+    serialPort = port;
+}
+
 void CommandPanel::sendCommand(QByteArray command)
 {
     if (!serialPort->isOpen())
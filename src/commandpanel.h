@@ -51,6 +51,8 @@ public:
     void loadSettings(QSettings* settings);
     /// Number of commands
     unsigned numOfCommands();
+    /// Changes the port that commands are sent to
+    void setPort(QIODevice* port);
 
 signals:
     // emitted when user tries to send an empty command
@@ -58,7 +60,7 @@ signals:
 
 private:
     Ui::CommandPanel *ui;
-    QSerialPort* serialPort;
+    QIODevice* serialPort;
     QMenu _menu;
     QAction _newCommandAction;
     QList<CommandWidget*> commands;
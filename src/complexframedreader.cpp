@@ -20,13 +20,18 @@
 // Uncomment to allow checksum to pass if it's 0xAA (for debugging/testing)
 #define CSUM_USE_FIXED_AA
 
+#include <algorithm>
 #include <QtDebug>
 #include <QtEndian>
 
 #include "complexframedreader.h"
+#include "packedformat.h"
+
+#define STATS_UPDATE_INTERVAL 500 // ms
 
 ComplexFramedReader::ComplexFramedReader(QIODevice* device, QObject* parent) :
-    AbstractReader(device, parent)
+    AbstractReader(device, parent),
+    statsTimer(this)
 {
     paused = false;
 
@@ -37,12 +42,13 @@ ComplexFramedReader::ComplexFramedReader(QIODevice* device, QObject* parent) :
     isSizeField2B = (_settingsWidget.sizeFieldType() == ComplexFramedReaderSettings::SizeFieldType::Field2Byte);
     frameSize = _settingsWidget.fixedFrameSize();
     syncWord = _settingsWidget.syncWord();
-    checksumEnabled = _settingsWidget.isChecksumEnabled();
+    checksumType = _settingsWidget.checksumType();
+    sequenceEnabled = _settingsWidget.isSequenceEnabled();
+    skippingBytes = false;
     
     // Initialize per-channel formats
     channelFormats.resize(_numChannels);
     channelSampleSizes.resize(_numChannels);
-    channelReadFunctions.resize(_numChannels);
     for (unsigned i = 0; i < _numChannels; ++i)
     {
         channelFormats[i] = _settingsWidget.channelFormat(i);
@@ -51,6 +57,7 @@ ComplexFramedReader::ComplexFramedReader(QIODevice* device, QObject* parent) :
     
     onNumberFormatChanged(_settingsWidget.numberFormat());  // Legacy compatibility
     debugModeEnabled = _settingsWidget.isDebugModeEnabled();
+    bigEndian = _settingsWidget.endianness() == BigEndian;
     checkSettings();
 
     // init setting connections
@@ -85,8 +92,27 @@ ComplexFramedReader::ComplexFramedReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &ComplexFramedReaderSettings::sizeFieldChanged,
             this, &ComplexFramedReader::onSizeFieldChanged);
 
+    connect(&_settingsWidget, &ComplexFramedReaderSettings::endiannessChanged,
+            this, [this](Endianness e){bigEndian = (e == BigEndian);});
+
     connect(&_settingsWidget, &ComplexFramedReaderSettings::checksumChanged,
-            [this](bool enabled){checksumEnabled = enabled; checkSettings(); reset();});
+            [this](ChecksumType type){checksumType = type; checkSettings(); reset();});
+
+    connect(&_settingsWidget, &ComplexFramedReaderSettings::sequenceChanged,
+            [this](bool enabled)
+            {
+                sequenceEnabled = enabled;
+                stats.nextSequence = -1;
+                checkSettings();
+                reset();
+            });
+
+    connect(&_settingsWidget, &ComplexFramedReaderSettings::resetStatsRequested,
+            [this]()
+            {
+                stats.clear();
+                updateStats();
+            });
 
     connect(&_settingsWidget, &ComplexFramedReaderSettings::debugModeChanged,
             [this](bool enabled){debugModeEnabled = enabled;});
@@ -102,6 +128,9 @@ ComplexFramedReader::ComplexFramedReader(QIODevice* device, QObject* parent) :
                 }
             });
 
+    statsTimer.setInterval(STATS_UPDATE_INTERVAL);
+    connect(&statsTimer, &QTimer::timeout, this, &ComplexFramedReader::updateStats);
+
     // init reader state
     reset();
 }
@@ -116,107 +145,133 @@ unsigned ComplexFramedReader::numChannels() const
     return _numChannels;
 }
 
+void ComplexFramedReader::enable(bool enabled)
+{
+    if (enabled)
+    {
+        stats.clear();
+        skippingBytes = false;
+        statsTimer.start();
+    }
+    else
+    {
+        statsTimer.stop();
+    }
+    updateStats();
+    AbstractReader::enable(enabled);
+}
+
+void ComplexFramedReader::updateStats()
+{
+    // readers of a merged source run on a worker thread, widget is
+    // only touched from the GUI thread
+    if (thread() != _settingsWidget.thread())
+    {
+        QString summary = stats.summary(sequenceEnabled);
+        QMetaObject::invokeMethod(&_settingsWidget, [this, summary]()
+            {
+                if (_settingsWidget.isVisible()) _settingsWidget.showStats(summary);
+            }, Qt::QueuedConnection);
+        return;
+    }
+
+    // no need to update if nobody is looking
+    if (!_settingsWidget.isVisible()) return;
+
+    _settingsWidget.showStats(stats.summary(sequenceEnabled));
+}
+
+void ComplexFramedReader::skipBytes(unsigned n)
+{
+    if (!n) return;
+
+    stats.bytesSkipped += n;
+    if (!skippingBytes)
+    {
+        skippingBytes = true;
+        stats.syncMisses++;
+        countSyncLoss();
+    }
+}
+
+void ComplexFramedReader::sizeError(QString message, bool log)
+{
+    stats.sizeErrors++;
+    countDecodeError();
+    if (log && errorLog.allow()) qCritical() << message;
+}
+
 void ComplexFramedReader::initializeChannelFormat(unsigned channel, NumberFormat numberFormat)
 {
     if (channel >= channelFormats.size()) return;
     
     channelFormats[channel] = numberFormat;
     
-    switch(numberFormat)
-    {
-        case NumberFormat_uint8:
-            channelSampleSizes[channel] = sizeof(quint8);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            channelSampleSizes[channel] = sizeof(qint8);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            channelSampleSizes[channel] = sizeof(quint16);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            channelSampleSizes[channel] = sizeof(qint16);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            channelSampleSizes[channel] = sizeof(quint32);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            channelSampleSizes[channel] = sizeof(qint32);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            channelSampleSizes[channel] = sizeof(float);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            channelSampleSizes[channel] = sizeof(double);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAs<double>;
-            break;
-        case NumberFormat_pad:
-            channelSampleSizes[channel] = _settingsWidget.channelPadSize(channel);
-            channelReadFunctions[channel] = &ComplexFramedReader::readSampleAsPad;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
+    if (numberFormat == NumberFormat_pad)
+    {
+        channelSampleSizes[channel] = _settingsWidget.channelPadSize(channel);
+    }
+    else
+    {
+        channelSampleSizes[channel] = numberFormatSize(numberFormat);
     }
 }
 
 void ComplexFramedReader::onNumberFormatChanged(NumberFormat numberFormat)
 {
-    switch(numberFormat)
-    {
-        case NumberFormat_uint8:
-            sampleSize = sizeof(quint8);
-            readSample = &ComplexFramedReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            sampleSize = sizeof(qint8);
-            readSample = &ComplexFramedReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            sampleSize = sizeof(quint16);
-            readSample = &ComplexFramedReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            sampleSize = sizeof(qint16);
-            readSample = &ComplexFramedReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            sampleSize = sizeof(quint32);
-            readSample = &ComplexFramedReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            sampleSize = sizeof(qint32);
-            readSample = &ComplexFramedReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            sampleSize = sizeof(float);
-            readSample = &ComplexFramedReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            sampleSize = sizeof(double);
-            readSample = &ComplexFramedReader::readSampleAs<double>;
-            break;
-        case NumberFormat_pad:
-            sampleSize = _settingsWidget.padSize();
-            readSample = &ComplexFramedReader::readSampleAsPad;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
+    if (numberFormat == NumberFormat_pad)
+    {
+        sampleSize = _settingsWidget.padSize();
+    }
+    else
+    {
+        sampleSize = numberFormatSize(numberFormat);
     }
 
     checkSettings();
     reset();
 }
 
+void ComplexFramedReader::compileDecodePlan()
+{
+    decodePlan.clear();
+
+    // packed values aren't aligned to channels, only allowed when all
+    // channels have the same packed format
+    packedFormat = NumberFormat_INVALID;
+    if (_numChannels && isPackedFormat(channelFormats[0]) &&
+        std::all_of(channelFormats.cbegin(), channelFormats.cbegin() + _numChannels,
+                    [this](NumberFormat nf){return nf == channelFormats[0];}))
+    {
+        packedFormat = channelFormats[0];
+        return;
+    }
+
+    unsigned offset = 0;
+    for (unsigned ci = 0; ci < _numChannels; ci++)
+    {
+        decodePlan.addField(channelFormats[ci], offset, ci);
+        offset += channelSampleSizes[ci];
+    }
+    decodePlan.setSampleSetSize(offset);
+}
+
+unsigned ComplexFramedReader::sampleSetSize() const
+{
+    if (packedFormat != NumberFormat_INVALID)
+    {
+        // smallest number of sample sets that fill whole groups
+        return packedSetsPerPackage(packedFormat, _numChannels) *
+            _numChannels * numberFormatBits(packedFormat) / 8;
+    }
+    return decodePlan.sampleSetSize();
+}
+
 void ComplexFramedReader::checkSettings()
 {
+    // all layout changes end up here
+    compileDecodePlan();
+
     // sync word is invalid (empty or missing a nibble at the end)
     if (!syncWord.size())
     {
@@ -227,15 +282,20 @@ void ComplexFramedReader::checkSettings()
         settingsInvalid &= ~SYNCWORD_INVALID;
     }
 
-    // Calculate total sample set size from all channels
-    unsigned sampleSetSize = 0;
-    for (unsigned i = 0; i < _numChannels; ++i)
+    // packed formats can't be mixed with others, see `compileDecodePlan`
+    settingsInvalid &= ~FORMAT_INVALID;
+    for (unsigned ci = 0; ci < _numChannels; ci++)
     {
-        sampleSetSize += channelSampleSizes[i];
+        if (isPackedFormat(channelFormats[ci]) && packedFormat == NumberFormat_INVALID)
+        {
+            settingsInvalid |= FORMAT_INVALID;
+        }
     }
 
+    unsigned sampleSetSize = this->sampleSetSize();
+
     // check if fixed frame size is multiple of a sample set size
-    if (!hasSizeByte && (frameSize % sampleSetSize != 0))
+    if (!hasSizeByte && (sampleSetSize == 0 || frameSize % sampleSetSize != 0))
     {
         settingsInvalid |= FRAMESIZE_INVALID;
     }
@@ -249,11 +309,15 @@ void ComplexFramedReader::checkSettings()
     {
         _settingsWidget.showMessage("Frame Start is invalid!", true);
     }
+    else if (settingsInvalid & FORMAT_INVALID)
+    {
+        _settingsWidget.showMessage("Packed formats must be used for all channels!", true);
+    }
     else if (settingsInvalid & FRAMESIZE_INVALID)
     {
         QString errorMessage =
-            QString("Payload size must be multiple of %1 (#channels * sample size)!")\
-            .arg(_numChannels * sampleSize);
+            QString("Payload size must be multiple of %1 (sample set size)!")\
+            .arg(sampleSetSize);
 
         _settingsWidget.showMessage(errorMessage, true);
     }
@@ -262,7 +326,8 @@ void ComplexFramedReader::checkSettings()
         // Calculate frame overhead
         QString message;
 		unsigned overhead = syncWord.size();
-        if (checksumEnabled)
+        overhead += checksumSize(checksumType);
+        if (sequenceEnabled)
         {
             overhead += 1;
         }
@@ -297,7 +362,6 @@ void ComplexFramedReader::onNumOfChannelsChanged(unsigned value)
     unsigned oldSize = channelFormats.size();
     channelFormats.resize(_numChannels);
     channelSampleSizes.resize(_numChannels);
-    channelReadFunctions.resize(_numChannels);
     
     // Initialize any new channels that were added
     for (unsigned i = oldSize; i < _numChannels; ++i)
@@ -357,6 +421,7 @@ unsigned ComplexFramedReader::readData()
                 if (sync_i == (unsigned) syncWord.length())
                 {
                     gotSync = true;
+                    skippingBytes = false;
                 }
             }
             else
@@ -368,7 +433,17 @@ unsigned ComplexFramedReader::readData()
                                 << "Got:" << QString("0x%1").arg((unsigned char)c, 2, 16, QChar('0'))
                                 << "(" << (isprint(c) ? QString(c) : "") << ")";
                 }
-                sync_i = 0; // Reset sync on mismatch
+
+                // discard partially matched sync bytes, current byte
+                // may be the start of a new sync word
+                unsigned skipped = sync_i + 1;
+                sync_i = 0;
+                if (c == syncWord[0])
+                {
+                    sync_i = 1;
+                    skipped--;
+                }
+                skipBytes(skipped);
             }
         }
         else if (hasSizeByte && !gotSize) // skipped if fixed frame size
@@ -382,7 +457,7 @@ unsigned ComplexFramedReader::readData()
                 _device->read((char*) &frameSize16, sizeof(frameSize16));
                 numBytesRead += sizeof(frameSize16);
 
-                if (_settingsWidget.endianness() == LittleEndian)
+                if (!bigEndian)
                 {
                     frameSize = qFromLittleEndian(frameSize16);
                 }
@@ -401,26 +476,17 @@ unsigned ComplexFramedReader::readData()
             // validate the size field
             if (frameSize == 0)
             {
-                qCritical() << "Frame size is read as 0!";
+                sizeError("Frame size is read as 0!");
                 reset();
             }
             else
             {
-                // Calculate expected sample set size from per-channel formats
-                unsigned sampleSetSize = 0;
-                for (unsigned i = 0; i < _numChannels; ++i)
-                {
-                    sampleSetSize += channelSampleSizes[i];
-                }
-                
+                unsigned sampleSetSize = this->sampleSetSize();
                 if (frameSize % sampleSetSize != 0) // MM changed to warning, other data im sending uses the same frame (~,<sz>,<data>,<csum>)
                 {
-                    if (debugModeEnabled)
-                    {
-                        qWarning() <<
-                            QString("Payload size (%1) is not multiple of %2 (sample set size)!") \
-                            .arg(frameSize).arg(sampleSetSize);
-                    }
+                    sizeError(QString("Payload size (%1) is not multiple of %2 (sample set size)!") \
+                              .arg(frameSize).arg(sampleSetSize),
+                              debugModeEnabled);
                     reset();
                 }
                 else
@@ -432,15 +498,16 @@ unsigned ComplexFramedReader::readData()
         }
         else // read data bytes
         {
-            // have enough data bytes? (+1 for checksum)
-            if (bytesAvailable < (checksumEnabled ? frameSize+1 : frameSize))
+            // have enough data bytes?
+            unsigned dataSize = frameDataSize();
+            if (bytesAvailable < dataSize)
             {
                 break;
             }
             else // read data bytes and checksum
             {
                 readFrameDataAndCheck();
-                numBytesRead += checksumEnabled ? frameSize+1 : frameSize;
+                numBytesRead += dataSize;
                 reset();
             }
         }
@@ -455,7 +522,11 @@ void ComplexFramedReader::reset()
     gotSync = false;
     gotSize = false;
     if (hasSizeByte) frameSize = 0;
-    calcChecksum = 0;
+}
+
+unsigned ComplexFramedReader::frameDataSize() const
+{
+    return (sequenceEnabled ? 1 : 0) + frameSize + checksumSize(checksumType);
 }
 
 // Important: this function assumes device has enough bytes to read a full frames data and checksum
@@ -464,112 +535,79 @@ void ComplexFramedReader::readFrameDataAndCheck()
     // if paused just read and waste data
     if (paused)
     {
-        _device->read(checksumEnabled ? frameSize+1 : frameSize);
+        _device->read(frameDataSize());
+        // frames skipped while paused shouldn't count as lost
+        stats.nextSequence = -1;
         return;
     }
 
-    // Calculate total sample set size
-    unsigned sampleSetSize = 0;
-    for (unsigned i = 0; i < _numChannels; ++i)
-    {
-        sampleSetSize += channelSampleSizes[i];
-    }
-
-    // a package is 1 set of samples for all channels
-    unsigned numOfPackagesToRead = frameSize / sampleSetSize;
-    SamplePack samples(numOfPackagesToRead, _numChannels);
-    for (unsigned i = 0; i < numOfPackagesToRead; i++)
-    {
-        for (unsigned int ci = 0; ci < _numChannels; ci++)
-        {
-            // Use per-channel read function if available, otherwise legacy
-            if (ci < channelReadFunctions.size())
-            {
-                currentChannelForPad = ci;  // Store for pad reader
-                samples.data(ci)[i] = (this->*channelReadFunctions[ci])();
-            }
-            else
-            {
-                samples.data(ci)[i] = (this->*readSample)();
-            }
-        }
-    }
+    // read the frame at once, checksum is calculated over the whole span
+    frameBuffer.resize(frameDataSize());
+    _device->read(frameBuffer.data(), frameBuffer.size());
+    const uchar* data = (const uchar*) frameBuffer.constData();
+    unsigned spanSize = frameBuffer.size() - checksumSize(checksumType);
 
-    // read checksum
-    unsigned rChecksum = 0;
-    bool checksumPassed = false;
-    if (checksumEnabled)
+    if (checksumType != Checksum_none)
     {
-        _device->read((char*) &rChecksum, 1);
-        calcChecksum &= 0xFF;
-        checksumPassed = (calcChecksum == rChecksum);
+        quint32 calcChecksum = checksum(checksumType, data, spanSize);
+        quint32 rChecksum = readChecksum(checksumType, data + spanSize, bigEndian);
+        bool checksumPassed = (calcChecksum == rChecksum);
 #ifdef CSUM_USE_FIXED_AA
         // Allow checksum to pass if it's 0xAA (for debugging/testing)
-        if (!checksumPassed && rChecksum == 0xAA)
+        if (!checksumPassed && checksumType == Checksum_sum8 && rChecksum == 0xAA)
         {
             checksumPassed = true;
         }
 #endif
+        if (!checksumPassed)
+        {
+            stats.checksumFailures++;
+            countDecodeError();
+            if (errorLog.allow())
+            {
+                qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+            }
+            return;
+        }
     }
 
-    if (!checksumEnabled || checksumPassed)
-    {
-        // commit data
-        feedOut(samples);
-    }
-    else
+    quint8 sequence = 0;
+    if (sequenceEnabled)
     {
-        qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+        sequence = *data++;
     }
-}
 
-double ComplexFramedReader::readSampleAsPad()
-{
-    // Use per-channel pad size if available
-    unsigned padSize = sampleSize;  // default
-    if (currentChannelForPad < channelSampleSizes.size())
+    // a package is 1 set of samples for all channels
+    unsigned numOfPackagesToRead;
+    if (packedFormat != NumberFormat_INVALID)
     {
-        padSize = channelSampleSizes[currentChannelForPad];
+        numOfPackagesToRead = frameSize * 8 / (_numChannels * numberFormatBits(packedFormat));
     }
-
-    QByteArray padData = _device->read(padSize);
-
-    if (checksumEnabled)
+    else
     {
-        for (int i = 0; i < padData.size(); i++)
-        {
-            calcChecksum += (unsigned char) padData[i];
-        }
+        numOfPackagesToRead = frameSize / decodePlan.sampleSetSize();
     }
-
-    // Return 0 for pad bytes (uncheck visible to hide from plot)
-    return 0.0;
-}
-
-template<typename T> double ComplexFramedReader::readSampleAs()
-{
-    T data;
-
-    _device->read((char*) &data, sizeof(data));
-
-    if (checksumEnabled)
+    SamplePack samples(numOfPackagesToRead, _numChannels);
+    if (packedFormat != NumberFormat_INVALID)
     {
-        for (unsigned i = 0; i < sizeof(data); i++)
-        {
-            calcChecksum += ((unsigned char*) &data)[i];
-        }
+        unpackToChannels(packedFormat, data, frameSize / packedGroupBytes(packedFormat),
+                         bigEndian, samples);
     }
-
-    if (_settingsWidget.endianness() == LittleEndian)
+    else
     {
-        data = qFromLittleEndian(data);
+        decodePlan.decode(data, numOfPackagesToRead, bigEndian, samples);
     }
-    else
+
+    stats.framesOk++;
+    if (sequenceEnabled)
     {
-        data = qFromBigEndian(data);
+        // assume lost frames were the same size as this one
+        unsigned lost = stats.checkSequence(sequence);
+        feedGap(lost * numOfPackagesToRead);
     }
 
-    return double(data);
+    // commit data
+    feedOut(samples);
 }
 
 void ComplexFramedReader::saveSettings(QSettings* settings)
@@ -22,9 +22,13 @@
 
 #include <QSettings>
 #include <QVector>
+#include <QTimer>
 
 #include "abstractreader.h"
 #include "complexframedreadersettings.h"
+#include "framestats.h"
+#include "checksum.h"
+#include "decodeplan.h"
 
 /**
  * Reads data in a customizable complex framed format.
@@ -37,6 +41,10 @@ public:
     explicit ComplexFramedReader(QIODevice* device, QObject *parent = 0);
     QWidget* settingsWidget();
     unsigned numChannels() const;
+    /// Clears statistics when enabled
+    void enable(bool enabled = true) override;
+    /// Error and loss counters
+    const FrameStats& frameStats() const {return stats;};
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -47,7 +55,8 @@ private:
     enum SettingInvalidFlag
     {
         SYNCWORD_INVALID = 1,
-        FRAMESIZE_INVALID = 2
+        FRAMESIZE_INVALID = 2,
+        FORMAT_INVALID = 4      ///< packed and other formats are mixed
     };
 
     // settings related members
@@ -58,11 +67,13 @@ private:
     QVector<unsigned> channelSampleSizes;  /// sample size for each channel
     unsigned settingsInvalid;   /// settings are all valid if this is 0, if not no reading is done
     QByteArray syncWord;
-    bool checksumEnabled;
+    ChecksumType checksumType;
+    bool sequenceEnabled;
     bool hasSizeByte;
     bool isSizeField2B;         /// size field is 2 bytes
     unsigned frameSize;
     bool debugModeEnabled;
+    bool bigEndian;
 
     /// Checks the validity of syncWord and frameSize then shows an
     /// error message. Also updates `settingsInvalid`. If settings are
@@ -73,21 +84,35 @@ private:
     unsigned sync_i; /// sync byte index to be read next
     bool gotSync;    /// indicates if sync word is captured
     bool gotSize;    /// indicates if size is captured, ignored if size byte is disabled (fixed size)
-    unsigned calcChecksum;
+    QByteArray frameBuffer; /// sequence, payload and checksum of the frame being read
+    bool skippingBytes; /// bytes are being skipped to find sync
+
+    FrameStats stats;
+    LogRateLimiter errorLog;
+    QTimer statsTimer;
+
+    /// Counts bytes that are discarded while searching for sync
+    void skipBytes(unsigned n);
+    /// Counts and logs an invalid size field
+    void sizeError(QString message, bool log = true);
+    void updateStats();
 
     void reset();    /// Resets the reading state. Used in case of error or setting change.
-    /// points to the readSampleAs function for currently selected number format (deprecated)
-    double (ComplexFramedReader::*readSample)();
-    /// per-channel read functions
-    QVector<double (ComplexFramedReader::*)()> channelReadFunctions;
-    template<typename T> double readSampleAs();
-    double readSampleAsPad();  /// Reads pad bytes
-    unsigned currentChannelForPad;  /// Track which channel we're reading for pad
+    /// Size of the frame after size field (sequence + payload + checksum)
+    unsigned frameDataSize() const;
+    /// compiled from `channelFormats` and `channelSampleSizes`
+    DecodePlan decodePlan;
+    /// format of all channels if it's packed, `NumberFormat_INVALID` otherwise
+    NumberFormat packedFormat;
+    /// Rebuilds `decodePlan` after a change in channel formats
+    void compileDecodePlan();
+    /// Frame payload should be multiple of this
+    unsigned sampleSetSize() const;
     /// reads payload portion of the frame, calculates checksum and commits data
     /// @note should be called only if there are enough bytes on device
     void readFrameDataAndCheck();
 
-    /// Initialize format, size, and read function for a single channel
+    /// Initialize format and size for a single channel
     void initializeChannelFormat(unsigned channel, NumberFormat format);
 
     unsigned readData() override;
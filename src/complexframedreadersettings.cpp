@@ -41,15 +41,26 @@ ComplexFramedReaderSettings::ComplexFramedReaderSettings(QWidget *parent) :
     channelPadSizes[0] = 1;
     createFormatBoxes(1);
 
-    connect(ui->cbChecksum, &QCheckBox::toggled,
-            [this](bool enabled)
+    ui->cbChecksum->addItem(tr("None"), (int) Checksum_none);
+    ui->cbChecksum->addItem(tr("Sum (8 bit)"), (int) Checksum_sum8);
+    ui->cbChecksum->addItem(tr("CRC-16/CCITT"), (int) Checksum_crc16);
+    ui->cbChecksum->addItem(tr("CRC-32"), (int) Checksum_crc32);
+
+    connect(ui->cbChecksum, &QComboBox::currentIndexChanged,
+            [this]()
             {
-                emit checksumChanged(enabled);
+                emit checksumChanged(checksumType());
             });
 
     connect(ui->cbDebugMode, &QCheckBox::toggled,
             this, &ComplexFramedReaderSettings::debugModeChanged);
 
+    connect(ui->cbSequence, &QCheckBox::toggled,
+            this, &ComplexFramedReaderSettings::sequenceChanged);
+
+    connect(ui->pbResetStats, &QPushButton::clicked,
+            this, &ComplexFramedReaderSettings::resetStatsRequested);
+
     {
         // add frame size selection buttons to the same fbGroup
         // fbGroup = new QButtonGroup(this);
@@ -107,6 +118,9 @@ ComplexFramedReaderSettings::ComplexFramedReaderSettings(QWidget *parent) :
     connect(ui->lblSyncWordAscii, &QLineEdit::textChanged,
             this, &ComplexFramedReaderSettings::onAsciiEdited);
 
+    connect(ui->endiBox, &EndiannessBox::selectionChanged,
+            this, &ComplexFramedReaderSettings::endiannessChanged);
+
     updateSyncWordAscii(); // Initialize ASCII display
 }
 
@@ -336,9 +350,19 @@ unsigned ComplexFramedReaderSettings::fixedFrameSize() const
     return ui->spSize->value();
 }
 
-bool ComplexFramedReaderSettings::isChecksumEnabled()
+ChecksumType ComplexFramedReaderSettings::checksumType() const
+{
+    return static_cast<ChecksumType>(ui->cbChecksum->currentData().toInt());
+}
+
+bool ComplexFramedReaderSettings::isSequenceEnabled()
 {
-    return ui->cbChecksum->isChecked();
+    return ui->cbSequence->isChecked();
+}
+
+void ComplexFramedReaderSettings::showStats(QString stats)
+{
+    ui->lStats->setText(stats);
 }
 
 unsigned ComplexFramedReaderSettings::padSize() const
@@ -386,8 +410,9 @@ void ComplexFramedReaderSettings::saveSettings(QSettings* settings)
     }
     settings->setValue(SG_ComplexFrame_SizeFieldType, sizeFieldStr);
     settings->setValue(SG_ComplexFrame_FixedFrameSize, fixedFrameSize());
-    settings->setValue(SG_ComplexFrame_Checksum, ui->cbChecksum->isChecked());
+    settings->setValue(SG_ComplexFrame_Checksum, checksumTypeToStr(checksumType()));
     settings->setValue(SG_ComplexFrame_DebugMode, ui->cbDebugMode->isChecked());
+    settings->setValue(SG_ComplexFrame_Sequence, ui->cbSequence->isChecked());
     settings->endGroup();
 }
 
@@ -471,12 +496,20 @@ void ComplexFramedReaderSettings::loadSettings(QSettings* settings)
     } // ignore invalid value
 
     // load checksum
-    ui->cbChecksum->setChecked(
-        settings->value(SG_ComplexFrame_Checksum, ui->cbChecksum->isChecked()).toBool());
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_ComplexFrame_Checksum, QString()).toString());
+    if (csSetting != Checksum_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(ui->cbChecksum->findData((int) csSetting));
+    }
 
     // load debug mode
     ui->cbDebugMode->setChecked(
         settings->value(SG_ComplexFrame_DebugMode, ui->cbDebugMode->isChecked()).toBool());
 
+    // load sequence number
+    ui->cbSequence->setChecked(
+        settings->value(SG_ComplexFrame_Sequence, ui->cbSequence->isChecked()).toBool());
+
     settings->endGroup();
 }
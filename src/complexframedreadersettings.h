@@ -30,6 +30,7 @@
 
 #include "numberformatbox.h"
 #include "endiannessbox.h"
+#include "checksum.h"
 
 namespace Ui {
 class ComplexFramedReaderSettings;
@@ -49,6 +50,8 @@ public:
     ~ComplexFramedReaderSettings();
 
     void showMessage(QString message, bool error = false);
+    /// Displays frame statistics
+    void showStats(QString stats);
 
     unsigned numOfChannels();
     NumberFormat numberFormat();  /// deprecated: returns format of first channel
@@ -61,7 +64,8 @@ public:
     SizeFieldType sizeFieldType() const;
     unsigned fixedFrameSize() const;
     unsigned padSize() const;  /// deprecated: returns pad size of first channel
-    bool isChecksumEnabled();
+    ChecksumType checksumType() const;
+    bool isSequenceEnabled();
     bool isDebugModeEnabled();
     /// Save settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -76,8 +80,12 @@ signals:
     void sizeFieldChanged(SizeFieldType type, unsigned size);
     /// `0` indicates frame size byte is enabled
     void fixedFrameSizeChanged(unsigned);
-    void checksumChanged(bool);
+    void checksumChanged(ChecksumType);
+    void sequenceChanged(bool);
+    /// Reset button for statistics is clicked
+    void resetStatsRequested();
     void numOfChannelsChanged(unsigned);
+    void endiannessChanged(Endianness);
     void numberFormatChanged(NumberFormat);  /// deprecated
     void channelFormatChanged(unsigned channel, NumberFormat format);
     void channelPadSizeChanged(unsigned channel, unsigned size);
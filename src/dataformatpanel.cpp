@@ -21,10 +21,15 @@
 #include "ui_dataformatpanel.h"
 
 #include <QRadioButton>
+#include <QComboBox>
+#include <QSpinBox>
 #include <QtDebug>
 
 #include "setting_defines.h"
 
+/// Batch statistics label update interval (ms)
+#define BATCH_STATS_INTERVAL 1000
+
 DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     QWidget(parent),
     ui(new Ui::DataFormatPanel),
@@ -32,6 +37,9 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     asciiReader(port, this),
     framedReader(port, this),
     complexFramedReader(port, this),
+    delimitedReader(port, this),
+    multiMessageReader(port, this),
+    fileReplayReader(port, this),
     demoReader(port, this)
 {
     ui->setupUi(this);
@@ -52,6 +60,9 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     readerSelectButtons.addButton(ui->rbAscii);
     readerSelectButtons.addButton(ui->rbFramed);
     readerSelectButtons.addButton(ui->rbComplexFramed);
+    readerSelectButtons.addButton(ui->rbDelimited);
+    readerSelectButtons.addButton(ui->rbMultiMessage);
+    readerSelectButtons.addButton(ui->rbFileReplay);
 
     connect(ui->rbBinary, &QRadioButton::toggled, [this](bool checked)
             {
@@ -72,6 +83,35 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
             {
                 if (checked) selectReader(&complexFramedReader);
             });
+
+    connect(ui->rbDelimited, &QRadioButton::toggled, [this](bool checked)
+            {
+                if (checked) selectReader(&delimitedReader);
+            });
+
+    connect(ui->rbMultiMessage, &QRadioButton::toggled, [this](bool checked)
+            {
+                if (checked) selectReader(&multiMessageReader);
+            });
+
+    connect(ui->rbFileReplay, &QRadioButton::toggled, [this](bool checked)
+            {
+                if (checked) selectReader(&fileReplayReader);
+            });
+
+    // read batching
+    connect(ui->cbBatchMode, &QComboBox::currentIndexChanged,
+            [this](int) {updateBatchPolicy();});
+    connect(ui->spBatchMinBytes, &QSpinBox::valueChanged,
+            [this](int) {updateBatchPolicy();});
+    connect(ui->spBatchMaxDelay, &QSpinBox::valueChanged,
+            [this](int) {updateBatchPolicy();});
+    updateBatchPolicy();
+
+    batchStatsTimer.setInterval(BATCH_STATS_INTERVAL);
+    connect(&batchStatsTimer, &QTimer::timeout,
+            this, &DataFormatPanel::updateBatchStats);
+    batchStatsTimer.start();
 }
 
 DataFormatPanel::~DataFormatPanel()
@@ -115,6 +155,9 @@ void DataFormatPanel::enableDemo(bool demoEnabled)
     ui->rbBinary->setDisabled(demoEnabled);
     ui->rbFramed->setDisabled(demoEnabled);
     ui->rbComplexFramed->setDisabled(demoEnabled);
+    ui->rbDelimited->setDisabled(demoEnabled);
+    ui->rbMultiMessage->setDisabled(demoEnabled);
+    ui->rbFileReplay->setDisabled(demoEnabled);
 }
 
 bool DataFormatPanel::isDemoEnabled() const
@@ -142,6 +185,84 @@ void DataFormatPanel::selectReader(AbstractReader* reader)
     emit sourceChanged(currentReader);
 }
 
+void DataFormatPanel::setDevice(QIODevice* device)
+{
+    bsReader.setDevice(device);
+    asciiReader.setDevice(device);
+    framedReader.setDevice(device);
+    complexFramedReader.setDevice(device);
+    delimitedReader.setDevice(device);
+    multiMessageReader.setDevice(device);
+}
+
+void DataFormatPanel::setRawCapture(RawCapture* capture)
+{
+    bsReader.setRawCapture(capture);
+    asciiReader.setRawCapture(capture);
+    framedReader.setRawCapture(capture);
+    complexFramedReader.setRawCapture(capture);
+    delimitedReader.setRawCapture(capture);
+    multiMessageReader.setRawCapture(capture);
+}
+
+void DataFormatPanel::setLatencyTracer(LatencyTracer* tracer)
+{
+    bsReader.setLatencyTracer(tracer);
+    asciiReader.setLatencyTracer(tracer);
+    framedReader.setLatencyTracer(tracer);
+    complexFramedReader.setLatencyTracer(tracer);
+    delimitedReader.setLatencyTracer(tracer);
+    multiMessageReader.setLatencyTracer(tracer);
+    fileReplayReader.setLatencyTracer(tracer);
+    demoReader.setLatencyTracer(tracer);
+}
+
+void DataFormatPanel::setPerfCounters(PerfCounters* counters)
+{
+    bsReader.setPerfCounters(counters);
+    asciiReader.setPerfCounters(counters);
+    framedReader.setPerfCounters(counters);
+    complexFramedReader.setPerfCounters(counters);
+    delimitedReader.setPerfCounters(counters);
+    multiMessageReader.setPerfCounters(counters);
+    fileReplayReader.setPerfCounters(counters);
+    demoReader.setPerfCounters(counters);
+}
+
+void DataFormatPanel::updateBatchPolicy()
+{
+    AbstractReader::BatchPolicy policy;
+    policy.mode = AbstractReader::BatchMode(ui->cbBatchMode->currentIndex());
+    policy.minBytes = ui->spBatchMinBytes->value();
+    policy.maxDelay = ui->spBatchMaxDelay->value();
+
+    // min bytes is estimated in adaptive mode
+    ui->spBatchMinBytes->setEnabled(policy.mode == AbstractReader::BatchMode::Fixed);
+    ui->spBatchMaxDelay->setEnabled(policy.mode != AbstractReader::BatchMode::Off);
+
+    // file replay and demo readers don't read from a device
+    bsReader.setBatchPolicy(policy);
+    asciiReader.setBatchPolicy(policy);
+    framedReader.setBatchPolicy(policy);
+    complexFramedReader.setBatchPolicy(policy);
+    delimitedReader.setBatchPolicy(policy);
+    multiMessageReader.setBatchPolicy(policy);
+}
+
+void DataFormatPanel::updateBatchStats()
+{
+    auto stats = currentReader->takeBatchStats();
+    if (!stats.batches)
+    {
+        ui->lBatchStats->setText("-");
+        return;
+    }
+
+    ui->lBatchStats->setText(tr("%1 B/read, %2 ms wait")
+                             .arg(stats.avgBytes, 0, 'f', 0)
+                             .arg(stats.avgDelay, 0, 'f', 1));
+}
+
 uint64_t DataFormatPanel::bytesRead()
 {
     _bytesRead += currentReader->getBytesRead();
@@ -167,12 +288,30 @@ void DataFormatPanel::saveSettings(QSettings* settings)
     {
         format = "custom";
     }
+    else if (selectedReader == &delimitedReader)
+    {
+        format = "delimited";
+    }
+    else if (selectedReader == &multiMessageReader)
+    {
+        format = "multimessage";
+    }
+    else if (selectedReader == &fileReplayReader)
+    {
+        format = "filereplay";
+    }
     else // complex framed reader
     {
         format = "complex";
     }
     settings->setValue(SG_DataFormat_Format, format);
 
+    // save read batching
+    const char* batchModes[] = {"off", "fixed", "adaptive"};
+    settings->setValue(SG_DataFormat_BatchMode, batchModes[ui->cbBatchMode->currentIndex()]);
+    settings->setValue(SG_DataFormat_BatchMinBytes, ui->spBatchMinBytes->value());
+    settings->setValue(SG_DataFormat_BatchMaxDelay, ui->spBatchMaxDelay->value());
+
     settings->endGroup();
 
     // save reader settings
@@ -180,6 +319,9 @@ void DataFormatPanel::saveSettings(QSettings* settings)
     asciiReader.saveSettings(settings);
     framedReader.saveSettings(settings);
     complexFramedReader.saveSettings(settings);
+    delimitedReader.saveSettings(settings);
+    multiMessageReader.saveSettings(settings);
+    fileReplayReader.saveSettings(settings);
 }
 
 void DataFormatPanel::loadSettings(QSettings* settings)
@@ -209,8 +351,42 @@ void DataFormatPanel::loadSettings(QSettings* settings)
     {
         selectReader(&complexFramedReader);
         ui->rbComplexFramed->setChecked(true);
+    }
+    else if (format == "delimited")
+    {
+        selectReader(&delimitedReader);
+        ui->rbDelimited->setChecked(true);
+    }
+    else if (format == "multimessage")
+    {
+        selectReader(&multiMessageReader);
+        ui->rbMultiMessage->setChecked(true);
+    }
+    else if (format == "filereplay")
+    {
+        selectReader(&fileReplayReader);
+        ui->rbFileReplay->setChecked(true);
     } // else current selection stays
 
+    // load read batching
+    QString batchMode = settings->value(SG_DataFormat_BatchMode, QString()).toString();
+    if (batchMode == "off")
+    {
+        ui->cbBatchMode->setCurrentIndex(int(AbstractReader::BatchMode::Off));
+    }
+    else if (batchMode == "fixed")
+    {
+        ui->cbBatchMode->setCurrentIndex(int(AbstractReader::BatchMode::Fixed));
+    }
+    else if (batchMode == "adaptive")
+    {
+        ui->cbBatchMode->setCurrentIndex(int(AbstractReader::BatchMode::Adaptive));
+    }
+    ui->spBatchMinBytes->setValue(
+        settings->value(SG_DataFormat_BatchMinBytes, ui->spBatchMinBytes->value()).toInt());
+    ui->spBatchMaxDelay->setValue(
+        settings->value(SG_DataFormat_BatchMaxDelay, ui->spBatchMaxDelay->value()).toInt());
+
     settings->endGroup();
 
     // load reader settings
@@ -218,4 +394,7 @@ void DataFormatPanel::loadSettings(QSettings* settings)
     asciiReader.loadSettings(settings);
     framedReader.loadSettings(settings);
     complexFramedReader.loadSettings(settings);
+    delimitedReader.loadSettings(settings);
+    multiMessageReader.loadSettings(settings);
+    fileReplayReader.loadSettings(settings);
 }
@@ -28,13 +28,18 @@
 #include <QSettings>
 #include <QtGlobal>
 #include <QButtonGroup>
+#include <QTimer>
 
 #include "binarystreamreader.h"
 #include "asciireader.h"
 #include "demoreader.h"
 #include "framedreader.h"
 #include "complexframedreader.h"
+#include "delimitedreader.h"
+#include "multimessagereader.h"
+#include "filereplayreader.h"
 #include "datarecorder.h"
+#include "rawcapture.h"
 
 namespace Ui {
 class DataFormatPanel;
@@ -58,6 +63,15 @@ public:
     void saveSettings(QSettings* settings);
     /// Loads data format panel settings from a `QSettings`.
     void loadSettings(QSettings* settings);
+    /// Changes the device readers read from. Used for replaying a
+    /// raw capture in place of the serial port.
+    void setDevice(QIODevice* device);
+    /// Sets the raw capture sink of all readers
+    void setRawCapture(RawCapture* capture);
+    /// Sets the latency tracer of all readers
+    void setLatencyTracer(LatencyTracer* tracer);
+    /// Sets the performance counters of all readers
+    void setPerfCounters(PerfCounters* counters);
 
 public slots:
     void pause(bool);
@@ -77,6 +91,9 @@ private:
     AsciiReader asciiReader;
     FramedReader framedReader;
     ComplexFramedReader complexFramedReader;
+    DelimitedReader delimitedReader;
+    MultiMessageReader multiMessageReader;
+    FileReplayReader fileReplayReader;
     /// Currently selected reader
     AbstractReader* currentReader;
     /// Disable current reader and enable a another one
@@ -89,6 +106,14 @@ private:
     AbstractReader* readerBeforeDemo;
 
     bool isDemoEnabled() const;
+
+    /// Updates batch statistics label
+    QTimer batchStatsTimer;
+    /// Applies batching settings from UI to all readers
+    void updateBatchPolicy();
+
+private slots:
+    void updateBatchStats();
 };
 
 #endif // DATAFORMATPANEL_H
@@ -19,11 +19,48 @@
 
 #include "datarecorder.h"
 
+#include <cstring>
 #include <QFileInfo>
 #include <QDir>
 #include <QDateTime>
+#include <QDataStream>
+#include <QtNumeric>
 #include <QtDebug>
 
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+ * Checkpoint index file is a single fixed size record that is
+ * overwritten in place at every checkpoint. All fields are little
+ * endian:
+ *
+ *   "SPCK"     4 bytes magic
+ *   version    uint32
+ *   offset     uint64, size of the recording file that is durable
+ *   samples    uint64, number of data rows in that part of the file
+ *   checksum   uint16, CRC of the preceding bytes
+ */
+static const char CHECKPOINT_MAGIC[] = "SPCK";
+static const quint32 CHECKPOINT_VERSION = 1;
+static const int CHECKPOINT_RECORD_SIZE = 4 + 4 + 8 + 8 + 2;
+
+/// Flushes file and makes sure its data reaches the disk.
+static bool syncFile(QFile& file)
+{
+    if (!file.flush()) return false;
+#if defined(Q_OS_WIN)
+    return _commit(file.handle()) == 0;
+#elif defined(Q_OS_MACOS)
+    return fsync(file.handle()) == 0; // there is no fdatasync on macos
+#else
+    return fdatasync(file.handle()) == 0;
+#endif
+}
+
 DataRecorder::DataRecorder(QObject *parent) :
     QObject(parent),
     fileStream(&file)
@@ -32,6 +69,9 @@ DataRecorder::DataRecorder(QObject *parent) :
     disableBuffering = false;
     windowsLE = false;
     timestampOpt = TimestampOption::disabled;
+    checkpointInterval = 0;
+    samplesWritten = 0;
+    _durableSamples = 0;
 
     fileStream.setRealNumberNotation(QTextStream::FixedNotation);
 }
@@ -41,6 +81,21 @@ void DataRecorder::setDecimals(unsigned decimals)
     fileStream.setRealNumberPrecision(decimals);
 }
 
+void DataRecorder::setCheckpointInterval(unsigned ms)
+{
+    checkpointInterval = ms;
+}
+
+quint64 DataRecorder::durableSamples() const
+{
+    return _durableSamples;
+}
+
+QString DataRecorder::checkpointFileName(QString fileName)
+{
+    return fileName + ".ckpt";
+}
+
 bool DataRecorder::startRecording(QString fileName, QString separator,
                                   QStringList channelNames, TimestampOption ts)
 {
@@ -78,6 +133,24 @@ bool DataRecorder::startRecording(QString fileName, QString separator,
         fileStream << le();
         lastNumChannels = channelNames.length();
     }
+
+    samplesWritten = 0;
+    _durableSamples = 0;
+
+    // Checkpoint file is kept open during recording. Note that a
+    // checkpoint file left from an earlier recording is truncated.
+    if (checkpointInterval)
+    {
+        checkpointFile.setFileName(checkpointFileName(fileName));
+        if (!checkpointFile.open(QIODevice::WriteOnly))
+        {
+            qCritical() << "Opening checkpoint file " << checkpointFile.fileName()
+                        << " failed with error: " << checkpointFile.error();
+        }
+        checkpoint();
+        checkpointTimer.start();
+    }
+
     return true;
 }
 
@@ -106,21 +179,158 @@ void DataRecorder::feedIn(const SamplePack& data)
         }
         for (unsigned ci = 0; ci < numChannels; ci++)
         {
-            fileStream << data.data(ci)[i];
+            // NaN marks lost data, leave the field empty
+            double value = data.data(ci)[i];
+            if (!qIsNaN(value)) fileStream << value;
             if (ci != numChannels-1) fileStream << _sep;
         }
         fileStream << le();
     }
+    samplesWritten += numSamples;
 
     if (disableBuffering) fileStream.flush();
+
+    if (checkpointInterval && checkpointTimer.hasExpired(checkpointInterval))
+    {
+        checkpoint();
+        checkpointTimer.restart();
+    }
+}
+
+void DataRecorder::checkpoint()
+{
+    if (!file.isOpen() || !checkpointFile.isOpen()) return;
+
+    // data must be durable before the index pointing to it
+    fileStream.flush();
+    if (!syncFile(file))
+    {
+        qWarning() << "Failed to sync recording file to disk:" << file.errorString();
+        return;
+    }
+
+    if (writeCheckpoint(file.pos(), samplesWritten))
+    {
+        _durableSamples = samplesWritten;
+    }
+}
+
+bool DataRecorder::writeCheckpoint(quint64 offset, quint64 samples)
+{
+    QByteArray record;
+    QDataStream ds(&record, QIODevice::WriteOnly);
+    ds.setByteOrder(QDataStream::LittleEndian);
+    ds.writeRawData(CHECKPOINT_MAGIC, 4);
+    ds << CHECKPOINT_VERSION << offset << samples;
+    ds << qChecksum(record);
+    Q_ASSERT(record.size() == CHECKPOINT_RECORD_SIZE);
+
+    // record is small enough to be written in a single sector
+    if (!checkpointFile.seek(0) ||
+        checkpointFile.write(record) != record.size() ||
+        !syncFile(checkpointFile))
+    {
+        qWarning() << "Failed to write checkpoint:" << checkpointFile.errorString();
+        return false;
+    }
+    return true;
 }
 
 void DataRecorder::stopRecording()
 {
     Q_ASSERT(file.isOpen());
 
+    fileStream.flush();
     file.close();
     lastNumChannels = 0;
+
+    // recording is complete, checkpoint index isn't needed anymore
+    if (checkpointFile.isOpen())
+    {
+        checkpointFile.close();
+        checkpointFile.remove();
+    }
+}
+
+qint64 DataRecorder::recoveredSize(QString fileName)
+{
+    QFile recFile(fileName);
+    if (!recFile.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Can't open recording for recovery:" << fileName;
+        return -1;
+    }
+    qint64 size = recFile.size();
+    qint64 keep = -1;
+
+    // try the checkpoint index first
+    QFile ckptFile(checkpointFileName(fileName));
+    if (ckptFile.open(QIODevice::ReadOnly))
+    {
+        QByteArray record = ckptFile.read(CHECKPOINT_RECORD_SIZE);
+        ckptFile.close();
+
+        if (record.size() == CHECKPOINT_RECORD_SIZE)
+        {
+            QDataStream ds(record);
+            ds.setByteOrder(QDataStream::LittleEndian);
+            char magic[4];
+            quint32 version;
+            quint64 offset, samples;
+            quint16 checksum;
+            ds.readRawData(magic, 4);
+            ds >> version >> offset >> samples >> checksum;
+
+            if (memcmp(magic, CHECKPOINT_MAGIC, 4) == 0 &&
+                version == CHECKPOINT_VERSION &&
+                checksum == qChecksum(record.left(record.size()-2)) &&
+                offset <= (quint64) size)
+            {
+                keep = offset;
+                qInfo() << "Last checkpoint of" << fileName << "is at" << samples << "samples";
+            }
+        }
+
+        if (keep < 0)
+        {
+            qWarning() << "Checkpoint index is invalid, ignoring:" << ckptFile.fileName();
+        }
+    }
+
+    // no valid checkpoint, drop the partial line at the end if any
+    if (keep < 0)
+    {
+        const qint64 chunkSize = 4096;
+        qint64 pos = size;
+        keep = 0;
+        while (pos > 0 && keep == 0)
+        {
+            qint64 start = qMax(pos - chunkSize, qint64(0));
+            recFile.seek(start);
+            QByteArray chunk = recFile.read(pos - start);
+            int nl = chunk.lastIndexOf('\n');
+            if (nl >= 0) keep = start + nl + 1;
+            pos = start;
+        }
+    }
+
+    return keep;
+}
+
+qint64 DataRecorder::recoverRecording(QString fileName)
+{
+    qint64 keep = recoveredSize(fileName);
+    if (keep < 0) return -1;
+
+    QFile recFile(fileName);
+    if (keep < recFile.size() && !recFile.resize(keep))
+    {
+        qCritical() << "Failed to truncate recording:" << recFile.errorString();
+        return -1;
+    }
+
+    QFile::remove(checkpointFileName(fileName));
+    return keep;
 }
 
 QString DataRecorder::formatTimestamp() const
@@ -23,6 +23,7 @@
 #include <QObject>
 #include <QFile>
 #include <QTextStream>
+#include <QElapsedTimer>
 
 #include "sink.h"
 
@@ -46,6 +47,49 @@ public:
     /// Disables file buffering
     bool disableBuffering;
 
+    /**
+     * Enables periodic durable checkpoints. `0` disables checkpointing.
+     *
+     * When enabled, written data is committed in groups: at most once per
+     * `ms` milliseconds the stream is flushed, file is synced to disk
+     * (`fdatasync`) and the checkpoint index file is updated with the
+     * position of the last durable sample. This is much cheaper than
+     * `disableBuffering` while still bounding the data lost on a crash.
+     *
+     * @see recoverRecording
+     */
+    void setCheckpointInterval(unsigned ms);
+
+    /// Forces a checkpoint immediately. Does nothing if not recording.
+    void checkpoint();
+
+    /// Number of samples (rows) that are known to be durable on disk
+    quint64 durableSamples() const;
+
+    /// Returns the name of the checkpoint index file of a recording
+    static QString checkpointFileName(QString fileName);
+
+    /**
+     * Truncates a recording that was interrupted (crash, power loss
+     * etc.) to a consistent point.
+     *
+     * If a valid checkpoint index exists, file is truncated to the last
+     * durable sample. Otherwise partially written last line is
+     * removed. Checkpoint index is deleted afterwards.
+     *
+     * @return number of bytes kept, or -1 if file can't be recovered
+     * @see recoveredSize
+     */
+    static qint64 recoverRecording(QString fileName);
+
+    /**
+     * Returns the size `recoverRecording` would truncate the file to,
+     * without modifying anything. Used to ask the user first.
+     *
+     * @return size in bytes, or -1 if file can't be read
+     */
+    static qint64 recoveredSize(QString fileName);
+
     /**
      * Use CR+LF as line ending. `false` by default.
      *
@@ -106,6 +150,16 @@ private:
     QString _sep;
     TimestampOption timestampOpt;
 
+    // checkpoint related members
+    unsigned checkpointInterval; ///< in milliseconds, 0 if disabled
+    QElapsedTimer checkpointTimer;
+    QFile checkpointFile;
+    quint64 samplesWritten;      ///< rows written since start, excluding header
+    quint64 _durableSamples;     ///< rows written at the last checkpoint
+
+    /// Writes a new checkpoint record to `checkpointFile`
+    bool writeCheckpoint(quint64 offset, quint64 samples);
+
     /// Returns formatted timestamp
     QString formatTimestamp() const;
 
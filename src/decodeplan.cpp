@@ -0,0 +1,215 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <QtEndian>
+#include <QVarLengthArray>
+
+#include "decodeplan.h"
+
+/// Decodes a field of `n` sample sets that are `stride` bytes apart
+template<typename T>
+static void decodeColumn(const uchar* src, unsigned stride, unsigned n,
+                         bool bigEndian, double* dst)
+{
+    if (bigEndian)
+    {
+        for (unsigned i = 0; i < n; i++)
+        {
+            dst[i] = double(qFromBigEndian<T>(src + i * stride));
+        }
+    }
+    else
+    {
+        for (unsigned i = 0; i < n; i++)
+        {
+            dst[i] = double(qFromLittleEndian<T>(src + i * stride));
+        }
+    }
+}
+
+/**
+ * De-interleaves `n` sample sets of `nc` channels of type `T` stored
+ * back to back, reading the input once in order. `NC` fixes the
+ * channel count at compile time so the inner loop can be unrolled, 0
+ * uses `nc`.
+ */
+template<typename T, bool BigEndian, unsigned NC>
+static void deinterleave(const uchar* src, unsigned nc, unsigned n, double* const* dst)
+{
+    if (NC) nc = NC;
+    for (unsigned i = 0; i < n; i++)
+    {
+        const uchar* set = src + i * nc * sizeof(T);
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            const uchar* p = set + ci * sizeof(T);
+            dst[ci][i] = double(BigEndian ? qFromBigEndian<T>(p) : qFromLittleEndian<T>(p));
+        }
+    }
+}
+
+template<typename T, bool BigEndian>
+static void deinterleaveAs(const uchar* src, unsigned nc, unsigned n, double* const* dst)
+{
+    switch (nc)
+    {
+        case 2:  deinterleave<T, BigEndian, 2>(src, nc, n, dst); break;
+        case 3:  deinterleave<T, BigEndian, 3>(src, nc, n, dst); break;
+        case 4:  deinterleave<T, BigEndian, 4>(src, nc, n, dst); break;
+        default: deinterleave<T, BigEndian, 0>(src, nc, n, dst); break;
+    }
+}
+
+template<typename T>
+static void deinterleaveAs(const uchar* src, unsigned nc, unsigned n,
+                           bool bigEndian, double* const* dst)
+{
+    if (bigEndian)
+    {
+        deinterleaveAs<T, true>(src, nc, n, dst);
+    }
+    else
+    {
+        deinterleaveAs<T, false>(src, nc, n, dst);
+    }
+}
+
+/// Decodes a 3 byte integer field, sign extended if `Signed`
+template<bool Signed>
+static void decodeColumn24(const uchar* src, unsigned stride, unsigned n,
+                           bool bigEndian, double* dst)
+{
+    for (unsigned i = 0; i < n; i++)
+    {
+        const uchar* p = src + i * stride;
+        quint32 value = bigEndian ?
+            (quint32(p[0]) << 16) | (quint32(p[1]) << 8) | p[2] :
+            (quint32(p[2]) << 16) | (quint32(p[1]) << 8) | p[0];
+        if (Signed)
+        {
+            dst[i] = double(qint32(value << 8) >> 8);
+        }
+        else
+        {
+            dst[i] = double(value);
+        }
+    }
+}
+
+DecodePlan::DecodePlan()
+{
+    _sampleSetSize = 0;
+    _uniform = false;
+}
+
+void DecodePlan::clear()
+{
+    fields.clear();
+    _sampleSetSize = 0;
+    _uniform = false;
+}
+
+void DecodePlan::addField(NumberFormat format, unsigned offset, unsigned channel)
+{
+    fields.append({offset, channel, format});
+    updateUniform();
+}
+
+void DecodePlan::setSampleSetSize(unsigned size)
+{
+    _sampleSetSize = size;
+    updateUniform();
+}
+
+void DecodePlan::updateUniform()
+{
+    _uniform = false;
+    if (fields.size() < 2) return; // single field is already contiguous
+
+    NumberFormat format = fields[0].format;
+    if (format == NumberFormat_pad || isPackedFormat(format) ||
+        format == NumberFormat_uint24 || format == NumberFormat_int24)
+    {
+        return;
+    }
+
+    unsigned size = numberFormatBits(format) / 8;
+    for (int i = 0; i < fields.size(); i++)
+    {
+        if (fields[i].format != format ||
+            fields[i].offset != i * size ||
+            fields[i].channel != unsigned(i))
+        {
+            return;
+        }
+    }
+    _uniform = _sampleSetSize == fields.size() * size;
+}
+
+void DecodePlan::decode(const uchar* data, unsigned numSets, bool bigEndian,
+                        SamplePack& samples, unsigned index, unsigned firstChannel) const
+{
+    if (_uniform)
+    {
+        unsigned nc = fields.size();
+        QVarLengthArray<double*, 16> dst(nc);
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            dst[ci] = samples.data(firstChannel + ci) + index;
+        }
+
+        switch (fields[0].format)
+        {
+            case NumberFormat_uint8:  deinterleaveAs<quint8>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_int8:   deinterleaveAs<qint8>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_uint16: deinterleaveAs<quint16>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_int16:  deinterleaveAs<qint16>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_uint32: deinterleaveAs<quint32>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_int32:  deinterleaveAs<qint32>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_float:  deinterleaveAs<float>(data, nc, numSets, bigEndian, dst.data()); break;
+            case NumberFormat_double: deinterleaveAs<double>(data, nc, numSets, bigEndian, dst.data()); break;
+            default: Q_ASSERT(false); break; // excluded by `updateUniform`
+        }
+        return;
+    }
+
+    for (auto& field : fields)
+    {
+        const uchar* src = data + field.offset;
+        double* dst = samples.data(firstChannel + field.channel) + index;
+        unsigned stride = _sampleSetSize;
+
+        switch (field.format)
+        {
+            case NumberFormat_uint8:  decodeColumn<quint8>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_int8:   decodeColumn<qint8>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_uint16: decodeColumn<quint16>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_int16:  decodeColumn<qint16>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_uint24: decodeColumn24<false>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_int24:  decodeColumn24<true>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_uint32: decodeColumn<quint32>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_int32:  decodeColumn<qint32>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_float:  decodeColumn<float>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_double: decodeColumn<double>(src, stride, numSets, bigEndian, dst); break;
+            case NumberFormat_pad:    std::fill_n(dst, numSets, 0.); break;
+            default: break; // packed formats aren't byte aligned, see `packedformat.h`
+        }
+    }
+}
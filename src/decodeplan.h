@@ -0,0 +1,89 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECODEPLAN_H
+#define DECODEPLAN_H
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "numberformat.h"
+#include "samplepack.h"
+
+/**
+ * A flat list of fields of a sample set; offset, format and target
+ * channel of each. Compiled once when the layout changes, then used
+ * to decode any number of consecutive sample sets from memory.
+ *
+ * Decoding runs field by field over all sample sets, so the format is
+ * dispatched once per field per call instead of once per sample. Each
+ * field is read with a loop specialized for its type.
+ *
+ * Layouts where all channels have the same type and are packed back
+ * to back without padding (ex: plain binary stream data) are
+ * de-interleaved in a single pass over the input instead.
+ */
+class DecodePlan
+{
+public:
+    DecodePlan();
+
+    /// Removes all fields
+    void clear();
+
+    /**
+     * Adds a field to the plan.
+     *
+     * @param format `NumberFormat_pad` fields decode as 0, packed
+     * formats aren't supported
+     * @param offset from the start of the sample set in bytes
+     * @param channel target channel
+     */
+    void addField(NumberFormat format, unsigned offset, unsigned channel);
+
+    /// Sets the size of a sample set, including padding
+    void setSampleSetSize(unsigned size);
+    unsigned sampleSetSize() const {return _sampleSetSize;};
+    unsigned numFields() const {return fields.size();};
+
+    /**
+     * Decodes `numSets` consecutive sample sets at `data` into
+     * `samples`, starting from sample `index`. Channels are offset
+     * by `firstChannel`.
+     */
+    void decode(const uchar* data, unsigned numSets, bool bigEndian,
+                SamplePack& samples, unsigned index = 0, unsigned firstChannel = 0) const;
+
+private:
+    struct Field
+    {
+        unsigned offset;
+        unsigned channel;
+        NumberFormat format;
+    };
+
+    QVector<Field> fields;
+    unsigned _sampleSetSize;
+    /// all fields have the same type and follow each other in channel order
+    bool _uniform;
+
+    void updateUniform();
+};
+
+#endif // DECODEPLAN_H
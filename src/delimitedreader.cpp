@@ -0,0 +1,335 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QPair>
+#include <QVector>
+#include <QtDebug>
+
+#include "delimitedreader.h"
+
+#define STATS_UPDATE_INTERVAL 500 // ms
+#define MAX_FRAME_SIZE        65536 // bytes, longer frames are discarded
+
+#define COBS_DELIMITER 0x00
+#define SLIP_END       0xC0
+#define SLIP_ESC       0xDB
+#define SLIP_ESC_END   0xDC
+#define SLIP_ESC_ESC   0xDD
+
+DelimitedReader::DelimitedReader(QIODevice* device, QObject* parent) :
+    AbstractReader(device, parent),
+    statsTimer(this)
+{
+    paused = false;
+
+    // initial settings
+    encoding = _settingsWidget.encoding();
+    layout = _settingsWidget.layout();
+    checksumType = _settingsWidget.checksumType();
+    bigEndian = _settingsWidget.endianness() == BigEndian;
+    skippingBytes = false;
+    scanned = 0;
+
+    connect(&_settingsWidget, &DelimitedReaderSettings::encodingChanged,
+            [this](DelimitedReaderSettings::Encoding e){encoding = e; reset();});
+
+    connect(&_settingsWidget, &DelimitedReaderSettings::layoutChanged,
+            this, &DelimitedReader::onLayoutChanged);
+
+    connect(&_settingsWidget, &DelimitedReaderSettings::endiannessChanged,
+            [this](Endianness e){bigEndian = (e == BigEndian);});
+
+    connect(&_settingsWidget, &DelimitedReaderSettings::checksumChanged,
+            [this](ChecksumType type){checksumType = type;});
+
+    connect(&_settingsWidget, &DelimitedReaderSettings::resetStatsRequested,
+            [this]()
+            {
+                stats.clear();
+                updateStats();
+            });
+
+    statsTimer.setInterval(STATS_UPDATE_INTERVAL);
+    connect(&statsTimer, &QTimer::timeout, this, &DelimitedReader::updateStats);
+}
+
+QWidget* DelimitedReader::settingsWidget()
+{
+    return &_settingsWidget;
+}
+
+unsigned DelimitedReader::numChannels() const
+{
+    return layout.numChannels();
+}
+
+void DelimitedReader::enable(bool enabled)
+{
+    if (enabled)
+    {
+        stats.clear();
+        reset();
+        statsTimer.start();
+    }
+    else
+    {
+        statsTimer.stop();
+    }
+    updateStats();
+    AbstractReader::enable(enabled);
+}
+
+void DelimitedReader::updateStats()
+{
+    // readers of a merged source run on a worker thread, widget is
+    // only touched from the GUI thread
+    if (thread() != _settingsWidget.thread())
+    {
+        QString summary = stats.summary(false);
+        QMetaObject::invokeMethod(&_settingsWidget, [this, summary]()
+            {
+                if (_settingsWidget.isVisible()) _settingsWidget.showStats(summary);
+            }, Qt::QueuedConnection);
+        return;
+    }
+
+    // no need to update if nobody is looking
+    if (!_settingsWidget.isVisible()) return;
+
+    _settingsWidget.showStats(stats.summary(false));
+}
+
+void DelimitedReader::onLayoutChanged(FrameLayout newLayout)
+{
+    unsigned oldNumChannels = layout.numChannels();
+    layout = newLayout;
+    if (layout.numChannels() != oldNumChannels)
+    {
+        updateNumChannels();
+        emit numOfChannelsChanged(layout.numChannels());
+    }
+}
+
+char DelimitedReader::delimiter() const
+{
+    return encoding == DelimitedReaderSettings::Encoding::COBS ?
+        (char) COBS_DELIMITER : (char) SLIP_END;
+}
+
+void DelimitedReader::reset()
+{
+    buffer.clear();
+    scanned = 0;
+    // first frame is likely to be partial, don't decode it
+    skippingBytes = true;
+}
+
+void DelimitedReader::frameError(QString message)
+{
+    stats.sizeErrors++;
+    countDecodeError();
+    if (errorLog.allow()) qCritical() << message;
+}
+
+int DelimitedReader::decodeCobs(uchar* data, unsigned size)
+{
+    unsigned in = 0, out = 0;
+    while (in < size)
+    {
+        unsigned code = data[in++];
+        if (code == 0 || in + code - 1 > size) return -1;
+
+        // block is copied to its place, output never passes input
+        unsigned blockSize = code - 1;
+        memmove(data + out, data + in, blockSize);
+        in += blockSize;
+        out += blockSize;
+
+        // a block shorter than max implies a zero, except the last one
+        if (code < 0xFF && in < size) data[out++] = 0;
+    }
+    return out;
+}
+
+int DelimitedReader::decodeSlip(uchar* data, unsigned size)
+{
+    unsigned in = 0, out = 0;
+    while (in < size)
+    {
+        // copy until the next escape byte
+        const uchar* esc = (const uchar*) memchr(data + in, SLIP_ESC, size - in);
+        unsigned blockSize = esc ? (esc - data) - in : size - in;
+        if (out != in) memmove(data + out, data + in, blockSize);
+        in += blockSize;
+        out += blockSize;
+
+        if (esc)
+        {
+            if (in + 1 >= size) return -1;
+            uchar c = data[in + 1];
+            if (c == SLIP_ESC_END)
+            {
+                data[out++] = SLIP_END;
+            }
+            else if (c == SLIP_ESC_ESC)
+            {
+                data[out++] = SLIP_ESC;
+            }
+            else
+            {
+                return -1;
+            }
+            in += 2;
+        }
+    }
+    return out;
+}
+
+int DelimitedReader::decodeFrame(uchar* data, unsigned size)
+{
+    int decodedSize;
+    if (encoding == DelimitedReaderSettings::Encoding::COBS)
+    {
+        decodedSize = decodeCobs(data, size);
+    }
+    else
+    {
+        decodedSize = decodeSlip(data, size);
+    }
+
+    if (decodedSize < 0)
+    {
+        frameError("Malformed frame, couldn't decode!");
+        return -1;
+    }
+
+    int csSize = checksumSize(checksumType);
+    int payloadSize = decodedSize - csSize;
+    if (payloadSize <= 0 || payloadSize % layout.size() != 0)
+    {
+        frameError(QString("Payload size (%1) is not multiple of %2 (sample set size)!")
+                   .arg(payloadSize).arg(layout.size()));
+        return -1;
+    }
+
+    if (checksumType != Checksum_none)
+    {
+        quint32 calcChecksum = checksum(checksumType, data, payloadSize);
+        quint32 rChecksum = readChecksum(checksumType, data + payloadSize, bigEndian);
+        if (calcChecksum != rChecksum)
+        {
+            stats.checksumFailures++;
+            countDecodeError();
+            if (errorLog.allow())
+            {
+                qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+            }
+            return -1;
+        }
+    }
+
+    stats.framesOk++;
+    return payloadSize;
+}
+
+unsigned DelimitedReader::readData()
+{
+    // append to the receive buffer without an intermediate copy
+    int oldSize = buffer.size();
+    qint64 bytesAvailable = _device->bytesAvailable();
+    buffer.resize(oldSize + bytesAvailable);
+    qint64 numBytesRead = _device->read(buffer.data() + oldSize, bytesAvailable);
+    if (numBytesRead < 0) numBytesRead = 0;
+    buffer.resize(oldSize + numBytesRead);
+
+    uchar* data = (uchar*) buffer.data();
+    int size = buffer.size();
+    char delim = delimiter();
+
+    // decoded payloads in the buffer, as (offset, size)
+    QVector<QPair<int, int>> payloads;
+    unsigned numSets = 0;
+
+    int start = 0; // start of the current frame
+    int pos = scanned;
+    const uchar* end;
+    while ((end = (const uchar*) memchr(data + pos, delim, size - pos)))
+    {
+        int frameSize = (end - data) - start;
+        if (skippingBytes)
+        {
+            stats.bytesSkipped += frameSize;
+            skippingBytes = false;
+        }
+        else if (frameSize > 0 && !paused) // empty frames are allowed as separators
+        {
+            int payloadSize = decodeFrame(data + start, frameSize);
+            if (payloadSize > 0)
+            {
+                payloads.append({start, payloadSize});
+                numSets += payloadSize / layout.size();
+            }
+        }
+        start = (end - data) + 1;
+        pos = start;
+    }
+
+    // no delimiter for too long, drop bytes until the next one
+    if (size - start > MAX_FRAME_SIZE)
+    {
+        stats.bytesSkipped += size - start;
+        if (!skippingBytes)
+        {
+            skippingBytes = true;
+            stats.syncMisses++;
+            countSyncLoss();
+        }
+        start = size;
+    }
+
+    if (numSets)
+    {
+        // all frames of this read are committed at once
+        SamplePack samples(numSets, layout.numChannels());
+        unsigned si = 0;
+        for (auto& payload : payloads)
+        {
+            unsigned numPayloadSets = payload.second / layout.size();
+            layout.decode(data + payload.first, numPayloadSets, bigEndian, samples, si);
+            si += numPayloadSets;
+        }
+        feedOut(samples);
+    }
+
+    buffer.remove(0, start);
+    scanned = buffer.size();
+
+    return numBytesRead;
+}
+
+void DelimitedReader::saveSettings(QSettings* settings)
+{
+    _settingsWidget.saveSettings(settings);
+}
+
+void DelimitedReader::loadSettings(QSettings* settings)
+{
+    _settingsWidget.loadSettings(settings);
+}
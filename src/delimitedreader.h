@@ -0,0 +1,110 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DELIMITEDREADER_H
+#define DELIMITEDREADER_H
+
+#include <QSettings>
+#include <QTimer>
+
+#include "abstractreader.h"
+#include "delimitedreadersettings.h"
+#include "framestats.h"
+#include "framelayout.h"
+#include "checksum.h"
+
+/**
+ * Reads frames that are separated by a delimiter byte; COBS (0x00)
+ * or SLIP (0xC0) encoded. Frames are decoded in place in the receive
+ * buffer. Payload is one or more sample sets described by a
+ * `FrameLayout`, optionally followed by a checksum.
+ */
+class DelimitedReader : public AbstractReader
+{
+    Q_OBJECT
+
+public:
+    explicit DelimitedReader(QIODevice* device, QObject *parent = 0);
+    QWidget* settingsWidget();
+    unsigned numChannels() const;
+    /// Clears statistics when enabled
+    void enable(bool enabled = true) override;
+    /// Error counters
+    const FrameStats& frameStats() const {return stats;};
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+    /**
+     * Decodes a COBS encoded frame in place. `data` shouldn't contain
+     * the delimiter.
+     *
+     * @return size of the decoded frame, -1 if frame is malformed
+     */
+    static int decodeCobs(uchar* data, unsigned size);
+
+    /**
+     * Decodes a SLIP encoded frame in place. `data` shouldn't contain
+     * the delimiter.
+     *
+     * @return size of the decoded frame, -1 if frame is malformed
+     */
+    static int decodeSlip(uchar* data, unsigned size);
+
+private:
+    DelimitedReaderSettings _settingsWidget;
+    DelimitedReaderSettings::Encoding encoding;
+    FrameLayout layout;
+    ChecksumType checksumType;
+    bool bigEndian;
+
+    /// received bytes that are not yet consumed
+    QByteArray buffer;
+    /// bytes at the start of `buffer` already searched for delimiter
+    int scanned;
+    /// bytes are being skipped because frame is too long
+    bool skippingBytes;
+
+    FrameStats stats;
+    LogRateLimiter errorLog;
+    QTimer statsTimer;
+
+    /// Delimiter byte of the current encoding
+    char delimiter() const;
+    /// Drops buffered bytes, used when settings change
+    void reset();
+    /// Counts and logs a malformed frame
+    void frameError(QString message);
+    void updateStats();
+
+    /**
+     * Decodes and checks a frame in place.
+     *
+     * @return payload size, -1 if frame is invalid
+     */
+    int decodeFrame(uchar* data, unsigned size);
+
+    unsigned readData() override;
+
+private slots:
+    void onLayoutChanged(FrameLayout newLayout);
+};
+
+#endif // DELIMITEDREADER_H
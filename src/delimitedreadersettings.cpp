@@ -0,0 +1,178 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "setting_defines.h"
+#include "delimitedreadersettings.h"
+#include "ui_delimitedreadersettings.h"
+
+#define DEFAULT_LAYOUT "u8"
+
+DelimitedReaderSettings::DelimitedReaderSettings(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::DelimitedReaderSettings)
+{
+    ui->setupUi(this);
+
+    ui->cbEncoding->addItem("COBS", (int) Encoding::COBS);
+    ui->cbEncoding->addItem("SLIP", (int) Encoding::SLIP);
+
+    ui->cbChecksum->addItem(tr("None"), (int) Checksum_none);
+    ui->cbChecksum->addItem(tr("Sum (8 bit)"), (int) Checksum_sum8);
+    ui->cbChecksum->addItem(tr("CRC-16/CCITT"), (int) Checksum_crc16);
+    ui->cbChecksum->addItem(tr("CRC-32"), (int) Checksum_crc32);
+
+    ui->leLayout->setText(DEFAULT_LAYOUT);
+    onLayoutEdited();
+
+    connect(ui->cbEncoding, &QComboBox::currentIndexChanged,
+            [this]()
+            {
+                emit encodingChanged(encoding());
+            });
+
+    connect(ui->leLayout, &QLineEdit::editingFinished,
+            this, &DelimitedReaderSettings::onLayoutEdited);
+
+    connect(ui->endiBox, &EndiannessBox::selectionChanged,
+            this, &DelimitedReaderSettings::endiannessChanged);
+
+    connect(ui->cbChecksum, &QComboBox::currentIndexChanged,
+            [this]()
+            {
+                emit checksumChanged(checksumType());
+            });
+
+    connect(ui->pbResetStats, &QPushButton::clicked,
+            this, &DelimitedReaderSettings::resetStatsRequested);
+}
+
+DelimitedReaderSettings::~DelimitedReaderSettings()
+{
+    delete ui;
+}
+
+void DelimitedReaderSettings::showMessage(QString message, bool error)
+{
+    ui->lMessage->setText(message);
+    if (error)
+    {
+        ui->lMessage->setStyleSheet("color: red;");
+    }
+    else
+    {
+        ui->lMessage->setStyleSheet("");
+    }
+}
+
+void DelimitedReaderSettings::showStats(QString stats)
+{
+    ui->lStats->setText(stats);
+}
+
+DelimitedReaderSettings::Encoding DelimitedReaderSettings::encoding() const
+{
+    return static_cast<Encoding>(ui->cbEncoding->currentData().toInt());
+}
+
+FrameLayout DelimitedReaderSettings::layout() const
+{
+    return _layout;
+}
+
+Endianness DelimitedReaderSettings::endianness()
+{
+    return ui->endiBox->currentSelection();
+}
+
+ChecksumType DelimitedReaderSettings::checksumType() const
+{
+    return static_cast<ChecksumType>(ui->cbChecksum->currentData().toInt());
+}
+
+void DelimitedReaderSettings::onLayoutEdited()
+{
+    QString text = ui->leLayout->text();
+    if (text == _layout.text()) return;
+
+    QString error;
+    if (!_layout.parse(text, &error))
+    {
+        showMessage(error, true);
+        return;
+    }
+
+    showMessage(QString("Settings OK. [%1 channels, sample set = %2B]")
+                .arg(_layout.numChannels()).arg(_layout.size()));
+    emit layoutChanged(_layout);
+}
+
+void DelimitedReaderSettings::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Delimited);
+    settings->setValue(SG_Delimited_Encoding,
+                       encoding() == Encoding::COBS ? "cobs" : "slip");
+    settings->setValue(SG_Delimited_Layout, _layout.text());
+    settings->setValue(SG_Delimited_Endianness,
+                       endianness() == LittleEndian ? "little" : "big");
+    settings->setValue(SG_Delimited_Checksum, checksumTypeToStr(checksumType()));
+    settings->endGroup();
+}
+
+void DelimitedReaderSettings::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Delimited);
+
+    // load encoding
+    QString encodingSetting = settings->value(SG_Delimited_Encoding, QString()).toString();
+    if (encodingSetting == "cobs")
+    {
+        ui->cbEncoding->setCurrentIndex(ui->cbEncoding->findData((int) Encoding::COBS));
+    }
+    else if (encodingSetting == "slip")
+    {
+        ui->cbEncoding->setCurrentIndex(ui->cbEncoding->findData((int) Encoding::SLIP));
+    } // else don't change
+
+    // load layout
+    ui->leLayout->setText(
+        settings->value(SG_Delimited_Layout, ui->leLayout->text()).toString());
+    onLayoutEdited();
+
+    // load endianness
+    QString endiannessSetting =
+        settings->value(SG_Delimited_Endianness, QString()).toString();
+    if (endiannessSetting == "little")
+    {
+        ui->endiBox->setSelection(LittleEndian);
+    }
+    else if (endiannessSetting == "big")
+    {
+        ui->endiBox->setSelection(BigEndian);
+    } // else don't change
+
+    // load checksum
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_Delimited_Checksum, QString()).toString());
+    if (csSetting != Checksum_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(ui->cbChecksum->findData((int) csSetting));
+    }
+
+    settings->endGroup();
+}
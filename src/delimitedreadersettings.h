@@ -0,0 +1,79 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DELIMITEDREADERSETTINGS_H
+#define DELIMITEDREADERSETTINGS_H
+
+#include <QWidget>
+#include <QSettings>
+
+#include "endiannessbox.h"
+#include "checksum.h"
+#include "framelayout.h"
+
+namespace Ui {
+class DelimitedReaderSettings;
+}
+
+class DelimitedReaderSettings : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class Encoding
+    {
+        COBS, SLIP
+    };
+
+    explicit DelimitedReaderSettings(QWidget *parent = 0);
+    ~DelimitedReaderSettings();
+
+    void showMessage(QString message, bool error = false);
+    /// Displays frame statistics
+    void showStats(QString stats);
+
+    Encoding encoding() const;
+    /// Last valid layout entered
+    FrameLayout layout() const;
+    Endianness endianness();
+    ChecksumType checksumType() const;
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+signals:
+    void encodingChanged(Encoding);
+    /// Signaled only when a valid layout is entered
+    void layoutChanged(FrameLayout);
+    void endiannessChanged(Endianness);
+    void checksumChanged(ChecksumType);
+    /// Reset button for statistics is clicked
+    void resetStatsRequested();
+
+private:
+    Ui::DelimitedReaderSettings *ui;
+    FrameLayout _layout;
+
+    /// Parses the layout text, shows an error if it's invalid
+    void onLayoutEdited();
+};
+
+#endif // DELIMITEDREADERSETTINGS_H
@@ -18,6 +18,8 @@
 */
 
 #include <math.h>
+#include <algorithm>
+#include <QRandomGenerator>
 
 #include "demoreader.h"
 
@@ -25,6 +27,19 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+/// Lookup table size of periodic waveforms (as bits)
+#define TABLE_BITS 12
+/// Noise is a longer table of pregenerated random values
+#define NOISE_TABLE_BITS 16
+/// Timer interval in normal mode, 1 sample is generated per interval
+#define NORMAL_INTERVAL 100
+/// Timer interval in high rate mode
+#define HIGH_RATE_INTERVAL 10
+/// Generation time limit in one timer tick, so that UI stays responsive
+#define HIGH_RATE_TIME_SLICE 50
+/// Minimum period of waveforms in samples
+#define MIN_PERIOD 100
+
 DemoReader::DemoReader(QIODevice* device, QObject* parent) :
     AbstractReader(device, parent)
 {
@@ -33,10 +48,13 @@ DemoReader::DemoReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &DemoReaderSettings::numChannelsChanged,
             this, &DemoReader::onNumChannelsChanged);
 
-    count = 0;
-    timer.setInterval(100);
+    timer.setTimerType(Qt::PreciseTimer);
     connect(&timer, &QTimer::timeout,
             this, &DemoReader::demoTimerTimeout);
+
+    connect(&_settingsWidget, &DemoReaderSettings::generatorChanged,
+            this, &DemoReader::setupGenerator);
+    setupGenerator();
 }
 
 QWidget* DemoReader::settingsWidget()
@@ -48,6 +66,7 @@ void DemoReader::enable(bool enabled)
 {
     if (enabled)
     {
+        setupGenerator();
         timer.start();
     }
     else
@@ -68,21 +87,132 @@ void DemoReader::setNumChannels(unsigned value)
     _settingsWidget.setNumChannels(value);
 }
 
-void DemoReader::demoTimerTimeout()
+void DemoReader::setupGenerator()
+{
+    auto waveform = _settingsWidget.waveform();
+    bool isNoise = waveform == DemoReaderSettings::Waveform::noise;
+    unsigned size = 1 << (isNoise ? NOISE_TABLE_BITS : TABLE_BITS);
+
+    table.resize(size);
+    for (unsigned i = 0; i < size; i++)
+    {
+        double x = double(i) / size; // position in period [0, 1)
+        double& v = table[i];
+        switch (waveform)
+        {
+            case DemoReaderSettings::Waveform::fourier:
+            case DemoReaderSettings::Waveform::sine:
+                v = sin(2*M_PI*x);
+                break;
+            case DemoReaderSettings::Waveform::square:
+                v = x < 0.5 ? 1. : -1.;
+                break;
+            case DemoReaderSettings::Waveform::triangle:
+                v = x < 0.25 ? 4*x : (x < 0.75 ? 2 - 4*x : 4*x - 4);
+                break;
+            case DemoReaderSettings::Waveform::sawtooth:
+                v = 2*x - 1;
+                break;
+            case DemoReaderSettings::Waveform::noise:
+                v = QRandomGenerator::global()->generateDouble()*2 - 1;
+                break;
+        }
+    }
+
+    // in normal mode 1 sample is generated per timer tick
+    bool highRate = _settingsWidget.highRate();
+    unsigned rate = highRate ? _settingsWidget.rate() : 1000 / NORMAL_INTERVAL;
+    unsigned period = std::max(unsigned(MIN_PERIOD), rate);
+
+    phase = 0;
+    phaseStep = (quint64(1) << 32) / period;
+    noisePos = 0;
+    samplesGenerated = 0;
+    rateTimer.start();
+    timer.setInterval(highRate ? HIGH_RATE_INTERVAL : NORMAL_INTERVAL);
+}
+
+void DemoReader::generate(unsigned numSamples)
 {
-    const double period = 100;
-    count++;
-    if (count >= 100) count = 0;
+    samplesGenerated += numSamples;
 
-    if (!paused)
+    if (paused)
+    {
+        phase += phaseStep * numSamples;
+        noisePos += numSamples;
+        return;
+    }
+
+    SamplePack samples(numSamples, _numChannels);
+    auto waveform = _settingsWidget.waveform();
+    const double* t = table.constData();
+
+    if (waveform == DemoReaderSettings::Waveform::noise)
+    {
+        const unsigned mask = table.size() - 1;
+        for (unsigned ci = 0; ci < _numChannels; ci++)
+        {
+            double* data = samples.data(ci);
+            unsigned pos = noisePos + ci * 7919; // different part of table for each channel
+            for (unsigned i = 0; i < numSamples; i++)
+            {
+                data[i] = t[(pos + i) & mask];
+            }
+        }
+        noisePos += numSamples;
+    }
+    else
     {
-        SamplePack samples(1, _numChannels);
+        const unsigned shift = 32 - TABLE_BITS;
         for (unsigned ci = 0; ci < _numChannels; ci++)
         {
-            // we are calculating the fourier components of square wave
-            samples.data(ci)[0] = 4*sin(2*M_PI*double((ci+1)*count)/period)/((2*(ci+1))*M_PI);
+            // channel N is the Nth harmonic
+            double amplitude = 1.;
+            if (waveform == DemoReaderSettings::Waveform::fourier)
+            {
+                amplitude = 4 / ((2*(ci+1))*M_PI);
+            }
+
+            double* data = samples.data(ci);
+            quint32 p = phase * (ci+1);
+            const quint32 step = phaseStep * (ci+1);
+            for (unsigned i = 0; i < numSamples; i++)
+            {
+                data[i] = amplitude * t[p >> shift];
+                p += step;
+            }
         }
-        feedOut(samples);
+        phase += phaseStep * numSamples;
+    }
+
+    feedOut(samples);
+}
+
+void DemoReader::demoTimerTimeout()
+{
+    if (!_settingsWidget.highRate())
+    {
+        generate(1);
+        return;
+    }
+
+    // generate as many batches as needed to catch up with the rate
+    const unsigned rate = _settingsWidget.rate();
+    const unsigned batchSize = _settingsWidget.batchSize();
+    quint64 due = rateTimer.nsecsElapsed() * 1e-9 * rate;
+
+    QElapsedTimer slice;
+    slice.start();
+    while (samplesGenerated + batchSize <= due &&
+           !slice.hasExpired(HIGH_RATE_TIME_SLICE))
+    {
+        generate(batchSize);
+    }
+
+    // if we can't keep up drop the backlog instead of falling behind forever
+    if (due > samplesGenerated + rate)
+    {
+        samplesGenerated = due;
     }
 }
 
@@ -21,6 +21,8 @@
 #define DEMOREADER_H
 
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
 
 #include "abstractreader.h"
 #include "demoreadersettings.h"
@@ -53,10 +55,27 @@ private:
 
     unsigned _numChannels;
     QTimer timer;
-    int count;
+
+    /// One period of selected waveform, looked up instead of
+    /// calculating each sample
+    QVector<double> table;
+    /// Fixed point phase, full range of 32 bits is one period
+    quint32 phase;
+    quint32 phaseStep;
+    /// Position in table for noise waveform
+    unsigned noisePos;
+
+    /// Used for catching up with the target rate in high rate mode
+    QElapsedTimer rateTimer;
+    quint64 samplesGenerated;
 
     unsigned readData() override;
 
+    /// Fills the lookup table and resets the generator
+    void setupGenerator();
+    /// Generates given number of samples and feeds them out
+    void generate(unsigned numSamples);
+
 private slots:
     void demoTimerTimeout();
     void onNumChannelsChanged(unsigned value);
@@ -35,6 +35,27 @@ DemoReaderSettings::DemoReaderSettings(QWidget *parent) :
             {
                 emit numChannelsChanged(value);
             });
+
+    ui->cbWaveform->addItem(tr("Fourier Series"), (int) Waveform::fourier);
+    ui->cbWaveform->addItem(tr("Sine"), (int) Waveform::sine);
+    ui->cbWaveform->addItem(tr("Square"), (int) Waveform::square);
+    ui->cbWaveform->addItem(tr("Triangle"), (int) Waveform::triangle);
+    ui->cbWaveform->addItem(tr("Sawtooth"), (int) Waveform::sawtooth);
+    ui->cbWaveform->addItem(tr("Noise"), (int) Waveform::noise);
+
+    connect(ui->cbHighRate, &QCheckBox::toggled, ui->spRate, &QWidget::setEnabled);
+    connect(ui->cbHighRate, &QCheckBox::toggled, ui->spBatchSize, &QWidget::setEnabled);
+    ui->spRate->setEnabled(false);
+    ui->spBatchSize->setEnabled(false);
+
+    connect(ui->cbWaveform, &QComboBox::currentIndexChanged,
+            this, &DemoReaderSettings::generatorChanged);
+    connect(ui->cbHighRate, &QCheckBox::toggled,
+            this, &DemoReaderSettings::generatorChanged);
+    connect(ui->spRate, &QSpinBox::valueChanged,
+            this, &DemoReaderSettings::generatorChanged);
+    connect(ui->spBatchSize, &QSpinBox::valueChanged,
+            this, &DemoReaderSettings::generatorChanged);
 }
 
 DemoReaderSettings::~DemoReaderSettings()
@@ -51,3 +72,23 @@ void DemoReaderSettings::setNumChannels(unsigned value)
 {
     ui->spNumChannels->setValue(value);
 }
+
+DemoReaderSettings::Waveform DemoReaderSettings::waveform() const
+{
+    return static_cast<Waveform>(ui->cbWaveform->currentData().toInt());
+}
+
+bool DemoReaderSettings::highRate() const
+{
+    return ui->cbHighRate->isChecked();
+}
+
+unsigned DemoReaderSettings::rate() const
+{
+    return ui->spRate->value();
+}
+
+unsigned DemoReaderSettings::batchSize() const
+{
+    return ui->spBatchSize->value();
+}
@@ -34,15 +34,34 @@ public:
     explicit DemoReaderSettings(QWidget *parent = 0);
     ~DemoReaderSettings();
 
+    enum class Waveform
+    {
+        fourier,                ///< fourier components of a square wave
+        sine,
+        square,
+        triangle,
+        sawtooth,
+        noise
+    };
+
     unsigned numChannels() const;
     /// Doesn't signal `numChannelsChanged`.
     void setNumChannels(unsigned value);
 
+    Waveform waveform() const;
+    bool highRate() const;
+    /// Samples per second in high rate mode
+    unsigned rate() const;
+    /// Number of samples generated at once in high rate mode
+    unsigned batchSize() const;
+
 private:
     Ui::DemoReaderSettings *ui;
 
 signals:
     void numChannelsChanged(unsigned);
+    /// Waveform or rate settings has changed
+    void generatorChanged();
 };
 
 #endif // DEMOREADERSETTINGS_H
@@ -0,0 +1,199 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QTableWidgetItem>
+
+#include "diagnosticspanel.h"
+#include "ui_diagnosticspanel.h"
+#include "setting_defines.h"
+
+#define UPDATE_INTERVAL 500     // ms
+#define PERF_INTERVAL   1000    // ms
+
+/// Formats a duration given in ns
+static QString durationStr(double ns)
+{
+    if (ns < 1e3) return QString("%1 ns").arg(ns, 0, 'f', 0);
+    if (ns < 1e6) return QString("%1 µs").arg(ns / 1e3, 0, 'f', 1);
+    if (ns < 1e9) return QString("%1 ms").arg(ns / 1e6, 0, 'f', 1);
+    return QString("%1 s").arg(ns / 1e9, 0, 'f', 2);
+}
+
+/// Formats a size given in bytes
+static QString bytesStr(qint64 bytes)
+{
+    if (bytes < 1024) return QString("%1 B").arg(bytes);
+    if (bytes < 1024*1024) return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    return QString("%1 MiB").arg(bytes / (1024.0*1024), 0, 'f', 1);
+}
+
+DiagnosticsPanel::DiagnosticsPanel(QWidget* parent) :
+    QWidget(parent),
+    ui(new Ui::DiagnosticsPanel)
+{
+    ui->setupUi(this);
+
+    QStringList columns({tr("Count"), tr("Mean"), tr("p50"), tr("p99"), tr("Max")});
+    ui->twLatency->setColumnCount(columns.size());
+    ui->twLatency->setHorizontalHeaderLabels(columns);
+    ui->twLatency->setRowCount(LatencyTracer::StageCount);
+    for (int s = 0; s < LatencyTracer::StageCount; s++)
+    {
+        ui->twLatency->setVerticalHeaderItem(
+            s, new QTableWidgetItem(LatencyTracer::stageName(LatencyTracer::Stage(s))));
+        for (int c = 0; c < columns.size(); c++)
+        {
+            auto item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            ui->twLatency->setItem(s, c, item);
+        }
+    }
+    ui->twLatency->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    connect(ui->cbTraceLatency, &QCheckBox::toggled, [this](bool checked)
+            {
+                _latencyTracer.setEnabled(checked);
+            });
+
+    connect(ui->pbReset, &QPushButton::clicked, [this]()
+            {
+                _latencyTracer.reset();
+                updateTable();
+            });
+
+    connect(ui->pbDump, &QPushButton::clicked, this, &DiagnosticsPanel::dump);
+
+    _statusLabel.setToolTip(tr("render rate and average/maximum replot time"));
+    _statusLabel.setVisible(false);
+    connect(ui->cbShowInStatusBar, &QCheckBox::toggled,
+            &_statusLabel, &QLabel::setVisible);
+
+    perfTimer.setInterval(PERF_INTERVAL);
+    connect(&perfTimer, &QTimer::timeout, this, &DiagnosticsPanel::updatePerf);
+    perfTimer.start();
+
+    updateTimer.setInterval(UPDATE_INTERVAL);
+    connect(&updateTimer, &QTimer::timeout, this, &DiagnosticsPanel::updateTable);
+    updateTimer.start();
+
+    updateTable();
+}
+
+DiagnosticsPanel::~DiagnosticsPanel()
+{
+    delete ui;
+}
+
+LatencyTracer* DiagnosticsPanel::latencyTracer()
+{
+    return &_latencyTracer;
+}
+
+PerfCounters* DiagnosticsPanel::perfCounters()
+{
+    return &_perfCounters;
+}
+
+QLabel* DiagnosticsPanel::statusLabel()
+{
+    return &_statusLabel;
+}
+
+void DiagnosticsPanel::updatePerf()
+{
+    // rates are taken even when not shown to keep the period correct
+    auto r = _perfCounters.takeRates();
+
+    if (_statusLabel.isVisible())
+    {
+        _statusLabel.setText(QString("%1fps %2/%3")
+                             .arg(r.fps, 0, 'f', 0)
+                             .arg(durationStr(r.replotAvgNs))
+                             .arg(durationStr(r.replotMaxNs)));
+    }
+
+    if (!isVisible()) return;
+
+    ui->lFps->setText(QString(tr("%1 fps")).arg(r.fps, 0, 'f', 1));
+    ui->lReplot->setText(QString(tr("avg %1, max %2"))
+                         .arg(durationStr(r.replotAvgNs))
+                         .arg(durationStr(r.replotMaxNs)));
+    ui->lReaderCpu->setText(QString("%1 %").arg(r.readerCpu * 100, 0, 'f', 1));
+    ui->lErrors->setText(QString(tr("%1 decode, %2 sync lost"))
+                         .arg(r.decodeErrors).arg(r.syncLosses));
+    ui->lQueue->setText(bytesStr(r.deviceQueue));
+    ui->lBuffer->setText(QString(tr("%1 per channel")).arg(bytesStr(r.bufferBytesPerChannel)));
+    if (r.portReadsPerSec > 0)
+    {
+        ui->lPortReads->setText(QString(tr("%1 reads/s, %2 per wake up"))
+                                .arg(r.portReadsPerSec, 0, 'f', 0)
+                                .arg(bytesStr(r.bytesPerWakeup)));
+    }
+    else
+    {
+        ui->lPortReads->setText("-");
+    }
+}
+
+void DiagnosticsPanel::updateTable()
+{
+    // no need to update when panel isn't shown
+    if (!isVisible()) return;
+
+    for (int s = 0; s < LatencyTracer::StageCount; s++)
+    {
+        auto& h = _latencyTracer.histogram(LatencyTracer::Stage(s));
+        bool empty = h.count() == 0;
+        ui->twLatency->item(s, 0)->setText(QString::number(h.count()));
+        ui->twLatency->item(s, 1)->setText(empty ? "-" : durationStr(h.mean()));
+        ui->twLatency->item(s, 2)->setText(empty ? "-" : durationStr(h.percentile(0.5)));
+        ui->twLatency->item(s, 3)->setText(empty ? "-" : durationStr(h.percentile(0.99)));
+        ui->twLatency->item(s, 4)->setText(empty ? "-" : durationStr(h.max()));
+    }
+}
+
+void DiagnosticsPanel::dump()
+{
+    QString fileName = QFileDialog::getSaveFileName(
+        parentWidget(), tr("Save latency histograms"), QString(), tr("CSV files (*.csv)"));
+
+    if (fileName.isEmpty()) return;
+
+    _latencyTracer.dump(fileName);
+}
+
+void DiagnosticsPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Diagnostics);
+    settings->setValue(SG_Diagnostics_TraceLatency, ui->cbTraceLatency->isChecked());
+    settings->setValue(SG_Diagnostics_ShowInStatusBar, ui->cbShowInStatusBar->isChecked());
+    settings->endGroup();
+}
+
+void DiagnosticsPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Diagnostics);
+    ui->cbTraceLatency->setChecked(
+        settings->value(SG_Diagnostics_TraceLatency, ui->cbTraceLatency->isChecked()).toBool());
+    ui->cbShowInStatusBar->setChecked(
+        settings->value(SG_Diagnostics_ShowInStatusBar, ui->cbShowInStatusBar->isChecked()).toBool());
+    settings->endGroup();
+}
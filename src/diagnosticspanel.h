@@ -0,0 +1,68 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DIAGNOSTICSPANEL_H
+#define DIAGNOSTICSPANEL_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QSettings>
+
+#include "latencytracer.h"
+#include "perfcounters.h"
+
+namespace Ui {
+class DiagnosticsPanel;
+}
+
+/// Displays performance diagnostics
+class DiagnosticsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPanel(QWidget* parent = 0);
+    ~DiagnosticsPanel();
+
+    LatencyTracer* latencyTracer();
+    PerfCounters* perfCounters();
+
+    /// Short performance summary to be placed in the status bar
+    QLabel* statusLabel();
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+private:
+    Ui::DiagnosticsPanel *ui;
+    LatencyTracer _latencyTracer;
+    PerfCounters _perfCounters;
+    QLabel _statusLabel;
+    QTimer updateTimer;
+    QTimer perfTimer;
+
+    void updateTable();
+    void updatePerf();
+    void dump();
+};
+
+#endif // DIAGNOSTICSPANEL_H
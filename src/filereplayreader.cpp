@@ -0,0 +1,524 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <QByteArray>
+#include <QtEndian>
+#include <QtDebug>
+
+#include "filereplayreader.h"
+#include "rawcapture.h"
+#include "defines.h"
+
+/// Maximum number of samples fed in one `SamplePack`
+#define FEED_BATCH 1024
+/// At maximum speed, control is returned to event loop this often (ms)
+#define FEED_TIME_SLICE 20
+/// Timer interval when replaying at a fixed rate (ms)
+#define FEED_INTERVAL 10
+#define STATUS_INTERVAL 500
+
+FileReplayReader::FileReplayReader(QIODevice* device, QObject* parent) :
+    AbstractReader(device, parent)
+{
+    paused = false;
+    map = nullptr;
+    mapSize = 0;
+    format = Format::binary;
+    rangeIndex = 0;
+    rangePos = 0;
+    dataSize = 0;
+    dataRead = 0;
+    sampleSize = 1;
+    endianness = LittleEndian;
+    decodeSample = &FileReplayReader::decodeSampleAs<quint8>;
+    csvSeparator = ',';
+    _samplesReplayed = 0;
+    runTime = 0;
+
+    _numChannels = _settingsWidget.numOfChannels();
+    connect(&_settingsWidget, &FileReplayReaderSettings::numOfChannelsChanged,
+            this, &FileReplayReader::onNumOfChannelsChanged);
+
+    connect(&_settingsWidget, &FileReplayReaderSettings::startRequested,
+            [this](bool start)
+            {
+                if (start)
+                {
+                    if (!this->start()) _settingsWidget.setRunning(false);
+                }
+                else
+                {
+                    stop();
+                }
+            });
+
+    feedTimer.setSingleShot(true);
+    connect(&feedTimer, &QTimer::timeout,
+            this, &FileReplayReader::onFeedTimeout);
+
+    statusTimer.setInterval(STATUS_INTERVAL);
+    connect(&statusTimer, &QTimer::timeout,
+            this, &FileReplayReader::updateStatus);
+}
+
+FileReplayReader::~FileReplayReader()
+{
+    stop();
+}
+
+QWidget* FileReplayReader::settingsWidget()
+{
+    return &_settingsWidget;
+}
+
+unsigned FileReplayReader::numChannels() const
+{
+    return _numChannels;
+}
+
+void FileReplayReader::enable(bool enabled)
+{
+    // replay is started by user from settings widget
+    if (!enabled) stop();
+
+    AbstractReader::enable(enabled);
+}
+
+bool FileReplayReader::isRunning() const
+{
+    return map != nullptr;
+}
+
+double FileReplayReader::ingestRate() const
+{
+    qint64 ns = isRunning() ? runTimer.nsecsElapsed() : runTime;
+    return ns > 0 ? _samplesReplayed * 1e9 / ns : 0;
+}
+
+bool FileReplayReader::start()
+{
+    stop();
+
+    file.setFileName(_settingsWidget.fileName());
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Opening file" << file.fileName()
+                    << "for replay failed:" << file.errorString();
+        return false;
+    }
+
+    mapSize = file.size();
+    if (mapSize == 0 || (map = file.map(0, mapSize)) == nullptr)
+    {
+        qCritical() << "Can't map file" << file.fileName();
+        file.close();
+        return false;
+    }
+
+    format = _settingsWidget.format();
+    if (!prepareRanges())
+    {
+        stop();
+        return false;
+    }
+
+    rewind();
+    _samplesReplayed = 0;
+    runTime = 0;
+    runTimer.start();
+    feedTimer.start(0);
+    statusTimer.start();
+    _settingsWidget.setRunning(true);
+    return true;
+}
+
+void FileReplayReader::stop()
+{
+    feedTimer.stop();
+    statusTimer.stop();
+    if (map != nullptr)
+    {
+        runTime = runTimer.nsecsElapsed();
+        file.unmap(const_cast<uchar*>(map));
+        map = nullptr;
+        updateStatus();
+    }
+    file.close();
+    _settingsWidget.setRunning(false);
+}
+
+bool FileReplayReader::prepareRanges()
+{
+    ranges.clear();
+
+    if (format == Format::csv)
+    {
+        if (!prepareCsv()) return false;
+    }
+    else
+    {
+        if (!setNumberFormat(_settingsWidget.numberFormat())) return false;
+        endianness = _settingsWidget.endianness();
+        if (_numChannels != _settingsWidget.numOfChannels())
+        {
+            _numChannels = _settingsWidget.numOfChannels();
+            updateNumChannels();
+            emit numOfChannelsChanged(_numChannels);
+        }
+
+        if (format == Format::binary)
+        {
+            ranges.append({0, mapSize});
+        }
+        else // raw capture
+        {
+            if (mapSize < RawCapture::HeaderSize ||
+                memcmp(map, RawCapture::Magic, sizeof(RawCapture::Magic)) != 0)
+            {
+                qCritical() << file.fileName() << "is not a raw capture file";
+                return false;
+            }
+
+            qint64 pos = RawCapture::HeaderSize;
+            while (pos + RawCapture::ChunkHeaderSize <= mapSize)
+            {
+                quint32 length = qFromLittleEndian<quint32>(map + pos + 8);
+                pos += RawCapture::ChunkHeaderSize;
+                if (pos + length > mapSize)
+                {
+                    qWarning() << "Capture file is truncated, last chunk is dropped.";
+                    break;
+                }
+                if (length > 0) ranges.append({pos, length});
+                pos += length;
+            }
+        }
+    }
+
+    dataSize = 0;
+    for (auto& range : ranges) dataSize += range.second;
+
+    return true;
+}
+
+bool FileReplayReader::prepareCsv()
+{
+    auto findLineEnd = [this](qint64 pos) -> qint64
+        {
+            auto nl = (const uchar*) memchr(map + pos, '\n', mapSize - pos);
+            return nl == nullptr ? mapSize : nl - map;
+        };
+
+    qint64 lineStart = 0;
+    qint64 lineEnd = findLineEnd(0);
+
+    // pick the separator from first line, in the order of preference
+    const char separators[] = {',', ';', '\t', ' '};
+    csvSeparator = ',';
+    for (char sep : separators)
+    {
+        if (memchr(map, sep, lineEnd) != nullptr)
+        {
+            csvSeparator = sep;
+            break;
+        }
+    }
+
+    // skip header line, its first field is not a number
+    auto firstField = QByteArray::fromRawData((const char*) map, lineEnd);
+    firstField = firstField.left(firstField.indexOf(csvSeparator)).trimmed();
+    bool isNumber;
+    firstField.toDouble(&isNumber);
+    if (!isNumber && !firstField.isEmpty())
+    {
+        lineStart = std::min(lineEnd + 1, mapSize);
+        lineEnd = findLineEnd(lineStart);
+    }
+
+    if (lineStart >= mapSize)
+    {
+        qCritical() << file.fileName() << "doesn't contain any data";
+        return false;
+    }
+
+    unsigned numFields = 1;
+    for (qint64 i = lineStart; i < lineEnd; i++)
+    {
+        if (map[i] == csvSeparator) numFields++;
+    }
+    if (numFields > MAX_NUM_CHANNELS)
+    {
+        qWarning() << "CSV file has" << numFields << "columns, only first"
+                   << MAX_NUM_CHANNELS << "will be replayed.";
+        numFields = MAX_NUM_CHANNELS;
+    }
+    if (numFields != _numChannels)
+    {
+        _numChannels = numFields;
+        updateNumChannels();
+        emit numOfChannelsChanged(_numChannels);
+    }
+
+    ranges.append({lineStart, mapSize - lineStart});
+    return true;
+}
+
+void FileReplayReader::rewind()
+{
+    rangeIndex = 0;
+    rangePos = 0;
+    dataRead = 0;
+}
+
+bool FileReplayReader::setNumberFormat(NumberFormat nf)
+{
+    switch(nf)
+    {
+        case NumberFormat_uint8:
+            sampleSize = sizeof(quint8);
+            decodeSample = &FileReplayReader::decodeSampleAs<quint8>;
+            break;
+        case NumberFormat_int8:
+            sampleSize = sizeof(qint8);
+            decodeSample = &FileReplayReader::decodeSampleAs<qint8>;
+            break;
+        case NumberFormat_uint16:
+            sampleSize = sizeof(quint16);
+            decodeSample = &FileReplayReader::decodeSampleAs<quint16>;
+            break;
+        case NumberFormat_int16:
+            sampleSize = sizeof(qint16);
+            decodeSample = &FileReplayReader::decodeSampleAs<qint16>;
+            break;
+        case NumberFormat_uint32:
+            sampleSize = sizeof(quint32);
+            decodeSample = &FileReplayReader::decodeSampleAs<quint32>;
+            break;
+        case NumberFormat_int32:
+            sampleSize = sizeof(qint32);
+            decodeSample = &FileReplayReader::decodeSampleAs<qint32>;
+            break;
+        case NumberFormat_float:
+            sampleSize = sizeof(float);
+            decodeSample = &FileReplayReader::decodeSampleAs<float>;
+            break;
+        case NumberFormat_double:
+            sampleSize = sizeof(double);
+            decodeSample = &FileReplayReader::decodeSampleAs<double>;
+            break;
+        default:
+            qCritical() << "Unsupported number format for file replay.";
+            return false;
+    }
+    return true;
+}
+
+template<typename T> double FileReplayReader::decodeSampleAs(const uchar* data) const
+{
+    T value;
+    memcpy(&value, data, sizeof(value));
+
+    if (endianness == LittleEndian)
+    {
+        value = qFromLittleEndian(value);
+    }
+    else
+    {
+        value = qFromBigEndian(value);
+    }
+
+    return double(value);
+}
+
+void FileReplayReader::onFeedTimeout()
+{
+    const unsigned rate = _settingsWidget.rate();
+    QElapsedTimer slice;
+    slice.start();
+
+    do
+    {
+        unsigned batch = FEED_BATCH;
+        if (rate > 0)
+        {
+            quint64 due = runTimer.nsecsElapsed() * 1e-9 * rate;
+            if (due <= _samplesReplayed) break;
+            batch = std::min<quint64>(batch, due - _samplesReplayed);
+        }
+
+        unsigned n = format == Format::csv ? feedCsv(batch) : feedBinary(batch);
+        _samplesReplayed += n;
+
+        if (n == 0)             // end of file
+        {
+            if (_settingsWidget.loop() && _samplesReplayed > 0)
+            {
+                rewind();
+                continue;
+            }
+
+            qInfo() << "File replay finished:" << _samplesReplayed << "samples in"
+                    << runTimer.elapsed() << "ms," << ingestRate() << "samples/s ingested";
+            stop();
+            emit finished();
+            return;
+        }
+    } while (!slice.hasExpired(FEED_TIME_SLICE));
+
+    feedTimer.start(rate > 0 ? FEED_INTERVAL : 0);
+}
+
+void FileReplayReader::readBytes(uchar* dest, unsigned size)
+{
+    while (size > 0)
+    {
+        auto& range = ranges[rangeIndex];
+        unsigned n = std::min<qint64>(size, range.second - rangePos);
+        memcpy(dest, map + range.first + rangePos, n);
+        dest += n;
+        size -= n;
+        rangePos += n;
+        dataRead += n;
+        if (rangePos == range.second)
+        {
+            rangeIndex++;
+            rangePos = 0;
+        }
+    }
+}
+
+unsigned FileReplayReader::feedBinary(unsigned maxSamples)
+{
+    // a package is a set of channel data like {CHAN0_SAMPLE, CHAN1_SAMPLE...}
+    const unsigned packageSize = sampleSize * _numChannels;
+    const unsigned n = std::min<qint64>(maxSamples, (dataSize - dataRead) / packageSize);
+    if (n == 0) return 0;
+
+    SamplePack samples(n, _numChannels);
+    uchar sample[sizeof(double)];
+    for (unsigned i = 0; i < n; i++)
+    {
+        for (unsigned ci = 0; ci < _numChannels; ci++)
+        {
+            auto& range = ranges[rangeIndex];
+            if (range.second - rangePos > sampleSize)
+            {
+                // fast path, sample is in the middle of a range
+                samples.data(ci)[i] = (this->*decodeSample)(map + range.first + rangePos);
+                rangePos += sampleSize;
+                dataRead += sampleSize;
+            }
+            else
+            {
+                readBytes(sample, sampleSize);
+                samples.data(ci)[i] = (this->*decodeSample)(sample);
+            }
+        }
+    }
+
+    if (!paused) feedOut(samples);
+    return n;
+}
+
+unsigned FileReplayReader::feedCsv(unsigned maxSamples)
+{
+    const qint64 start = ranges[0].first;
+    qint64 pos = start + rangePos;
+
+    // find the lines of this batch
+    lines.resize(0);
+    while (unsigned(lines.size()) < maxSamples && pos < mapSize)
+    {
+        auto nl = (const uchar*) memchr(map + pos, '\n', mapSize - pos);
+        qint64 lineEnd = nl == nullptr ? mapSize : nl - map;
+        qint64 next = nl == nullptr ? mapSize : lineEnd + 1;
+
+        if (lineEnd > pos && map[lineEnd-1] == '\r') lineEnd--;
+        if (lineEnd > pos) lines.append({pos, lineEnd}); // skip empty lines
+
+        pos = next;
+    }
+    rangePos = pos - start;
+    dataRead = rangePos;
+
+    const unsigned n = lines.size();
+    if (n == 0 || paused) return n;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    SamplePack samples(n, _numChannels);
+    for (unsigned i = 0; i < n; i++)
+    {
+        qint64 fieldStart = lines[i].first;
+        const qint64 lineEnd = lines[i].second;
+        unsigned ci = 0;
+        for (qint64 p = fieldStart; p <= lineEnd && ci < _numChannels; p++)
+        {
+            if (p == lineEnd || map[p] == csvSeparator)
+            {
+                // empty field is a missing sample
+                auto field = QByteArray::fromRawData((const char*) map + fieldStart,
+                                                     p - fieldStart);
+                bool ok;
+                double value = field.trimmed().toDouble(&ok);
+                samples.data(ci)[i] = ok ? value : nan;
+                ci++;
+                fieldStart = p + 1;
+            }
+        }
+        for (; ci < _numChannels; ci++) samples.data(ci)[i] = nan;
+    }
+
+    feedOut(samples);
+    return n;
+}
+
+void FileReplayReader::updateStatus()
+{
+    _settingsWidget.setStatus(
+        tr("%1 samples, %2 sps").arg(_samplesReplayed).arg(ingestRate(), 0, 'f', 0));
+}
+
+void FileReplayReader::onNumOfChannelsChanged(unsigned value)
+{
+    // CSV replay determines the number of channels from file
+    if (isRunning()) return;
+
+    _numChannels = value;
+    updateNumChannels();
+    emit numOfChannelsChanged(value);
+}
+
+unsigned FileReplayReader::readData()
+{
+    // intentionally empty, required by AbstractReader
+    return 0;
+}
+
+void FileReplayReader::saveSettings(QSettings* settings)
+{
+    _settingsWidget.saveSettings(settings);
+}
+
+void FileReplayReader::loadSettings(QSettings* settings)
+{
+    _settingsWidget.loadSettings(settings);
+}
@@ -0,0 +1,137 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILEREPLAYREADER_H
+#define FILEREPLAYREADER_H
+
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QPair>
+#include <QSettings>
+
+#include "abstractreader.h"
+#include "filereplayreadersettings.h"
+
+/**
+ * Replays a file as if the samples were read from the port. Used for
+ * measuring the throughput of the whole pipeline since samples can
+ * be fed much faster than a real port can deliver.
+ *
+ * File is memory mapped and decoded in batches. At maximum speed
+ * batches are fed back to back, since sinks are called synchronously
+ * this runs as fast as the stream and recorder can accept them.
+ *
+ * Reported rate is the ingest rate: reading, decoding and feeding
+ * into the stream and other sinks. Plots are redrawn by their own
+ * timer, so drawing cost only shows up indirectly as time taken away
+ * from the feed timer.
+ *
+ * Like `DemoReader`, this reader doesn't use the device.
+ */
+class FileReplayReader : public AbstractReader
+{
+    Q_OBJECT
+
+public:
+    explicit FileReplayReader(QIODevice* device, QObject* parent = 0);
+    ~FileReplayReader();
+
+    QWidget* settingsWidget();
+    unsigned numChannels() const;
+    void enable(bool enabled = true) override;
+
+    /// Opens the selected file and starts replaying
+    bool start();
+    /// Stops replaying and closes the file
+    void stop();
+    bool isRunning() const;
+
+    /// Number of samples (per channel) fed since start
+    quint64 samplesReplayed() const {return _samplesReplayed;};
+    /// Average samples per second (per channel) fed into sinks since
+    /// start, excludes plot drawing
+    double ingestRate() const;
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+signals:
+    /// Emitted when end of file is reached (and not looping)
+    void finished();
+
+private:
+    typedef FileReplayReaderSettings::Format Format;
+
+    FileReplayReaderSettings _settingsWidget;
+    unsigned _numChannels;
+
+    QFile file;
+    const uchar* map;
+    qint64 mapSize;
+    Format format;
+
+    /// Ranges of sample data in the file as (offset, size)
+    QVector<QPair<qint64, qint64>> ranges;
+    int rangeIndex;
+    qint64 rangePos;            ///< read position in current range
+    qint64 dataSize;            ///< total size of ranges
+    qint64 dataRead;            ///< bytes read from ranges
+
+    unsigned sampleSize;
+    Endianness endianness;
+    /// points to the decodeSampleAs function for selected number format
+    double (FileReplayReader::*decodeSample)(const uchar*) const;
+    template<typename T> double decodeSampleAs(const uchar* data) const;
+
+    char csvSeparator;
+    /// Line (start, end) positions of current CSV batch
+    QVector<QPair<qint64, qint64>> lines;
+
+    QTimer feedTimer;
+    QTimer statusTimer;
+    QElapsedTimer runTimer;
+    quint64 _samplesReplayed;
+    qint64 runTime;             ///< duration of last run in ns
+
+    /// Prepares `ranges` for the file format, returns false if file isn't valid
+    bool prepareRanges();
+    /// Detects separator, header and number of channels from CSV
+    bool prepareCsv();
+    void rewind();
+    bool setNumberFormat(NumberFormat nf);
+
+    /// Feeds at most `maxSamples`, returns number of samples fed
+    unsigned feedBinary(unsigned maxSamples);
+    unsigned feedCsv(unsigned maxSamples);
+    /// Copies next `size` bytes that may be split across ranges
+    void readBytes(uchar* dest, unsigned size);
+
+    unsigned readData() override;
+    void updateStatus();
+
+private slots:
+    void onFeedTimeout();
+    void onNumOfChannelsChanged(unsigned value);
+};
+
+#endif // FILEREPLAYREADER_H
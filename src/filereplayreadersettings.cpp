@@ -0,0 +1,225 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFileDialog>
+
+#include "filereplayreadersettings.h"
+#include "ui_filereplayreadersettings.h"
+
+#include "defines.h"
+#include "setting_defines.h"
+
+FileReplayReaderSettings::FileReplayReaderSettings(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::FileReplayReaderSettings)
+{
+    ui->setupUi(this);
+
+    ui->spNumOfChannels->setMaximum(MAX_NUM_CHANNELS);
+
+    // not supported by the replay reader
+    for (auto nf : {NumberFormat_uint24, NumberFormat_int24,
+                    NumberFormat_uint12p, NumberFormat_uint10p})
+    {
+        ui->nfBox->setFormatVisible(nf, false);
+    }
+
+    ui->cbFormat->addItem(tr("CSV Recording"), (int) Format::csv);
+    ui->cbFormat->addItem(tr("Binary"), (int) Format::binary);
+    ui->cbFormat->addItem(tr("Raw Capture"), (int) Format::rawCapture);
+
+    connect(ui->cbFormat, &QComboBox::currentIndexChanged,
+            this, &FileReplayReaderSettings::onFormatChanged);
+    onFormatChanged();
+
+    connect(ui->pbBrowse, &QPushButton::clicked,
+            this, &FileReplayReaderSettings::browseFile);
+
+    // Note: if directly connected we get a runtime warning on incompatible signal arguments
+    connect(ui->spNumOfChannels, &QSpinBox::valueChanged,
+            [this](int value)
+            {
+                emit numOfChannelsChanged(value);
+            });
+
+    connect(ui->pbStart, &QPushButton::clicked,
+            this, &FileReplayReaderSettings::startRequested);
+}
+
+FileReplayReaderSettings::~FileReplayReaderSettings()
+{
+    delete ui;
+}
+
+QString FileReplayReaderSettings::fileName() const
+{
+    return ui->leFileName->text();
+}
+
+FileReplayReaderSettings::Format FileReplayReaderSettings::format() const
+{
+    return static_cast<Format>(ui->cbFormat->currentData().toInt());
+}
+
+unsigned FileReplayReaderSettings::numOfChannels() const
+{
+    return ui->spNumOfChannels->value();
+}
+
+NumberFormat FileReplayReaderSettings::numberFormat() const
+{
+    return ui->nfBox->currentSelection();
+}
+
+Endianness FileReplayReaderSettings::endianness() const
+{
+    return ui->endiBox->currentSelection();
+}
+
+unsigned FileReplayReaderSettings::rate() const
+{
+    return ui->spRate->value();
+}
+
+bool FileReplayReaderSettings::loop() const
+{
+    return ui->cbLoop->isChecked();
+}
+
+void FileReplayReaderSettings::setRunning(bool running)
+{
+    ui->pbStart->setChecked(running);
+    ui->pbStart->setText(running ? tr("Stop") : tr("Start"));
+    ui->leFileName->setDisabled(running);
+    ui->pbBrowse->setDisabled(running);
+    ui->cbFormat->setDisabled(running);
+    ui->spNumOfChannels->setDisabled(running || format() == Format::csv);
+    ui->nfBox->setDisabled(running || format() == Format::csv);
+    ui->endiBox->setDisabled(running || format() == Format::csv);
+}
+
+void FileReplayReaderSettings::setStatus(QString text)
+{
+    ui->lStatus->setText(text);
+}
+
+void FileReplayReaderSettings::browseFile()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Select file to replay"), ui->leFileName->text());
+
+    if (!fileName.isEmpty())
+    {
+        ui->leFileName->setText(fileName);
+        if (fileName.endsWith(".csv", Qt::CaseInsensitive))
+        {
+            ui->cbFormat->setCurrentIndex(ui->cbFormat->findData((int) Format::csv));
+        }
+        else if (fileName.endsWith(".spraw", Qt::CaseInsensitive))
+        {
+            ui->cbFormat->setCurrentIndex(ui->cbFormat->findData((int) Format::rawCapture));
+        }
+    }
+}
+
+void FileReplayReaderSettings::onFormatChanged()
+{
+    // number of channels is detected from CSV file
+    bool isBinary = format() != Format::csv;
+    ui->spNumOfChannels->setEnabled(isBinary);
+    ui->nfBox->setEnabled(isBinary);
+    ui->endiBox->setEnabled(isBinary);
+}
+
+void FileReplayReaderSettings::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_FileReplay);
+    settings->setValue(SG_FileReplay_FileName, fileName());
+
+    QString formatStr;
+    switch (format())
+    {
+        case Format::csv:
+            formatStr = "csv";
+            break;
+        case Format::binary:
+            formatStr = "binary";
+            break;
+        case Format::rawCapture:
+            formatStr = "rawCapture";
+            break;
+    }
+    settings->setValue(SG_FileReplay_Format, formatStr);
+    settings->setValue(SG_FileReplay_NumOfChannels, numOfChannels());
+    settings->setValue(SG_FileReplay_NumberFormat, numberFormatToStr(numberFormat()));
+    settings->setValue(SG_FileReplay_Endianness,
+                       endianness() == LittleEndian ? "little" : "big");
+    settings->setValue(SG_FileReplay_Rate, rate());
+    settings->setValue(SG_FileReplay_Loop, loop());
+    settings->endGroup();
+}
+
+void FileReplayReaderSettings::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_FileReplay);
+
+    ui->leFileName->setText(
+        settings->value(SG_FileReplay_FileName, fileName()).toString());
+
+    QString formatStr = settings->value(SG_FileReplay_Format, QString()).toString();
+    Format fmt = format();
+    if (formatStr == "csv")
+    {
+        fmt = Format::csv;
+    }
+    else if (formatStr == "binary")
+    {
+        fmt = Format::binary;
+    }
+    else if (formatStr == "rawCapture")
+    {
+        fmt = Format::rawCapture;
+    }
+    ui->cbFormat->setCurrentIndex(ui->cbFormat->findData((int) fmt));
+
+    ui->spNumOfChannels->setValue(
+        settings->value(SG_FileReplay_NumOfChannels, numOfChannels()).toInt());
+
+    NumberFormat nfSetting =
+        strToNumberFormat(settings->value(SG_FileReplay_NumberFormat,
+                                          QString()).toString());
+    if (nfSetting == NumberFormat_INVALID) nfSetting = numberFormat();
+    ui->nfBox->setSelection(nfSetting);
+
+    QString endiannessSetting =
+        settings->value(SG_FileReplay_Endianness, QString()).toString();
+    if (endiannessSetting == "little")
+    {
+        ui->endiBox->setSelection(LittleEndian);
+    }
+    else if (endiannessSetting == "big")
+    {
+        ui->endiBox->setSelection(BigEndian);
+    } // else don't change
+
+    ui->spRate->setValue(settings->value(SG_FileReplay_Rate, rate()).toInt());
+    ui->cbLoop->setChecked(settings->value(SG_FileReplay_Loop, loop()).toBool());
+
+    settings->endGroup();
+}
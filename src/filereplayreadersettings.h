@@ -0,0 +1,80 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILEREPLAYREADERSETTINGS_H
+#define FILEREPLAYREADERSETTINGS_H
+
+#include <QWidget>
+#include <QSettings>
+#include <QString>
+
+#include "numberformatbox.h"
+#include "endiannessbox.h"
+
+namespace Ui {
+class FileReplayReaderSettings;
+}
+
+class FileReplayReaderSettings : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class Format
+    {
+        csv,        ///< recording of `DataRecorder`, channels are detected
+        binary,     ///< interleaved binary samples
+        rawCapture  ///< `RawCapture` file, payload is decoded as binary
+    };
+
+    explicit FileReplayReaderSettings(QWidget *parent = 0);
+    ~FileReplayReaderSettings();
+
+    QString fileName() const;
+    Format format() const;
+    unsigned numOfChannels() const;
+    NumberFormat numberFormat() const;
+    Endianness endianness() const;
+    /// Samples per second (per channel), 0 means maximum speed
+    unsigned rate() const;
+    bool loop() const;
+
+    /// Updates the start button state without signaling
+    void setRunning(bool running);
+    /// Shows replay statistics
+    void setStatus(QString text);
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+signals:
+    void numOfChannelsChanged(unsigned);
+    void startRequested(bool start);
+
+private:
+    Ui::FileReplayReaderSettings *ui;
+
+private slots:
+    void browseFile();
+    void onFormatChanged();
+};
+
+#endif // FILEREPLAYREADERSETTINGS_H
@@ -40,6 +40,9 @@ public:
     virtual double sample(unsigned i) const = 0;
     /// Returns minimum and maximum of the buffer values.
     virtual Range limits() const = 0;
+    /// Returns false if buffer is known to have no NaN samples (gaps),
+    /// see `FrameBufferCurve`.
+    virtual bool hasGaps() const {return true;};
 };
 
 /// Common base class for index and writable frame buffers
@@ -81,3 +81,41 @@ void FrameBufferSeries::setRectOfInterest(const QRectF& rect)
         int_index_end += 1;
     }
 }
+
+FrameBufferCurve::FrameBufferCurve(const QString& title) :
+    QwtPlotCurve(title)
+{
+}
+
+void FrameBufferCurve::drawSeries(QPainter* painter,
+                                  const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                                  const QRectF& canvasRect, int from, int to) const
+{
+    if (to < 0) to = dataSize() - 1;
+
+    // looking for gaps is a pass over all samples, skip it when possible
+    auto series = dynamic_cast<const FrameBufferSeries*>(data());
+    if (series != nullptr && !series->hasGaps())
+    {
+        QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, from, to);
+        return;
+    }
+
+    int start = from;
+    for (int i = from; i <= to; i++)
+    {
+        if (isnan(sample(i).y()))
+        {
+            if (i > start)
+            {
+                QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, start, i-1);
+            }
+            start = i + 1;
+        }
+    }
+
+    if (start <= to)
+    {
+        QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, start, to);
+    }
+}
@@ -23,6 +23,7 @@
 #include <QPointF>
 #include <QRectF>
 #include <qwt_series_data.h>
+#include <qwt_plot_curve.h>
 
 #include "framebuffer.h"
 
@@ -45,6 +46,9 @@ public:
     QRectF boundingRect() const;
     void setRectOfInterest(const QRectF& rect);
 
+    /// See `FrameBuffer::hasGaps()`
+    bool hasGaps() const {return _y->hasGaps();};
+
 private:
     const XFrameBuffer* _x;
     const FrameBuffer* _y;
@@ -53,4 +57,20 @@ private:
     int int_index_end;   ///< ending index of "rectangle of interest"
 };
 
+/**
+ * Curve that doesn't connect points over gaps. Gaps are marked with
+ * NaN samples (see `AbstractReader::feedGap`), each continuous run of
+ * samples is drawn separately.
+ */
+class FrameBufferCurve : public QwtPlotCurve
+{
+public:
+    explicit FrameBufferCurve(const QString& title);
+
+protected:
+    void drawSeries(QPainter* painter,
+                    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                    const QRectF& canvasRect, int from, int to) const override;
+};
+
 #endif // FRAMEBUFFERSERIES_H
@@ -21,9 +21,13 @@
 #include <QtEndian>
 
 #include "framedreader.h"
+#include "packedformat.h"
+
+#define STATS_UPDATE_INTERVAL 500 // ms
 
 FramedReader::FramedReader(QIODevice* device, QObject* parent) :
-    AbstractReader(device, parent)
+    AbstractReader(device, parent),
+    statsTimer(this)
 {
     paused = false;
 
@@ -34,9 +38,12 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     isSizeField2B = (_settingsWidget.sizeFieldType() == FramedReaderSettings::SizeFieldType::Field2Byte);
     frameSize = _settingsWidget.fixedFrameSize();
     syncWord = _settingsWidget.syncWord();
-    checksumEnabled = _settingsWidget.isChecksumEnabled();
+    checksumType = _settingsWidget.checksumType();
+    sequenceEnabled = _settingsWidget.isSequenceEnabled();
+    skippingBytes = false;
     onNumberFormatChanged(_settingsWidget.numberFormat());
     debugModeEnabled = _settingsWidget.isDebugModeEnabled();
+    bigEndian = _settingsWidget.endianness() == BigEndian;
     checkSettings();
 
     // init setting connections
@@ -53,11 +60,32 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
             this, &FramedReader::onSizeFieldChanged);
 
     connect(&_settingsWidget, &FramedReaderSettings::checksumChanged,
-            [this](bool enabled){checksumEnabled = enabled; reset();});
+            [this](ChecksumType type){checksumType = type; reset();});
 
     connect(&_settingsWidget, &FramedReaderSettings::debugModeChanged,
             [this](bool enabled){debugModeEnabled = enabled;});
 
+    connect(&_settingsWidget, &FramedReaderSettings::endiannessChanged,
+            this, [this](Endianness e){bigEndian = (e == BigEndian);});
+
+    connect(&_settingsWidget, &FramedReaderSettings::sequenceChanged,
+            [this](bool enabled)
+            {
+                sequenceEnabled = enabled;
+                stats.nextSequence = -1;
+                reset();
+            });
+
+    connect(&_settingsWidget, &FramedReaderSettings::resetStatsRequested,
+            [this]()
+            {
+                stats.clear();
+                updateStats();
+            });
+
+    statsTimer.setInterval(STATS_UPDATE_INTERVAL);
+    connect(&statsTimer, &QTimer::timeout, this, &FramedReader::updateStats);
+
     // init reader state
     reset();
 }
@@ -72,47 +100,66 @@ unsigned FramedReader::numChannels() const
     return _numChannels;
 }
 
-void FramedReader::onNumberFormatChanged(NumberFormat numberFormat)
+void FramedReader::enable(bool enabled)
+{
+    if (enabled)
+    {
+        stats.clear();
+        skippingBytes = false;
+        statsTimer.start();
+    }
+    else
+    {
+        statsTimer.stop();
+    }
+    updateStats();
+    AbstractReader::enable(enabled);
+}
+
+void FramedReader::updateStats()
+{
+    // readers of a merged source run on a worker thread, widget is
+    // only touched from the GUI thread
+    if (thread() != _settingsWidget.thread())
+    {
+        QString summary = stats.summary(sequenceEnabled);
+        QMetaObject::invokeMethod(&_settingsWidget, [this, summary]()
+            {
+                if (_settingsWidget.isVisible()) _settingsWidget.showStats(summary);
+            }, Qt::QueuedConnection);
+        return;
+    }
+
+    // no need to update if nobody is looking
+    if (!_settingsWidget.isVisible()) return;
+
+    _settingsWidget.showStats(stats.summary(sequenceEnabled));
+}
+
+void FramedReader::skipBytes(unsigned n)
 {
-    switch(numberFormat)
+    if (!n) return;
+
+    stats.bytesSkipped += n;
+    if (!skippingBytes)
     {
-        case NumberFormat_uint8:
-            sampleSize = sizeof(quint8);
-            readSample = &FramedReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            sampleSize = sizeof(qint8);
-            readSample = &FramedReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            sampleSize = sizeof(quint16);
-            readSample = &FramedReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            sampleSize = sizeof(qint16);
-            readSample = &FramedReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            sampleSize = sizeof(quint32);
-            readSample = &FramedReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            sampleSize = sizeof(qint32);
-            readSample = &FramedReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            sampleSize = sizeof(float);
-            readSample = &FramedReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            sampleSize = sizeof(double);
-            readSample = &FramedReader::readSampleAs<double>;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
+        skippingBytes = true;
+        stats.syncMisses++;
+        countSyncLoss();
     }
+}
 
+void FramedReader::sizeError(QString message)
+{
+    stats.sizeErrors++;
+    countDecodeError();
+    if (errorLog.allow()) qCritical() << message;
+}
+
+void FramedReader::onNumberFormatChanged(NumberFormat numberFormat)
+{
+    this->numberFormat = numberFormat;
+    compileDecodePlan();
     checkSettings();
     reset();
 }
@@ -130,7 +177,8 @@ void FramedReader::checkSettings()
     }
 
     // check if fixed frame size is multiple of a sample set size
-    if (!hasSizeByte && (frameSize % (_numChannels * sampleSize) != 0))
+    unsigned pSize = packageSize();
+    if (!pSize || (!hasSizeByte && (frameSize % pSize != 0)))
     {
         settingsInvalid |= FRAMESIZE_INVALID;
     }
@@ -148,7 +196,7 @@ void FramedReader::checkSettings()
     {
         QString errorMessage =
             QString("Payload size must be multiple of %1 (#channels * sample size)!")\
-            .arg(_numChannels * sampleSize);
+            .arg(pSize);
 
         _settingsWidget.showMessage(errorMessage, true);
     }
@@ -161,6 +209,7 @@ void FramedReader::checkSettings()
 void FramedReader::onNumOfChannelsChanged(unsigned value)
 {
     _numChannels = value;
+    compileDecodePlan();
     checkSettings();
     reset();
     updateNumChannels();
@@ -212,11 +261,23 @@ unsigned FramedReader::readData()
                 if (sync_i == (unsigned) syncWord.length())
                 {
                     gotSync = true;
+                    skippingBytes = false;
                 }
             }
             else
             {
                 if (debugModeEnabled) qDebug() << "Missed " << sync_i+1 << "th sync byte.";
+
+                // discard partially matched sync bytes, current byte
+                // may be the start of a new sync word
+                unsigned skipped = sync_i + 1;
+                sync_i = 0;
+                if (c == syncWord[0])
+                {
+                    sync_i = 1;
+                    skipped--;
+                }
+                skipBytes(skipped);
             }
         }
         else if (hasSizeByte && !gotSize) // skipped if fixed frame size
@@ -230,7 +291,7 @@ unsigned FramedReader::readData()
                 _device->read((char*) &frameSize16, sizeof(frameSize16));
                 numBytesRead += sizeof(frameSize16);
 
-                if (_settingsWidget.endianness() == LittleEndian)
+                if (!bigEndian)
                 {
                     frameSize = qFromLittleEndian(frameSize16);
                 }
@@ -249,14 +310,13 @@ unsigned FramedReader::readData()
             // validate the size field
             if (frameSize == 0)
             {
-                qCritical() << "Frame size is read as 0!";
+                sizeError("Frame size is read as 0!");
                 reset();
             }
-            else if (frameSize % (_numChannels * sampleSize) != 0)
+            else if (frameSize % packageSize() != 0)
             {
-                qCritical() <<
-                    QString("Payload size is not multiple of %1 (#channels * sample size)!") \
-                    .arg(_numChannels * sampleSize);
+                sizeError(QString("Payload size is not multiple of %1 (#channels * sample size)!") \
+                          .arg(packageSize()));
                 reset();
             }
             else
@@ -267,15 +327,16 @@ unsigned FramedReader::readData()
         }
         else // read data bytes
         {
-            // have enough data bytes? (+1 for checksum)
-            if (bytesAvailable < (checksumEnabled ? frameSize+1 : frameSize))
+            // have enough data bytes?
+            unsigned dataSize = frameDataSize();
+            if (bytesAvailable < dataSize)
             {
                 break;
             }
             else // read data bytes and checksum
             {
                 readFrameDataAndCheck();
-                numBytesRead += checksumEnabled ? frameSize+1 : frameSize;
+                numBytesRead += dataSize;
                 reset();
             }
         }
@@ -290,7 +351,30 @@ void FramedReader::reset()
     gotSync = false;
     gotSize = false;
     if (hasSizeByte) frameSize = 0;
-    calcChecksum = 0;
+}
+
+unsigned FramedReader::packageSize() const
+{
+    return packedSetsPerPackage(numberFormat, _numChannels) *
+        _numChannels * numberFormatBits(numberFormat) / 8;
+}
+
+void FramedReader::compileDecodePlan()
+{
+    decodePlan.clear();
+    if (isPackedFormat(numberFormat)) return;
+
+    unsigned sampleSize = numberFormatSize(numberFormat);
+    for (unsigned ci = 0; ci < _numChannels; ci++)
+    {
+        decodePlan.addField(numberFormat, ci * sampleSize, ci);
+    }
+    decodePlan.setSampleSetSize(_numChannels * sampleSize);
+}
+
+unsigned FramedReader::frameDataSize() const
+{
+    return (sequenceEnabled ? 1 : 0) + frameSize + checksumSize(checksumType);
 }
 
 // Important: this function assumes device has enough bytes to read a full frames data and checksum
@@ -299,66 +383,63 @@ void FramedReader::readFrameDataAndCheck()
     // if paused just read and waste data
     if (paused)
     {
-        _device->read(checksumEnabled ? frameSize+1 : frameSize);
+        _device->read(frameDataSize());
+        // frames skipped while paused shouldn't count as lost
+        stats.nextSequence = -1;
         return;
     }
 
-    // a package is 1 set of samples for all channels
-    unsigned numOfPackagesToRead = frameSize / (_numChannels * sampleSize);
-    SamplePack samples(numOfPackagesToRead, _numChannels);
-    for (unsigned i = 0; i < numOfPackagesToRead; i++)
+    // read the frame at once, checksum is calculated over the whole span
+    frameBuffer.resize(frameDataSize());
+    _device->read(frameBuffer.data(), frameBuffer.size());
+    const uchar* data = (const uchar*) frameBuffer.constData();
+    unsigned spanSize = frameBuffer.size() - checksumSize(checksumType);
+
+    if (checksumType != Checksum_none)
     {
-        for (unsigned int ci = 0; ci < _numChannels; ci++)
+        quint32 calcChecksum = checksum(checksumType, data, spanSize);
+        quint32 rChecksum = readChecksum(checksumType, data + spanSize, bigEndian);
+        if (calcChecksum != rChecksum)
         {
-            samples.data(ci)[i] = (this->*readSample)();
+            stats.checksumFailures++;
+            countDecodeError();
+            if (errorLog.allow())
+            {
+                qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+            }
+            return;
         }
     }
 
-    // read checksum
-    unsigned rChecksum = 0;
-    bool checksumPassed = false;
-    if (checksumEnabled)
+    quint8 sequence = 0;
+    if (sequenceEnabled)
     {
-        _device->read((char*) &rChecksum, 1);
-        calcChecksum &= 0xFF;
-        checksumPassed = (calcChecksum == rChecksum);
+        sequence = *data++;
     }
 
-    if (!checksumEnabled || checksumPassed)
+    // number of sample sets in payload
+    unsigned numSets = frameSize * 8 / (_numChannels * numberFormatBits(numberFormat));
+    SamplePack samples(numSets, _numChannels);
+    if (isPackedFormat(numberFormat))
     {
-        // commit data
-        feedOut(samples);
+        unpackToChannels(numberFormat, data, frameSize / packedGroupBytes(numberFormat),
+                         bigEndian, samples);
     }
     else
     {
-        qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+        decodePlan.decode(data, numSets, bigEndian, samples);
     }
-}
 
-template<typename T> double FramedReader::readSampleAs()
-{
-    T data;
-
-    _device->read((char*) &data, sizeof(data));
-
-    if (checksumEnabled)
-    {
-        for (unsigned i = 0; i < sizeof(data); i++)
-        {
-            calcChecksum += ((unsigned char*) &data)[i];
-        }
-    }
-
-    if (_settingsWidget.endianness() == LittleEndian)
-    {
-        data = qFromLittleEndian(data);
-    }
-    else
+    stats.framesOk++;
+    if (sequenceEnabled)
     {
-        data = qFromBigEndian(data);
+        // assume lost frames were the same size as this one
+        unsigned lost = stats.checkSequence(sequence);
+        feedGap(lost * numSets);
     }
 
-    return double(data);
+    // commit data
+    feedOut(samples);
 }
 
 void FramedReader::saveSettings(QSettings* settings)
@@ -21,9 +21,13 @@
 #define FRAMEDREADER_H
 
 #include <QSettings>
+#include <QTimer>
 
 #include "abstractreader.h"
 #include "framedreadersettings.h"
+#include "framestats.h"
+#include "checksum.h"
+#include "decodeplan.h"
 
 /**
  * Reads data in a customizable framed format.
@@ -36,6 +40,10 @@ public:
     explicit FramedReader(QIODevice* device, QObject *parent = 0);
     QWidget* settingsWidget();
     unsigned numChannels() const;
+    /// Clears statistics when enabled
+    void enable(bool enabled = true) override;
+    /// Error and loss counters
+    const FrameStats& frameStats() const {return stats;};
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -52,14 +60,16 @@ private:
     // settings related members
     FramedReaderSettings _settingsWidget;
     unsigned _numChannels;
-    unsigned sampleSize;
+    NumberFormat numberFormat;
     unsigned settingsInvalid;   /// settings are all valid if this is 0, if not no reading is done
     QByteArray syncWord;
-    bool checksumEnabled;
+    ChecksumType checksumType;
+    bool sequenceEnabled;
     bool hasSizeByte;
     bool isSizeField2B;         /// size field is 2 bytes
     unsigned frameSize;
     bool debugModeEnabled;
+    bool bigEndian;
 
     /// Checks the validity of syncWord and frameSize then shows an
     /// error message. Also updates `settingsInvalid`. If settings are
@@ -70,12 +80,29 @@ private:
     unsigned sync_i; /// sync byte index to be read next
     bool gotSync;    /// indicates if sync word is captured
     bool gotSize;    /// indicates if size is captured, ignored if size byte is disabled (fixed size)
-    unsigned calcChecksum;
+    QByteArray frameBuffer; /// sequence, payload and checksum of the frame being read
+    bool skippingBytes; /// bytes are being skipped to find sync
+
+    FrameStats stats;
+    LogRateLimiter errorLog;
+    QTimer statsTimer;
+
+    /// Counts bytes that are discarded while searching for sync
+    void skipBytes(unsigned n);
+    /// Counts and logs an invalid size field
+    void sizeError(QString message);
+    void updateStats();
 
     void reset();    /// Resets the reading state. Used in case of error or setting change.
-    /// points to the readSampleAs function for currently selected number format
-    double (FramedReader::*readSample)();
-    template<typename T> double readSampleAs();
+    /// Size of the frame after size field (sequence + payload + checksum)
+    unsigned frameDataSize() const;
+    /// Payload size must be a multiple of this; size of a sample set,
+    /// for packed formats enough sets to fill whole groups
+    unsigned packageSize() const;
+    /// used for byte aligned formats
+    DecodePlan decodePlan;
+    /// Rebuilds `decodePlan` after a change in number format or channels
+    void compileDecodePlan();
     /// reads payload portion of the frame, calculates checksum and commits data
     /// @note should be called only if there are enough bytes on device
     void readFrameDataAndCheck();
@@ -33,15 +33,26 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
     ui->leSyncWord->setText("AA BB");
     ui->spNumOfChannels->setMaximum(MAX_NUM_CHANNELS);
 
-    connect(ui->cbChecksum, &QCheckBox::toggled,
-            [this](bool enabled)
+    ui->cbChecksum->addItem(tr("None"), (int) Checksum_none);
+    ui->cbChecksum->addItem(tr("Sum (8 bit)"), (int) Checksum_sum8);
+    ui->cbChecksum->addItem(tr("CRC-16/CCITT"), (int) Checksum_crc16);
+    ui->cbChecksum->addItem(tr("CRC-32"), (int) Checksum_crc32);
+
+    connect(ui->cbChecksum, &QComboBox::currentIndexChanged,
+            [this]()
             {
-                emit checksumChanged(enabled);
+                emit checksumChanged(checksumType());
             });
 
     connect(ui->cbDebugMode, &QCheckBox::toggled,
             this, &FramedReaderSettings::debugModeChanged);
 
+    connect(ui->cbSequence, &QCheckBox::toggled,
+            this, &FramedReaderSettings::sequenceChanged);
+
+    connect(ui->pbResetStats, &QPushButton::clicked,
+            this, &FramedReaderSettings::resetStatsRequested);
+
     {
         // add frame size selection buttons to the same fbGroup
         // fbGroup = new QButtonGroup(this);
@@ -86,6 +97,9 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
 
     connect(ui->nfBox, SIGNAL(selectionChanged(NumberFormat)),
             this, SIGNAL(numberFormatChanged(NumberFormat)));
+
+    connect(ui->endiBox, &EndiannessBox::selectionChanged,
+            this, &FramedReaderSettings::endiannessChanged);
 }
 
 FramedReaderSettings::~FramedReaderSettings()
@@ -152,9 +166,19 @@ unsigned FramedReaderSettings::fixedFrameSize() const
     return ui->spSize->value();
 }
 
-bool FramedReaderSettings::isChecksumEnabled()
+ChecksumType FramedReaderSettings::checksumType() const
+{
+    return static_cast<ChecksumType>(ui->cbChecksum->currentData().toInt());
+}
+
+bool FramedReaderSettings::isSequenceEnabled()
 {
-    return ui->cbChecksum->isChecked();
+    return ui->cbSequence->isChecked();
+}
+
+void FramedReaderSettings::showStats(QString stats)
+{
+    ui->lStats->setText(stats);
 }
 
 bool FramedReaderSettings::isDebugModeEnabled()
@@ -185,8 +209,9 @@ void FramedReaderSettings::saveSettings(QSettings* settings)
     }
     settings->setValue(SG_CustomFrame_SizeFieldType, sizeFieldStr);
     settings->setValue(SG_CustomFrame_FixedFrameSize, fixedFrameSize());
-    settings->setValue(SG_CustomFrame_Checksum, ui->cbChecksum->isChecked());
+    settings->setValue(SG_CustomFrame_Checksum, checksumTypeToStr(checksumType()));
     settings->setValue(SG_CustomFrame_DebugMode, ui->cbDebugMode->isChecked());
+    settings->setValue(SG_CustomFrame_Sequence, ui->cbSequence->isChecked());
     settings->endGroup();
 }
 
@@ -247,12 +272,20 @@ void FramedReaderSettings::loadSettings(QSettings* settings)
     } // ignore invalid value
 
     // load checksum
-    ui->cbChecksum->setChecked(
-        settings->value(SG_CustomFrame_Checksum, ui->cbChecksum->isChecked()).toBool());
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_CustomFrame_Checksum, QString()).toString());
+    if (csSetting != Checksum_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(ui->cbChecksum->findData((int) csSetting));
+    }
 
     // load debug mode
     ui->cbDebugMode->setChecked(
         settings->value(SG_CustomFrame_DebugMode, ui->cbDebugMode->isChecked()).toBool());
 
+    // load sequence number
+    ui->cbSequence->setChecked(
+        settings->value(SG_CustomFrame_Sequence, ui->cbSequence->isChecked()).toBool());
+
     settings->endGroup();
 }
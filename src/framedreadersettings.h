@@ -27,6 +27,7 @@
 
 #include "numberformatbox.h"
 #include "endiannessbox.h"
+#include "checksum.h"
 
 namespace Ui {
 class FramedReaderSettings;
@@ -46,6 +47,8 @@ public:
     ~FramedReaderSettings();
 
     void showMessage(QString message, bool error = false);
+    /// Displays frame statistics
+    void showStats(QString stats);
 
     unsigned numOfChannels();
     NumberFormat numberFormat();
@@ -53,7 +56,8 @@ public:
     QByteArray syncWord();
     SizeFieldType sizeFieldType() const;
     unsigned fixedFrameSize() const;
-    bool isChecksumEnabled();
+    ChecksumType checksumType() const;
+    bool isSequenceEnabled();
     bool isDebugModeEnabled();
     /// Save settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -68,8 +72,12 @@ signals:
     void sizeFieldChanged(SizeFieldType type, unsigned size);
     /// `0` indicates frame size byte is enabled
     void fixedFrameSizeChanged(unsigned);
-    void checksumChanged(bool);
+    void checksumChanged(ChecksumType);
+    void sequenceChanged(bool);
+    /// Reset button for statistics is clicked
+    void resetStatsRequested();
     void numOfChannelsChanged(unsigned);
+    void endiannessChanged(Endianness);
     void numberFormatChanged(NumberFormat);
     void debugModeChanged(bool);
 
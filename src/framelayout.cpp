@@ -0,0 +1,114 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QMap>
+#include <QStringList>
+
+#include "defines.h"
+#include "framelayout.h"
+
+static const QMap<QString, NumberFormat> shortNames({
+        {"u8", NumberFormat_uint8},
+        {"i8", NumberFormat_int8},
+        {"u16", NumberFormat_uint16},
+        {"i16", NumberFormat_int16},
+        {"u24", NumberFormat_uint24},
+        {"i24", NumberFormat_int24},
+        {"u32", NumberFormat_uint32},
+        {"i32", NumberFormat_int32},
+        {"f32", NumberFormat_float},
+        {"f64", NumberFormat_double}
+    });
+
+FrameLayout::FrameLayout()
+{
+    _size = 0;
+}
+
+bool FrameLayout::parse(QString text, QString* error)
+{
+    QVector<FrameField> fields;
+    unsigned offset = 0;
+
+    auto fail = [error](QString message)
+    {
+        if (error != nullptr) *error = message;
+        return false;
+    };
+
+    for (auto token : text.split(',', Qt::SkipEmptyParts))
+    {
+        token = token.trimmed().toLower();
+
+        // optional repeat count
+        unsigned count = 1;
+        int star = token.indexOf('*');
+        if (star >= 0)
+        {
+            bool ok;
+            count = token.left(star).trimmed().toUInt(&ok);
+            if (!ok || count == 0) return fail(QString("Invalid repeat count: %1").arg(token));
+            token = token.mid(star + 1).trimmed();
+        }
+
+        if (token.startsWith("pad"))
+        {
+            unsigned padSize = 1;
+            if (token.size() > 3)
+            {
+                bool ok;
+                padSize = token.mid(3).toUInt(&ok);
+                if (!ok || padSize == 0) return fail(QString("Invalid pad size: %1").arg(token));
+            }
+            offset += count * padSize;
+            continue;
+        }
+
+        NumberFormat nf = shortNames.value(token, strToNumberFormat(token));
+        if (nf == NumberFormat_INVALID || nf == NumberFormat_pad || isPackedFormat(nf))
+        {
+            return fail(QString("Unknown field type: %1").arg(token));
+        }
+
+        for (unsigned i = 0; i < count; i++)
+        {
+            fields.append({nf, offset});
+            offset += numberFormatSize(nf);
+        }
+    }
+
+    if (fields.isEmpty()) return fail("Layout has no channels!");
+    if ((unsigned) fields.size() > MAX_NUM_CHANNELS)
+    {
+        return fail(QString("Layout has more than %1 channels!").arg(MAX_NUM_CHANNELS));
+    }
+
+    _text = text;
+    _fields = fields;
+    _size = offset;
+
+    plan.clear();
+    for (int ci = 0; ci < fields.size(); ci++)
+    {
+        plan.addField(fields[ci].format, fields[ci].offset, ci);
+    }
+    plan.setSampleSetSize(_size);
+
+    return true;
+}
@@ -0,0 +1,87 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMELAYOUT_H
+#define FRAMELAYOUT_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "numberformat.h"
+#include "samplepack.h"
+#include "decodeplan.h"
+
+/// A channel field in the payload of a frame
+struct FrameField
+{
+    NumberFormat format;
+    unsigned offset;    ///< from the start of the sample set
+};
+
+/**
+ * Describes how a sample set in the payload maps to channels.
+ *
+ * Written as a comma separated list of fields, ex: "u16,u16,f32,pad2".
+ * Fields are number format names (uint8, int16, float etc.) or their
+ * short forms (u8, i16, i24, f32, f64). Packed formats aren't allowed. `padN` skips N bytes. A field can
+ * be repeated with a count prefix, ex: "8*i16". Each field other
+ * than pad is a channel.
+ */
+class FrameLayout
+{
+public:
+    FrameLayout();
+
+    /**
+     * Parses the layout text. Layout isn't changed if text is
+     * invalid.
+     *
+     * @param error set to a description of the error if not `nullptr`
+     * @return `false` if text is invalid
+     */
+    bool parse(QString text, QString* error = nullptr);
+
+    /// Layout text, as given to `parse`
+    QString text() const {return _text;};
+    unsigned numChannels() const {return _fields.size();};
+    /// Size of a sample set in bytes, including padding
+    unsigned size() const {return _size;};
+    const QVector<FrameField>& fields() const {return _fields;};
+
+    /**
+     * Decodes `numSets` consecutive sample sets at `data` into
+     * `samples` starting from sample `index` and channel
+     * `firstChannel`. `data` must have at least `numSets * size()`
+     * bytes.
+     */
+    void decode(const uchar* data, unsigned numSets, bool bigEndian, SamplePack& samples,
+                unsigned index, unsigned firstChannel = 0) const
+    {
+        plan.decode(data, numSets, bigEndian, samples, index, firstChannel);
+    };
+
+private:
+    QString _text;
+    QVector<FrameField> _fields;
+    unsigned _size;
+    DecodePlan plan;
+};
+
+#endif // FRAMELAYOUT_H
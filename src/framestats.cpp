@@ -0,0 +1,68 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtDebug>
+
+#include "framestats.h"
+
+unsigned FrameStats::checkSequence(quint8 seq)
+{
+    unsigned lost = 0;
+    if (nextSequence >= 0 && seq != nextSequence)
+    {
+        lost = quint8(seq - nextSequence);
+        framesLost += lost;
+    }
+    nextSequence = quint8(seq + 1);
+    return lost;
+}
+
+QString FrameStats::summary(bool showLost) const
+{
+    QString str = QString("OK: %1  Checksum: %2  Size: %3  Sync lost: %4 (%5 bytes skipped)")
+        .arg(framesOk).arg(checksumFailures).arg(sizeErrors)
+        .arg(syncMisses).arg(bytesSkipped);
+
+    if (showLost) str += QString("  Lost: %1").arg(framesLost);
+
+    return str;
+}
+
+LogRateLimiter::LogRateLimiter(int intervalMs)
+{
+    _interval = intervalMs;
+    suppressed = 0;
+}
+
+bool LogRateLimiter::allow()
+{
+    if (timer.isValid() && !timer.hasExpired(_interval))
+    {
+        suppressed++;
+        return false;
+    }
+
+    if (suppressed)
+    {
+        qWarning() << suppressed << "similar messages were suppressed";
+        suppressed = 0;
+    }
+    timer.start();
+    return true;
+}
@@ -0,0 +1,75 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+/// Error and loss counters of a framed reader
+struct FrameStats
+{
+    quint64 framesOk = 0;
+    quint64 syncMisses = 0;       ///< times sync was lost and bytes had to be skipped
+    quint64 bytesSkipped = 0;     ///< bytes discarded while searching for sync
+    quint64 checksumFailures = 0;
+    quint64 sizeErrors = 0;       ///< invalid size field or malformed frame
+    quint64 framesLost = 0;       ///< detected from sequence number gaps
+
+    /// Expected value of next sequence number, -1 if unknown
+    int nextSequence = -1;
+
+    void clear() {*this = FrameStats();};
+
+    /**
+     * Checks received sequence number and counts lost frames. Only
+     * frames that are received intact should be checked. Sequence
+     * number is 1 byte and wraps around.
+     *
+     * @return number of frames lost since the last checked frame
+     */
+    unsigned checkSequence(quint8 seq);
+
+    /// One line summary for display
+    QString summary(bool showLost) const;
+};
+
+/**
+ * Limits the number of log messages at high rates where logging
+ * itself becomes the bottleneck. At most one message is allowed per
+ * interval; when a message is allowed number of suppressed messages
+ * since the previous one is logged as well.
+ */
+class LogRateLimiter
+{
+public:
+    explicit LogRateLimiter(int intervalMs = 1000);
+
+    /// Returns true if message can be logged now
+    bool allow();
+
+private:
+    int _interval;
+    QElapsedTimer timer;
+    unsigned suppressed;
+};
+
+#endif // FRAMESTATS_H
@@ -0,0 +1,250 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <csignal>
+#include <QtDebug>
+
+#include "headlessrunner.h"
+#include "commandline.h"
+#include "setting_defines.h"
+
+/// Interval of checking for termination signals (ms)
+#define SIGNAL_CHECK_INTERVAL 200
+
+/// Set by the signal handler, checked in event loop
+static volatile std::sig_atomic_t quitSignal = 0;
+
+static void onQuitSignal(int sig)
+{
+    quitSignal = sig;
+}
+
+HeadlessRunner::HeadlessRunner(QObject* parent) :
+    QObject(parent),
+    portControl(&serialPort, &nativePort, &tcpSocket, &udpDevice),
+    dataFormatPanel(&serialPort)
+{
+    running = false;
+    header = true;
+    separator = ",";
+    timestampOpt = DataRecorder::TimestampOption::disabled;
+    checkpointInterval = 0;
+    samples = 0;
+    totalSamples = 0;
+    lastBytesRead = 0;
+
+    dataFormatPanel.setPerfCounters(&perfCounters);
+    nativePort.setPerfCounters(&perfCounters);
+    udpDevice.setPerfCounters(&perfCounters);
+    stream.setPerfCounters(&perfCounters);
+
+    connect(&portControl, &PortControl::portToggled,
+            this, &HeadlessRunner::onPortToggled);
+    connect(&dataFormatPanel, &DataFormatPanel::sourceChanged,
+            this, &HeadlessRunner::onSourceChanged);
+    onSourceChanged(dataFormatPanel.activeSource());
+
+    connect(&statsTimer, &QTimer::timeout, this, &HeadlessRunner::logStats);
+    signalTimer.setInterval(SIGNAL_CHECK_INTERVAL);
+    connect(&signalTimer, &QTimer::timeout, this, &HeadlessRunner::checkSignals);
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    stop();
+}
+
+bool HeadlessRunner::start(const QCoreApplication& app)
+{
+    CommandLine cmdLine;
+    cmdLine.process(app);
+
+    if (!cmdLine.isSet(cmdLine.recordOpt))
+    {
+        qCritical() << "Headless mode needs a recording file, see --record option.";
+        return false;
+    }
+
+    bool ok;
+    unsigned statsInterval = cmdLine.value(cmdLine.statsOpt).toUInt(&ok);
+    if (!ok)
+    {
+        qCritical() << "Invalid stats interval:" << cmdLine.value(cmdLine.statsOpt);
+        return false;
+    }
+
+    // same order as the GUI: default settings first, then config file
+    QSettings settings(PROGRAM_NAME, PROGRAM_NAME);
+    loadSettings(&settings);
+    cmdLine.loadConfig([this](QSettings* s){loadSettings(s);});
+    cmdLine.applyPortOptions(&portControl);
+
+    portControl.openPort();
+    if (!portControl.isOpen())
+    {
+        qCritical() << "Headless mode couldn't open the port.";
+        return false;
+    }
+
+    QStringList channelNames;
+    if (header) channelNames = stream.infoModel()->channelNames();
+
+    QString fileName = cmdLine.value(cmdLine.recordOpt);
+    recorder.setCheckpointInterval(checkpointInterval);
+    if (!recorder.startRecording(fileName, separator, channelNames, timestampOpt))
+    {
+        return false;
+    }
+    stream.connectFollower(&recorder);
+    stream.connectFollower(this);
+    running = true;
+
+    std::signal(SIGINT, onQuitSignal);
+    std::signal(SIGTERM, onQuitSignal);
+    signalTimer.start();
+
+    statsElapsed.start();
+    lastBytesRead = dataFormatPanel.bytesRead();
+    perfCounters.takeRates(); // reset
+    if (statsInterval)
+    {
+        statsTimer.start(statsInterval * 1000);
+    }
+
+    qInfo() << "Recording to" << fileName;
+    return true;
+}
+
+void HeadlessRunner::stop()
+{
+    if (!running) return;
+    running = false;
+
+    stream.disconnectFollower(&recorder);
+    recorder.stopRecording();
+    if (portControl.isOpen()) portControl.device()->close();
+}
+
+void HeadlessRunner::loadSettings(QSettings* settings)
+{
+    portControl.loadSettings(settings);
+    dataFormatPanel.loadSettings(settings);
+    stream.loadSettings(settings);
+    loadRecordSettings(settings);
+}
+
+void HeadlessRunner::loadRecordSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Record);
+    header = settings->value(SG_Record_Header, header).toBool();
+    separator = settings->value(SG_Record_Separator, separator).toString();
+    separator.replace("\\t", "\t");
+    recorder.disableBuffering =
+        settings->value(SG_Record_DisableBuffering, recorder.disableBuffering).toBool();
+    if (settings->contains(SG_Record_Decimals))
+    {
+        recorder.setDecimals(settings->value(SG_Record_Decimals).toUInt());
+    }
+
+    if (settings->value(SG_Record_Checkpoint, checkpointInterval > 0).toBool())
+    {
+        checkpointInterval = settings->value(SG_Record_CheckpointInterval, 1000).toUInt();
+    }
+    else
+    {
+        checkpointInterval = 0;
+    }
+
+    // see `RecordPanel::loadSettings`
+    if (settings->value(SG_Record_Timestamp,
+                        timestampOpt != DataRecorder::TimestampOption::disabled).toBool())
+    {
+        QString tsFormatStr = settings->value(SG_Record_TimestampFormat, "").toString();
+        if (tsFormatStr == "seconds_with_precision")
+        {
+            timestampOpt = DataRecorder::TimestampOption::seconds_precision;
+        }
+        else if (tsFormatStr == "milliseconds")
+        {
+            timestampOpt = DataRecorder::TimestampOption::milliseconds;
+        }
+        else
+        {
+            timestampOpt = DataRecorder::TimestampOption::seconds;
+        }
+    }
+    else
+    {
+        timestampOpt = DataRecorder::TimestampOption::disabled;
+    }
+    settings->endGroup();
+}
+
+void HeadlessRunner::onSourceChanged(Source* source)
+{
+    source->connectSink(&stream);
+}
+
+void HeadlessRunner::onPortToggled(bool open)
+{
+    dataFormatPanel.setDevice(portControl.device());
+
+    if (!open && running)
+    {
+        qCritical() << "Port is closed, stopping.";
+        stop();
+        QCoreApplication::exit(1);
+    }
+}
+
+void HeadlessRunner::feedIn(const SamplePack& data)
+{
+    samples += data.numSamples();
+    totalSamples += data.numSamples();
+
+    Sink::feedIn(data);
+}
+
+void HeadlessRunner::logStats()
+{
+    double secs = statsElapsed.restart() / 1000.;
+    if (secs <= 0) return;
+
+    quint64 bytesRead = dataFormatPanel.bytesRead();
+    auto rates = perfCounters.takeRates();
+
+    qInfo().noquote() << QString("%1 sps, %2 B/s, reader cpu %3%, %4 decode errors, %5 samples recorded")
+        .arg(samples / secs, 0, 'f', 1)
+        .arg((bytesRead - lastBytesRead) / secs, 0, 'f', 0)
+        .arg(rates.readerCpu * 100, 0, 'f', 1)
+        .arg(rates.decodeErrors)
+        .arg(totalSamples);
+
+    samples = 0;
+    lastBytesRead = bytesRead;
+}
+
+void HeadlessRunner::checkSignals()
+{
+    if (!quitSignal) return;
+
+    qInfo() << "Received signal" << int(quitSignal) << ", stopping.";
+    stop();
+    QCoreApplication::quit();
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QObject>
+#include <QSerialPort>
+#include <QSettings>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "portcontrol.h"
+#include "nativeserialport.h"
+#include "udpdevice.h"
+#include "dataformatpanel.h"
+#include "stream.h"
+#include "datarecorder.h"
+#include "perfcounters.h"
+#include "sink.h"
+
+/**
+ * Runs acquisition and recording without the main window and plots.
+ *
+ * Only the port, readers, `Stream` and `DataRecorder` are created.
+ * Port and data format settings are still kept by their panels (the
+ * readers keep their settings in widgets) but they are never shown,
+ * so the application can run with the "offscreen" platform. Stream
+ * buffer is kept at its minimum since there is nothing to plot.
+ *
+ * Throughput is logged periodically. Application quits on SIGINT or
+ * SIGTERM after closing the recording, or when the port is closed.
+ */
+class HeadlessRunner : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit HeadlessRunner(QObject* parent = 0);
+    ~HeadlessRunner();
+
+    /// Loads settings, opens the port and starts recording. Returns
+    /// false on error, application should exit.
+    bool start(const QCoreApplication& app);
+
+protected:
+    void feedIn(const SamplePack& data) override;
+
+private:
+    QSerialPort serialPort;
+    NativeSerialPort nativePort;
+    QTcpSocket tcpSocket;
+    UdpDevice udpDevice;
+    PortControl portControl;
+    DataFormatPanel dataFormatPanel;
+    Stream stream;
+    DataRecorder recorder;
+    PerfCounters perfCounters;
+
+    // recording options, loaded from "Record" settings
+    QString separator;
+    bool header;
+    DataRecorder::TimestampOption timestampOpt;
+    unsigned checkpointInterval;
+
+    bool running;
+    QTimer statsTimer;
+    QTimer signalTimer;
+    QElapsedTimer statsElapsed;
+    quint64 samples;            ///< samples per channel since last stats
+    quint64 totalSamples;
+    quint64 lastBytesRead;
+
+    void loadSettings(QSettings* settings);
+    void loadRecordSettings(QSettings* settings);
+    void stop();
+
+private slots:
+    void onSourceChanged(Source* source);
+    void onPortToggled(bool open);
+    void logStats();
+    /// Checks if a termination signal is received
+    void checkSignals();
+};
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,198 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <QFile>
+#include <QTextStream>
+#include <QtAlgorithms>
+#include <QtDebug>
+
+#include "latencytracer.h"
+
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+void LatencyHistogram::clear()
+{
+    memset(buckets, 0, sizeof(buckets));
+    _count = 0;
+    sum = 0;
+    _max = 0;
+}
+
+int LatencyHistogram::bucketIndex(qint64 ns)
+{
+    if (ns < SubBuckets) return ns > 0 ? ns : 0;
+
+    // position of highest bit and next 2 bits below it
+    int msb = 63 - qCountLeadingZeroBits(quint64(ns));
+    int sub = (ns >> (msb - 2)) & (SubBuckets - 1);
+    return std::min((msb - 1) * SubBuckets + sub, NumBuckets - 1);
+}
+
+qint64 LatencyHistogram::bucketLowerBound(int i)
+{
+    if (i < SubBuckets) return i;
+
+    int msb = i / SubBuckets + 1;
+    int sub = i % SubBuckets;
+    return (qint64(SubBuckets + sub)) << (msb - 2);
+}
+
+void LatencyHistogram::add(qint64 ns)
+{
+    buckets[bucketIndex(ns)]++;
+    _count++;
+    sum += ns;
+    if (ns > _max) _max = ns;
+}
+
+double LatencyHistogram::mean() const
+{
+    return _count ? sum / _count : 0;
+}
+
+qint64 LatencyHistogram::percentile(double p) const
+{
+    if (!_count) return 0;
+
+    quint64 target = std::ceil(p * _count);
+    if (target < 1) target = 1;
+
+    quint64 seen = 0;
+    for (int i = 0; i < NumBuckets; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+        {
+            qint64 upper = i + 1 < NumBuckets ? bucketLowerBound(i + 1) : _max;
+            return std::min(upper, _max);
+        }
+    }
+    return _max;
+}
+
+LatencyTracer::LatencyTracer()
+{
+    _enabled = false;
+    pendingArrival = 0;
+    pendingStored = 0;
+}
+
+qint64 LatencyTracer::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+QString LatencyTracer::stageName(Stage stage)
+{
+    switch (stage)
+    {
+        case ReadToDecode: return "read→decode";
+        case DecodeToStore: return "decode→store";
+        case StoreToPaint: return "store→paint";
+        case Total: return "total";
+        default: return QString();
+    }
+}
+
+void LatencyTracer::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+    pendingArrival = 0;
+}
+
+void LatencyTracer::record(Stage stage, qint64 ns)
+{
+    if (!_enabled) return;
+    histograms[stage].add(ns);
+}
+
+void LatencyTracer::markStored(qint64 arrival, qint64 storedAt)
+{
+    if (!_enabled || pendingArrival) return;
+
+    pendingArrival = arrival;
+    pendingStored = storedAt;
+}
+
+void LatencyTracer::markPainted()
+{
+    if (!_enabled || !pendingArrival) return;
+
+    qint64 t = now();
+    histograms[StoreToPaint].add(t - pendingStored);
+    histograms[Total].add(t - pendingArrival);
+    pendingArrival = 0;
+}
+
+const LatencyHistogram& LatencyTracer::histogram(Stage stage) const
+{
+    return histograms[stage];
+}
+
+void LatencyTracer::reset()
+{
+    for (auto& h : histograms) h.clear();
+    pendingArrival = 0;
+}
+
+bool LatencyTracer::dump(QString fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qCritical() << "Couldn't open file for writing latency histograms:"
+                    << fileName << ":" << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "stage,count,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n";
+    for (int s = 0; s < StageCount; s++)
+    {
+        auto& h = histograms[s];
+        out << stageName(Stage(s)) << ',' << h.count() << ','
+            << qint64(h.mean()) << ',' << h.percentile(0.5) << ','
+            << h.percentile(0.9) << ',' << h.percentile(0.99) << ','
+            << h.max() << '\n';
+    }
+
+    out << "\nstage,lower_ns,upper_ns,count\n";
+    for (int s = 0; s < StageCount; s++)
+    {
+        auto& h = histograms[s];
+        for (int i = 0; i < LatencyHistogram::NumBuckets; i++)
+        {
+            if (!h.bucketCount(i)) continue;
+            out << stageName(Stage(s)) << ','
+                << LatencyHistogram::bucketLowerBound(i) << ','
+                << LatencyHistogram::bucketLowerBound(i + 1) << ','
+                << h.bucketCount(i) << '\n';
+        }
+    }
+
+    return out.status() == QTextStream::Ok;
+}
@@ -0,0 +1,119 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LATENCYTRACER_H
+#define LATENCYTRACER_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * Histogram of durations with logarithmic buckets. Each power of two
+ * is divided into `SubBuckets`, so percentiles are accurate within
+ * ~19%, which is enough for telling 1ms from 10ms.
+ */
+class LatencyHistogram
+{
+public:
+    static const int SubBuckets = 4;
+    static const int NumBuckets = 64 * SubBuckets;
+
+    LatencyHistogram();
+
+    void add(qint64 ns);
+    void clear();
+
+    quint64 count() const {return _count;};
+    qint64 max() const {return _max;};
+    double mean() const;
+    /// Returns upper bound of the bucket that contains `p` (0-1) percentile
+    qint64 percentile(double p) const;
+
+    quint64 bucketCount(int i) const {return buckets[i];};
+    /// Lower limit of a bucket in ns, upper limit is lower limit of next one
+    static qint64 bucketLowerBound(int i);
+    static int bucketIndex(qint64 ns);
+
+private:
+    quint64 buckets[NumBuckets];
+    quint64 _count;
+    double sum;
+    qint64 _max;
+};
+
+/**
+ * Measures how old the data is when it is shown on the plot.
+ *
+ * Each batch of bytes is timestamped at `AbstractReader::onDataReady`,
+ * the timestamp travels in the `SamplePack` and each stage records
+ * its latency relative to previous one:
+ *
+ *   - read→decode: bytes arrived → reader feeds the samples
+ *   - decode→store: samples fed → `Stream` stores them in buffers
+ *   - store→paint: stored → plot canvas is painted
+ *   - total: bytes arrived → plot canvas is painted
+ *
+ * For store→paint the oldest unpainted batch is used, data that
+ * arrives between two paints is shown with the same paint.
+ *
+ * All stages run in the GUI thread, so there is no locking.
+ */
+class LatencyTracer
+{
+public:
+    enum Stage
+    {
+        ReadToDecode = 0,
+        DecodeToStore,
+        StoreToPaint,
+        Total,
+        StageCount              // MUST be last
+    };
+
+    LatencyTracer();
+
+    /// Current monotonic time in ns
+    static qint64 now();
+    static QString stageName(Stage stage);
+
+    bool isEnabled() const {return _enabled;};
+    void setEnabled(bool enabled);
+
+    void record(Stage stage, qint64 ns);
+    /// Called when a batch that arrived at `arrival` is stored
+    void markStored(qint64 arrival, qint64 storedAt);
+    /// Called after plot is painted, records pending batch if any
+    void markPainted();
+
+    const LatencyHistogram& histogram(Stage stage) const;
+    /// Clears all histograms
+    void reset();
+
+    /// Writes a summary and all buckets to a CSV file
+    bool dump(QString fileName) const;
+
+private:
+    bool _enabled;
+    LatencyHistogram histograms[StageCount];
+
+    qint64 pendingArrival;     ///< arrival of oldest unpainted batch, 0 if none
+    qint64 pendingStored;
+};
+
+#endif // LATENCYTRACER_H
@@ -0,0 +1,170 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "liveexportpanel.h"
+#include "ui_liveexportpanel.h"
+
+#include <QtDebug>
+
+#include "setting_defines.h"
+
+/// Status labels update interval (ms)
+#define STATUS_INTERVAL 1000
+
+LiveExportPanel::LiveExportPanel(Stream* stream, QWidget* parent) :
+    QWidget(parent),
+    ui(new Ui::LiveExportPanel),
+    shmExport(stream->infoModel(), this),
+    socketExport(stream->infoModel(), this)
+{
+    ui->setupUi(this);
+    _stream = stream;
+
+    if (!ShmExport::isSupported())
+    {
+        ui->gbShm->setEnabled(false);
+        ui->lShmStatus->setText(tr("Not supported on this platform"));
+    }
+    connect(ui->gbShm, &QGroupBox::toggled, this, &LiveExportPanel::enableShm);
+    connect(ui->gbSocket, &QGroupBox::toggled, this, &LiveExportPanel::enableSocket);
+    connect(ui->spSocketQueue, &QSpinBox::valueChanged, this, [this](int value)
+            {
+                socketExport.setMaxQueueSize(value * 1024);
+            });
+    socketExport.setMaxQueueSize(ui->spSocketQueue->value() * 1024);
+
+    statusTimer.setInterval(STATUS_INTERVAL);
+    connect(&statusTimer, &QTimer::timeout, this, &LiveExportPanel::updateStatus);
+    statusTimer.start();
+}
+
+LiveExportPanel::~LiveExportPanel()
+{
+    enableShm(false);
+    enableSocket(false);
+    delete ui;
+}
+
+void LiveExportPanel::enableShm(bool enabled)
+{
+    if (enabled == shmExport.isRunning()) return;
+
+    if (enabled)
+    {
+        if (!shmExport.start(ui->leShmName->text().trimmed(),
+                             ui->spShmCapacity->value()))
+        {
+            ui->gbShm->setChecked(false);
+            return;
+        }
+        _stream->connectFollower(&shmExport);
+    }
+    else
+    {
+        _stream->disconnectFollower(&shmExport);
+        shmExport.stop();
+    }
+
+    // can't be changed while segment exists
+    ui->leShmName->setEnabled(!enabled);
+    ui->spShmCapacity->setEnabled(!enabled);
+    updateStatus();
+}
+
+void LiveExportPanel::enableSocket(bool enabled)
+{
+    if (enabled == socketExport.isRunning()) return;
+
+    if (enabled)
+    {
+        if (!socketExport.start(ui->leSocketName->text().trimmed()))
+        {
+            ui->gbSocket->setChecked(false);
+            return;
+        }
+        _stream->connectFollower(&socketExport);
+    }
+    else
+    {
+        _stream->disconnectFollower(&socketExport);
+        socketExport.stop();
+    }
+
+    ui->leSocketName->setEnabled(!enabled);
+    updateStatus();
+}
+
+void LiveExportPanel::updateStatus()
+{
+    if (socketExport.isRunning())
+    {
+        ui->lSocketStatus->setText(
+            tr("%1\n%2 clients, %3 batches dropped")
+            .arg(socketExport.fullServerName())
+            .arg(socketExport.numClients())
+            .arg(socketExport.droppedMessages()));
+    }
+    else
+    {
+        ui->lSocketStatus->setText("-");
+    }
+
+    if (shmExport.isRunning())
+    {
+        ui->lShmStatus->setText(tr("%1 samples written").arg(shmExport.samplesWritten()));
+    }
+    else if (ShmExport::isSupported())
+    {
+        ui->lShmStatus->setText("-");
+    }
+}
+
+void LiveExportPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_LiveExport);
+    settings->setValue(SG_LiveExport_Shm, ui->gbShm->isChecked());
+    settings->setValue(SG_LiveExport_ShmName, ui->leShmName->text());
+    settings->setValue(SG_LiveExport_ShmCapacity, ui->spShmCapacity->value());
+    settings->setValue(SG_LiveExport_Socket, ui->gbSocket->isChecked());
+    settings->setValue(SG_LiveExport_SocketName, ui->leSocketName->text());
+    settings->setValue(SG_LiveExport_SocketQueue, ui->spSocketQueue->value());
+    settings->endGroup();
+}
+
+void LiveExportPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_LiveExport);
+    // stop before changing the name
+    bool shm = settings->value(SG_LiveExport_Shm, ui->gbShm->isChecked()).toBool();
+    ui->gbShm->setChecked(false);
+    ui->leShmName->setText(
+        settings->value(SG_LiveExport_ShmName, ui->leShmName->text()).toString());
+    ui->spShmCapacity->setValue(
+        settings->value(SG_LiveExport_ShmCapacity, ui->spShmCapacity->value()).toInt());
+    ui->gbShm->setChecked(shm && ShmExport::isSupported());
+
+    bool socket = settings->value(SG_LiveExport_Socket, ui->gbSocket->isChecked()).toBool();
+    ui->gbSocket->setChecked(false);
+    ui->leSocketName->setText(
+        settings->value(SG_LiveExport_SocketName, ui->leSocketName->text()).toString());
+    ui->spSocketQueue->setValue(
+        settings->value(SG_LiveExport_SocketQueue, ui->spSocketQueue->value()).toInt());
+    ui->gbSocket->setChecked(socket);
+    settings->endGroup();
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIVEEXPORTPANEL_H
+#define LIVEEXPORTPANEL_H
+
+#include <QWidget>
+#include <QSettings>
+#include <QTimer>
+
+#include "stream.h"
+#include "shmexport.h"
+#include "localsocketexport.h"
+
+namespace Ui {
+class LiveExportPanel;
+}
+
+/// Controls exporting live (decoded) data to other local programs
+class LiveExportPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LiveExportPanel(Stream* stream, QWidget* parent = 0);
+    ~LiveExportPanel();
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+private:
+    Ui::LiveExportPanel *ui;
+    Stream* _stream;
+    ShmExport shmExport;
+    LocalSocketExport socketExport;
+    QTimer statusTimer;
+
+    /// Starts or stops shared memory export
+    void enableShm(bool enabled);
+    /// Starts or stops local socket server
+    void enableSocket(bool enabled);
+    void updateStatus();
+};
+
+#endif // LIVEEXPORTPANEL_H
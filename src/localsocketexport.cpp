@@ -0,0 +1,264 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QtDebug>
+
+#include "localsocketexport.h"
+#include "channelinfomodel.h"
+
+/// Default maximum size of a client send queue (bytes)
+#define DEFAULT_MAX_QUEUE_SIZE (4 * 1024 * 1024)
+/// Messages are passed to the socket until this many bytes are pending
+#define SOCKET_HIGH_WATER (256 * 1024)
+
+/// Appends the bytes of a value to `buffer`
+template<typename T>
+static void appendValue(QByteArray& buffer, T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+LocalSocketExport::LocalSocketExport(const ChannelInfoModel* infoModel, QObject* parent) :
+    QObject(parent)
+{
+    this->infoModel = infoModel;
+    maxQueueSize = DEFAULT_MAX_QUEUE_SIZE;
+    numChannels = 0;
+    sequence = 0;
+    _droppedMessages = 0;
+
+    // only the same user can connect
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+
+    connect(&server, &QLocalServer::newConnection,
+            this, &LocalSocketExport::onNewConnection);
+    connect(infoModel, &QAbstractItemModel::dataChanged,
+            this, &LocalSocketExport::sendChannels);
+    connect(infoModel, &QAbstractItemModel::modelReset,
+            this, &LocalSocketExport::sendChannels);
+}
+
+LocalSocketExport::~LocalSocketExport()
+{
+    stop();
+}
+
+bool LocalSocketExport::start(QString name)
+{
+    if (isRunning()) stop();
+
+    // a stale socket file may be left from a crash
+    QLocalServer::removeServer(name);
+    if (!server.listen(name))
+    {
+        qCritical() << "Can't listen on local socket" << name << ":" << server.errorString();
+        return false;
+    }
+
+    sequence = 0;
+    _droppedMessages = 0;
+    return true;
+}
+
+void LocalSocketExport::stop()
+{
+    // aborting emits `disconnected`, so take the list first
+    auto oldClients = clients;
+    clients.clear();
+    for (auto& client : oldClients)
+    {
+        client.socket->disconnect(this);
+        client.socket->abort();
+        client.socket->deleteLater();
+    }
+
+    server.close();
+}
+
+void LocalSocketExport::setMaxQueueSize(unsigned bytes)
+{
+    maxQueueSize = bytes;
+}
+
+QByteArray LocalSocketExport::makeMessage(LocalExportMessage type, const QByteArray& payload)
+{
+    QByteArray message;
+    message.reserve(2 * sizeof(quint32) + payload.size());
+    appendValue<quint32>(message, sizeof(quint32) + payload.size());
+    appendValue<quint32>(message, type);
+    message.append(payload);
+    return message;
+}
+
+QByteArray LocalSocketExport::channelsMessage() const
+{
+    QByteArray payload;
+    appendValue<quint32>(payload, numChannels);
+    for (unsigned ci = 0; ci < numChannels; ci++)
+    {
+        QByteArray name;
+        if (ci < unsigned(infoModel->rowCount())) name = infoModel->name(ci).toUtf8();
+        appendValue<quint32>(payload, name.size());
+        payload.append(name);
+    }
+    return makeMessage(LocalExport_Channels, payload);
+}
+
+void LocalSocketExport::onNewConnection()
+{
+    while (QLocalSocket* socket = server.nextPendingConnection())
+    {
+        connect(socket, &QLocalSocket::bytesWritten,
+                this, &LocalSocketExport::onBytesWritten);
+        // a failed write in `flush` disconnects synchronously, while
+        // `feedIn` and `sendChannels` are iterating over `clients`
+        connect(socket, &QLocalSocket::disconnected,
+                this, &LocalSocketExport::onDisconnected, Qt::QueuedConnection);
+
+        clients.append({socket, {}, 0});
+        enqueue(clients.last(), channelsMessage(), false);
+        flush(clients.last());
+    }
+}
+
+void LocalSocketExport::onDisconnected()
+{
+    auto socket = static_cast<QLocalSocket*>(sender());
+    int i = findClient(socket);
+    if (i >= 0) clients.removeAt(i);
+    socket->deleteLater();
+}
+
+void LocalSocketExport::onBytesWritten()
+{
+    int i = findClient(static_cast<QLocalSocket*>(sender()));
+    if (i >= 0) flush(clients[i]);
+}
+
+int LocalSocketExport::findClient(QLocalSocket* socket) const
+{
+    for (int i = 0; i < clients.size(); i++)
+    {
+        if (clients[i].socket == socket) return i;
+    }
+    return -1;
+}
+
+void LocalSocketExport::enqueue(Client& client, const QByteArray& data, bool droppable)
+{
+    client.queue.append({data, droppable});
+    client.queuedBytes += data.size();
+
+    // drop oldest samples, channel messages are always delivered
+    for (int i = 0; client.queuedBytes > maxQueueSize && i < client.queue.size();)
+    {
+        if (client.queue[i].droppable)
+        {
+            client.queuedBytes -= client.queue[i].data.size();
+            client.queue.removeAt(i);
+            _droppedMessages++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void LocalSocketExport::flush(Client& client)
+{
+    // disconnected, waiting to be removed by `onDisconnected`
+    if (client.socket->state() != QLocalSocket::ConnectedState)
+    {
+        client.queue.clear();
+        client.queuedBytes = 0;
+        return;
+    }
+
+    while (!client.queue.isEmpty() &&
+           client.socket->bytesToWrite() < SOCKET_HIGH_WATER)
+    {
+        Message message = client.queue.takeFirst();
+        client.queuedBytes -= message.data.size();
+        if (client.socket->write(message.data) < 0)
+        {
+            // socket reports the error and disconnects by itself
+            qWarning() << "Local socket write failed:" << client.socket->errorString();
+            client.queue.clear();
+            client.queuedBytes = 0;
+            return;
+        }
+    }
+    // don't wait for the event loop, pass as much as possible to the kernel
+    client.socket->flush();
+}
+
+void LocalSocketExport::sendChannels()
+{
+    if (clients.isEmpty()) return;
+
+    QByteArray message = channelsMessage();
+    for (auto& client : clients)
+    {
+        enqueue(client, message, false);
+        flush(client);
+    }
+}
+
+void LocalSocketExport::setNumChannels(unsigned nc, bool x)
+{
+    numChannels = nc;
+    sendChannels();
+
+    Sink::setNumChannels(nc, x);
+}
+
+void LocalSocketExport::feedIn(const SamplePack& data)
+{
+    unsigned ns = data.numSamples();
+    if (!clients.isEmpty())
+    {
+        unsigned nc = data.numChannels();
+
+        // built once, shared (implicitly) by all client queues
+        QByteArray payload;
+        payload.reserve(2 * sizeof(quint64) + 2 * sizeof(quint32) +
+                        nc * ns * sizeof(double));
+        appendValue<quint64>(payload, sequence);
+        appendValue<qint64>(payload, data.timestamp());
+        appendValue<quint32>(payload, nc);
+        appendValue<quint32>(payload, ns);
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            payload.append(reinterpret_cast<const char*>(data.data(ci)),
+                           ns * sizeof(double));
+        }
+
+        QByteArray message = makeMessage(LocalExport_Samples, payload);
+        for (auto& client : clients)
+        {
+            enqueue(client, message, true);
+            flush(client);
+        }
+    }
+    sequence += ns;
+
+    Sink::feedIn(data);
+}
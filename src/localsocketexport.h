@@ -0,0 +1,137 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOCALSOCKETEXPORT_H
+#define LOCALSOCKETEXPORT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QString>
+
+#include "sink.h"
+
+class ChannelInfoModel;
+
+/// Message types of local socket export protocol
+enum LocalExportMessage : quint32
+{
+    LocalExport_Channels = 1,
+    LocalExport_Samples = 2
+};
+
+/**
+ * A `Sink` that streams incoming samples to clients connected to a
+ * local socket (a Unix domain socket, or a named pipe on Windows).
+ * Should be connected as a follower of `Stream` to get calibrated
+ * samples.
+ *
+ * Every message starts with a `quint32` payload size (not including
+ * itself) and a `quint32` message type. All values are in host byte
+ * order.
+ *
+ * - `LocalExport_Channels` is sent when a client connects and when
+ *   channels change: `quint32` number of channels, and for each
+ *   channel a `quint32` length followed by UTF-8 name.
+ *
+ * - `LocalExport_Samples`: `quint64` sequence number of the first
+ *   sample, `qint64` arrival timestamp (monotonic ns, 0 if unknown),
+ *   `quint32` number of channels, `quint32` number of samples and
+ *   then samples as `double`, channel after channel.
+ *
+ * Each client has its own send queue. When a client can't keep up,
+ * oldest sample messages in its queue are dropped so that `feedIn`
+ * never blocks. Clients can detect dropped samples from the gaps in
+ * sequence numbers.
+ */
+class LocalSocketExport : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit LocalSocketExport(const ChannelInfoModel* infoModel, QObject* parent = 0);
+    ~LocalSocketExport();
+
+    /**
+     * Starts listening for clients. A stale socket left with the same
+     * name is removed.
+     *
+     * @param name server name, ex: "serialplot"
+     * @return false on error
+     */
+    bool start(QString name);
+    /// Disconnects all clients and stops listening
+    void stop();
+    bool isRunning() const {return server.isListening();};
+    /// Full path of the socket, empty if not running
+    QString fullServerName() const {return server.fullServerName();};
+
+    /// Maximum bytes queued per client before dropping old samples
+    void setMaxQueueSize(unsigned bytes);
+
+    unsigned numClients() const {return clients.size();};
+    /// Total number of sample messages dropped for all clients
+    quint64 droppedMessages() const {return _droppedMessages;};
+
+protected:
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    struct Message
+    {
+        QByteArray data;
+        bool droppable;
+    };
+
+    struct Client
+    {
+        QLocalSocket* socket;
+        QList<Message> queue;
+        qint64 queuedBytes;
+    };
+
+    const ChannelInfoModel* infoModel;
+    QLocalServer server;
+    QList<Client> clients;
+    unsigned maxQueueSize;
+    unsigned numChannels;
+    quint64 sequence;           ///< sequence number of the next sample
+    quint64 _droppedMessages;
+
+    /// Creates a message with given type and payload
+    static QByteArray makeMessage(LocalExportMessage type, const QByteArray& payload);
+    QByteArray channelsMessage() const;
+    /// Appends a message to the queue of a client, dropping old samples if full
+    void enqueue(Client& client, const QByteArray& data, bool droppable);
+    /// Writes queued messages while socket isn't too backed up
+    void flush(Client& client);
+    int findClient(QLocalSocket* socket) const;
+
+private slots:
+    void onNewConnection();
+    void onBytesWritten();
+    void onDisconnected();
+    /// Sends channel names to all clients
+    void sendChannels();
+};
+
+#endif // LOCALSOCKETEXPORT_H
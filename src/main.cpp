@@ -23,6 +23,8 @@
 #include <iostream>
 
 #include "mainwindow.h"
+#include "headlessrunner.h"
+#include "commandline.h"
 #include "tooltipfilter.h"
 #include "version.h"
 
@@ -68,8 +70,37 @@ void messageHandler(QtMsgType type, const QMessageLogContext &context,
     }
 }
 
+/// Runs without main window, see `HeadlessRunner`
+int runHeadless(int argc, char *argv[])
+{
+    // readers keep their settings in widgets so a `QApplication` is
+    // still needed, but nothing is shown and no display is required
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+    QApplication::setApplicationName(PROGRAM_NAME);
+    QApplication::setApplicationVersion(VERSION_STRING);
+    qInstallMessageHandler(messageHandler);
+
+    qDebug() << "SerialPlot" << VERSION_STRING << "(headless)";
+    qDebug() << "Revision" << VERSION_REVISION;
+
+    HeadlessRunner runner;
+    if (!runner.start(a)) return 1;
+
+    return a.exec();
+}
+
 int main(int argc, char *argv[])
 {
+    if (CommandLine::isHeadless(argc, argv))
+    {
+        return runHeadless(argc, argv);
+    }
+
     QApplication a(argc, argv);
     QApplication::setApplicationName(PROGRAM_NAME);
     QApplication::setApplicationVersion(VERSION_STRING);
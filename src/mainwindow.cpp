@@ -29,18 +29,18 @@
 #include <QDesktopServices>
 #include <QMap>
 #include <QtDebug>
-#include <QCommandLineParser>
-#include <QFileInfo>
+#include <QInputDialog>
+#include <QThread>
 #include <qwt_plot.h>
 #include <limits.h>
 #include <cmath>
 #include <iostream>
-#include <cstdlib>
 
 #include <plot.h>
 #include <barplot.h>
 
 #include "framebufferseries.h"
+#include "commandline.h"
 #include "defines.h"
 #include "version.h"
 #include "setting_defines.h"
@@ -58,24 +58,29 @@ const QMap<int, QString> panelSettingMap({
         {3, "Commands"},
         {4, "Record"},
         {5, "TextView"},
-        {6, "Log"}
+        {6, "Diagnostics"},
+        {7, "MultiPort"},
+        {8, "LiveExport"},
+        {9, "Log"}
     });
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow),
     aboutDialog(this),
-    portControl(&serialPort),
+    portControl(&serialPort, &nativePort, &tcpSocket, &udpDevice),
     secondaryPlot(NULL),
     snapshotMan(this, &stream),
     commandPanel(&serialPort),
     dataFormatPanel(&serialPort),
     recordPanel(&stream),
     textView(&stream),
+    liveExportPanel(&stream),
     updateCheckDialog(this),
     bpsLabel(&portControl, &dataFormatPanel, this)
 {
     ui->setupUi(this);
+    replayDevice = nullptr;
 
     plotMan = new PlotManager(ui->plotArea, &plotMenu, &stream);
 
@@ -85,6 +90,9 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->tabWidget->insertTab(3, &commandPanel, "Commands");
     ui->tabWidget->insertTab(4, &recordPanel, "Record");
     ui->tabWidget->insertTab(5, &textView, "Text View");
+    ui->tabWidget->insertTab(6, &diagnosticsPanel, "Diagnostics");
+    ui->tabWidget->insertTab(7, &multiPortPanel, "Multi Port");
+    ui->tabWidget->insertTab(8, &liveExportPanel, "Live Export");
     ui->tabWidget->setCurrentIndex(0);
     auto tbPortControl = portControl.toolBar();
     addToolBar(tbPortControl);
@@ -152,6 +160,9 @@ MainWindow::MainWindow(QWidget *parent) :
     QObject::connect(ui->actionExportSvg, &QAction::triggered,
                      this, &MainWindow::onExportSvg);
 
+    QObject::connect(ui->actionReplayCapture, &QAction::toggled,
+                     this, &MainWindow::onReplayCapture);
+
     QObject::connect(ui->actionSaveSettings, &QAction::triggered,
                      this, &MainWindow::onSaveSettings);
 
@@ -205,10 +216,12 @@ MainWindow::MainWindow(QWidget *parent) :
                          if (enabled && !recordPanel.recordPaused())
                          {
                              dataFormatPanel.pause(true);
+                             multiPortPanel.pause(true);
                          }
                          else
                          {
                              dataFormatPanel.pause(false);
+                             multiPortPanel.pause(false);
                          }
                      });
 
@@ -218,11 +231,32 @@ MainWindow::MainWindow(QWidget *parent) :
                          if (ui->actionPause->isChecked() && enabled)
                          {
                              dataFormatPanel.pause(false);
+                             multiPortPanel.pause(false);
                          }
                      });
 
     connect(&serialPort, &QIODevice::aboutToClose,
             &recordPanel, &RecordPanel::onPortClose);
+    connect(&nativePort, &QIODevice::aboutToClose,
+            &recordPanel, &RecordPanel::onPortClose);
+    connect(&tcpSocket, &QIODevice::aboutToClose,
+            &recordPanel, &RecordPanel::onPortClose);
+    connect(&udpDevice, &QIODevice::aboutToClose,
+            &recordPanel, &RecordPanel::onPortClose);
+
+    dataFormatPanel.setRawCapture(recordPanel.rawCapture());
+
+    // init latency tracing
+    dataFormatPanel.setLatencyTracer(diagnosticsPanel.latencyTracer());
+    stream.setLatencyTracer(diagnosticsPanel.latencyTracer());
+    plotMan->setLatencyTracer(diagnosticsPanel.latencyTracer());
+
+    // init performance counters
+    dataFormatPanel.setPerfCounters(diagnosticsPanel.perfCounters());
+    nativePort.setPerfCounters(diagnosticsPanel.perfCounters());
+    udpDevice.setPerfCounters(diagnosticsPanel.perfCounters());
+    stream.setPerfCounters(diagnosticsPanel.perfCounters());
+    plotMan->setPerfCounters(diagnosticsPanel.perfCounters());
 
     // init plot
     numOfSamples = plotControlPanel.numOfSamples();
@@ -240,6 +274,9 @@ MainWindow::MainWindow(QWidget *parent) :
     plotMan->setNumOfSamples(numOfSamples);
     plotMan->setPlotWidth(plotControlPanel.plotWidth());
 
+    // performance summary, hidden unless enabled from diagnostics panel
+    ui->statusBar->addPermanentWidget(diagnosticsPanel.statusLabel());
+
     // init bps (bits per second) counter
     ui->statusBar->addPermanentWidget(&bpsLabel);
 
@@ -266,10 +303,13 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(&dataFormatPanel, &DataFormatPanel::sourceChanged,
             this, &MainWindow::onSourceChanged);
     onSourceChanged(dataFormatPanel.activeSource());
+    connect(&multiPortPanel, &MultiPortPanel::runningChanged,
+            this, &MainWindow::onMultiPortToggled);
 
     // load default settings
     QSettings settings(PROGRAM_NAME, PROGRAM_NAME);
     loadAllSettings(&settings);
+    recordPanel.recoverInterruptedRecording();
 
     handleCommandLineOptions(*QApplication::instance());
 
@@ -291,9 +331,10 @@ MainWindow::MainWindow(QWidget *parent) :
 
 MainWindow::~MainWindow()
 {
-    if (serialPort.isOpen())
+    if (portControl.isOpen())
     {
         serialPort.close();
+        nativePort.close();
     }
 
     delete plotMan;
@@ -377,6 +418,14 @@ void MainWindow::onPortToggled(bool open)
     if (open && isDemoRunning()) enableDemo(false);
     ui->actionDemoMode->setEnabled(!open);
 
+    // replay can't run together with the port
+    if (open) ui->actionReplayCapture->setChecked(false);
+    ui->actionReplayCapture->setEnabled(!open);
+
+    // native backend is a different device
+    dataFormatPanel.setDevice(portControl.device());
+    commandPanel.setPort(portControl.device());
+
     if (!open)
     {
         spsLabel.setText("0sps");
@@ -385,6 +434,9 @@ void MainWindow::onPortToggled(bool open)
 
 void MainWindow::onSourceChanged(Source* source)
 {
+    // multi port acquisition keeps the stream until it's stopped
+    if (multiPortPanel.isRunning() && source != multiPortPanel.source()) return;
+
     source->connectSink(&stream);
     source->connectSink(&sampleCounter);
 }
@@ -408,6 +460,20 @@ void MainWindow::onSpsChanged(float sps)
     spsLabel.setText(QString::number(sps, 'f', precision) + "sps");
 }
 
+void MainWindow::onMultiPortToggled(bool running)
+{
+    if (running)
+    {
+        if (isDemoRunning()) enableDemo(false);
+        onSourceChanged(multiPortPanel.source());
+    }
+    else
+    {
+        onSourceChanged(dataFormatPanel.activeSource());
+    }
+    ui->actionDemoMode->setEnabled(!running && !portControl.isOpen());
+}
+
 bool MainWindow::isDemoRunning()
 {
     return ui->actionDemoMode->isChecked();
@@ -417,7 +483,7 @@ void MainWindow::enableDemo(bool enabled)
 {
     if (enabled)
     {
-        if (!serialPort.isOpen())
+        if (!portControl.isOpen())
         {
             dataFormatPanel.enableDemo(true);
         }
@@ -475,6 +541,69 @@ void MainWindow::showBarPlot(bool show)
     }
 }
 
+void MainWindow::onReplayCapture(bool start)
+{
+    if (!start)
+    {
+        if (replayDevice != nullptr)
+        {
+            dataFormatPanel.setDevice(portControl.device());
+            // we may be called from `finished` signal of the device
+            replayDevice->deleteLater();
+            replayDevice = nullptr;
+        }
+        ui->actionDemoMode->setEnabled(!portControl.isOpen());
+        return;
+    }
+
+    if (portControl.isOpen() || isDemoRunning())
+    {
+        qWarning() << "Close the port and stop the demo before replaying a capture.";
+        ui->actionReplayCapture->setChecked(false);
+        return;
+    }
+
+    QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Replay Raw Capture"), QString(),
+        tr("Raw Captures (*.spraw);;All Files (*)"));
+
+    if (fileName.isNull())  // user canceled
+    {
+        ui->actionReplayCapture->setChecked(false);
+        return;
+    }
+
+    QStringList speeds = {tr("Original speed"), tr("Maximum speed")};
+    bool ok;
+    QString speed = QInputDialog::getItem(this, tr("Replay Raw Capture"),
+                                          tr("Replay speed:"), speeds, 0, false, &ok);
+    if (!ok)
+    {
+        ui->actionReplayCapture->setChecked(false);
+        return;
+    }
+
+    replayDevice = new CaptureReplayDevice(this);
+    if (!replayDevice->openCapture(fileName))
+    {
+        delete replayDevice;
+        replayDevice = nullptr;
+        ui->actionReplayCapture->setChecked(false);
+        return;
+    }
+    replayDevice->setSpeed(speed == speeds[0] ? 1. : 0.);
+
+    connect(replayDevice, &CaptureReplayDevice::finished, [this]()
+            {
+                qDebug() << "Replay finished:" << replayDevice->bytesReplayed() << "bytes";
+                ui->actionReplayCapture->setChecked(false);
+            });
+
+    ui->actionDemoMode->setEnabled(false);
+    dataFormatPanel.setDevice(replayDevice);
+    replayDevice->start();
+}
+
 void MainWindow::onExportCsv()
 {
     bool wasPaused = ui->actionPause->isChecked();
@@ -521,6 +650,16 @@ void MainWindow::messageHandler(QtMsgType type,
                                 const QString &logString,
                                 const QString &msg)
 {
+    // readers of multi port acquisition log from their own threads
+    if (QThread::currentThread() != thread())
+    {
+        QMetaObject::invokeMethod(this, [this, type, logString, msg]()
+                                  {
+                                      messageHandler(type, logString, msg);
+                                  }, Qt::QueuedConnection);
+        return;
+    }
+
     if (ui != NULL)
         ui->ptLog->appendPlainText(logString);
 
@@ -541,6 +680,9 @@ void MainWindow::saveAllSettings(QSettings* settings)
     commandPanel.saveSettings(settings);
     recordPanel.saveSettings(settings);
     textView.saveSettings(settings);
+    diagnosticsPanel.saveSettings(settings);
+    multiPortPanel.saveSettings(settings);
+    liveExportPanel.saveSettings(settings);
     updateCheckDialog.saveSettings(settings);
 }
 
@@ -555,6 +697,9 @@ void MainWindow::loadAllSettings(QSettings* settings)
     commandPanel.loadSettings(settings);
     recordPanel.loadSettings(settings);
     textView.loadSettings(settings);
+    diagnosticsPanel.loadSettings(settings);
+    multiPortPanel.loadSettings(settings);
+    liveExportPanel.loadSettings(settings);
     updateCheckDialog.loadSettings(settings);
 }
 
@@ -635,53 +780,8 @@ void MainWindow::onLoadSettings()
 
 void MainWindow::handleCommandLineOptions(const QCoreApplication &app)
 {
-    QCommandLineParser parser;
-    parser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsCompactedShortOptions);
-    parser.setApplicationDescription("Small and simple software for plotting data from serial port in realtime.");
-    parser.addHelpOption();
-    parser.addVersionOption();
-
-    QCommandLineOption configOpt({"c", "config"}, "Load configuration from file.", "filename");
-    QCommandLineOption portOpt({"p", "port"}, "Set port name.", "port name");
-    QCommandLineOption baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate");
-    QCommandLineOption openPortOpt({"o", "open"}, "Open serial port.");
-
-    parser.addOption(configOpt);
-    parser.addOption(portOpt);
-    parser.addOption(baudrateOpt);
-    parser.addOption(openPortOpt);
-
-    parser.process(app);
-
-    if (parser.isSet(configOpt))
-    {
-        QString fileName = parser.value(configOpt);
-        QFileInfo fileInfo(fileName);
-
-        if (fileInfo.exists() && fileInfo.isFile())
-        {
-            QSettings settings(fileName, QSettings::IniFormat);
-            loadAllSettings(&settings);
-        }
-        else
-        {
-            qCritical() << "Configuration file not exist. Closing application.";
-            std::exit(1);
-        }
-    }
-
-    if (parser.isSet(portOpt))
-    {
-        portControl.selectPort(parser.value(portOpt));
-    }
-
-    if (parser.isSet(baudrateOpt))
-    {
-        portControl.selectBaudrate(parser.value(baudrateOpt));
-    }
-
-    if (parser.isSet(openPortOpt))
-    {
-        portControl.openPort();
-    }
+    CommandLine cmdLine;
+    cmdLine.process(app);
+    cmdLine.loadConfig([this](QSettings* settings){loadAllSettings(settings);});
+    cmdLine.applyPortOptions(&portControl);
 }
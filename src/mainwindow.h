@@ -32,9 +32,12 @@
 #include <QColor>
 #include <QtGlobal>
 #include <QSettings>
+#include <QTcpSocket>
 #include <qwt_plot_curve.h>
 
 #include "portcontrol.h"
+#include "nativeserialport.h"
+#include "udpdevice.h"
 #include "commandpanel.h"
 #include "dataformatpanel.h"
 #include "plotcontrolpanel.h"
@@ -48,6 +51,10 @@
 #include "samplecounter.h"
 #include "datatextview.h"
 #include "bpslabel.h"
+#include "capturereplaydevice.h"
+#include "diagnosticspanel.h"
+#include "multiportpanel.h"
+#include "liveexportpanel.h"
 
 namespace Ui {
 class MainWindow;
@@ -72,6 +79,9 @@ private:
     void setupAboutDialog();
 
     QSerialPort serialPort;
+    NativeSerialPort nativePort;
+    QTcpSocket tcpSocket;
+    UdpDevice udpDevice;
     PortControl portControl;
 
     unsigned int numOfSamples;
@@ -91,8 +101,13 @@ private:
     PlotControlPanel plotControlPanel;
     PlotMenu plotMenu;
     DataTextView textView;
+    DiagnosticsPanel diagnosticsPanel;
+    MultiPortPanel multiPortPanel;
+    LiveExportPanel liveExportPanel;
     UpdateCheckDialog updateCheckDialog;
     BPSLabel bpsLabel;
+    /// Only exists while replaying a raw capture
+    CaptureReplayDevice* replayDevice;
 
     void handleCommandLineOptions(const QCoreApplication &app);
 
@@ -118,12 +133,14 @@ private:
 private slots:
     void onPortToggled(bool open);
     void onSourceChanged(Source* source);
+    void onMultiPortToggled(bool running);
     void onNumOfSamplesChanged(int value);
 
     void clearPlot();
     void onSpsChanged(float sps);
     void enableDemo(bool enabled);
     void showBarPlot(bool show);
+    void onReplayCapture(bool start);
 
     void onExportCsv();
     void onExportSvg();
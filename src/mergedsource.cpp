@@ -0,0 +1,180 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtDebug>
+
+#include "mergedsource.h"
+#include "latencytracer.h"
+
+/// Interval of moving data from workers to sinks (ms)
+#define MERGE_INTERVAL 10
+/// With arrival time alignment, a port that is silent longer than
+/// this (ns) is held at its last value instead of stalling others
+#define MAX_ARRIVAL_SKEW (100 * 1000 * 1000)
+/// A port that hasn't sent anything for this long (ns) no longer
+/// holds back others, regardless of alignment
+#define MAX_SILENCE (1000 * 1000 * 1000)
+
+MergedSource::MergedSource(QObject* parent) :
+    QObject(parent)
+{
+    alignment = ArrivalTime;
+    paused = false;
+    startTime = 0;
+    lastDropped = 0;
+
+    mergeTimer.setInterval(MERGE_INTERVAL);
+    mergeTimer.setTimerType(Qt::PreciseTimer);
+    connect(&mergeTimer, &QTimer::timeout, this, &MergedSource::merge);
+}
+
+MergedSource::~MergedSource()
+{
+    stop();
+}
+
+unsigned MergedSource::numChannels() const
+{
+    return aligner.numChannels();
+}
+
+void MergedSource::setPorts(const QList<PortWorker::Config>& ports, Alignment alignment)
+{
+    Q_ASSERT(!isRunning());
+
+    configs = ports;
+    this->alignment = alignment;
+
+    portChannels.clear();
+    for (auto& config : configs) portChannels.append(config.reader->numChannels());
+    aligner.setPorts(portChannels);
+    updateNumChannels();
+}
+
+void MergedSource::start()
+{
+    if (isRunning() || configs.isEmpty()) return;
+
+    aligner.clear();
+    startTime = LatencyTracer::now();
+    lastDropped = 0;
+    for (int i = 0; i < configs.size(); i++)
+    {
+        auto config = configs[i];
+        if (alignment == ArrivalTime) config.timeChannel = -1;
+
+        auto worker = new PortWorker(config, portChannels[i]);
+        auto thread = new QThread(this);
+
+        // reader runs on the worker thread until `PortWorker::stop`
+        auto reader = config.reader;
+        reader->enable(true);
+        reader->pause(false);
+        reader->connectSink(worker);
+        reader->moveToThread(thread);
+        worker->moveToThread(thread);
+        connect(thread, &QThread::started, worker, &PortWorker::start);
+        connect(worker, &PortWorker::errorOccurred, this, &MergedSource::errorOccurred);
+        thread->setObjectName(config.portName);
+        thread->start(QThread::TimeCriticalPriority);
+
+        workers.append(worker);
+        threads.append(thread);
+    }
+    mergeTimer.start();
+}
+
+void MergedSource::stop()
+{
+    if (!isRunning()) return;
+
+    mergeTimer.stop();
+    for (int i = 0; i < workers.size(); i++)
+    {
+        QMetaObject::invokeMethod(workers[i], "stop", Qt::BlockingQueuedConnection);
+        threads[i]->quit();
+        threads[i]->wait();
+        // reader is back on this thread, also disconnects the worker
+        workers[i]->config().reader->enable(false);
+        delete workers[i];      // also frees the packs left in queue
+        delete threads[i];
+    }
+    workers.clear();
+    threads.clear();
+    aligner.clear();
+}
+
+quint64 MergedSource::bytesRead() const
+{
+    quint64 total = 0;
+    for (auto worker : workers) total += worker->bytesRead();
+    return total;
+}
+
+quint64 MergedSource::dropped() const
+{
+    quint64 total = 0;
+    for (auto worker : workers) total += worker->dropped();
+    return total + aligner.dropped();
+}
+
+void MergedSource::pause(bool enabled)
+{
+    paused = enabled;
+}
+
+void MergedSource::merge()
+{
+    for (int i = 0; i < workers.size(); i++)
+    {
+        SamplePack* samples;
+        auto& queue = workers[i]->queue();
+        while (queue.pop(samples))
+        {
+            aligner.push(i, *samples);
+            delete samples;
+        }
+    }
+
+    qint64 now = LatencyTracer::now();
+    double minWatermark = alignment == ArrivalTime ?
+        double(now - MAX_ARRIVAL_SKEW) :
+        -std::numeric_limits<double>::infinity();
+    // give all ports a chance to send their first samples
+    qint64 staleBefore = now - startTime > MAX_SILENCE ? now - MAX_SILENCE : 0;
+
+    while (SamplePack* samples = aligner.take(minWatermark, staleBefore))
+    {
+        // device timestamps aren't monotonic clock times
+        if (alignment == DeviceTime) samples->setTimestamp(0);
+        if (!paused) feedOut(*samples);
+        delete samples;
+    }
+
+    // ex: reference port is silent while others keep sending
+    if (aligner.dropped() != lastDropped)
+    {
+        if (dropLog.allow())
+        {
+            qWarning() << "Merging dropped" << aligner.dropped() - lastDropped
+                       << "samples, a port isn't keeping up with others";
+        }
+        lastDropped = aligner.dropped();
+    }
+}
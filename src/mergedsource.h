@@ -0,0 +1,109 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MERGEDSOURCE_H
+#define MERGEDSOURCE_H
+
+#include <QObject>
+#include <QList>
+#include <QThread>
+#include <QTimer>
+
+#include "source.h"
+#include "portworker.h"
+#include "samplealigner.h"
+#include "framestats.h"
+
+/**
+ * Acquires from several serial ports at the same time and merges
+ * them into a single source. Channels of ports are placed one after
+ * another.
+ *
+ * Each port is read and decoded by a `PortWorker` on its own thread,
+ * using the reader given in its configuration. Workers hand decoded
+ * packs over lock-free single producer queues,
+ * merging (see `SampleAligner`) runs in the main thread at a fixed
+ * interval, so workers never wait for each other or for the GUI.
+ */
+class MergedSource : public QObject, public Source
+{
+    Q_OBJECT
+
+public:
+    enum Alignment
+    {
+        /// Align by arrival time of bytes, devices don't need to
+        /// send timestamps but alignment is limited by port latency
+        ArrivalTime,
+        /// Align by a timestamp channel sent by each device, clocks
+        /// of devices should be synchronized
+        DeviceTime
+    };
+
+    explicit MergedSource(QObject* parent = 0);
+    ~MergedSource();
+
+    bool hasX() const override {return false;};
+    unsigned numChannels() const override;
+
+    /**
+     * Sets the ports to acquire from, first port is the
+     * reference. Should be called when stopped. Number of channels
+     * of each port is taken from its reader.
+     */
+    void setPorts(const QList<PortWorker::Config>& ports, Alignment alignment);
+
+    /// Opens all ports and starts acquisition
+    void start();
+    /// Closes all ports
+    void stop();
+    bool isRunning() const {return !workers.isEmpty();};
+
+    /// Total number of bytes read from all ports
+    quint64 bytesRead() const;
+    /// Number of samples dropped because merging couldn't keep up
+    /// or a port fell too far behind others
+    quint64 dropped() const;
+
+public slots:
+    void pause(bool enabled);
+
+signals:
+    void errorOccurred(QString message);
+
+private:
+    QList<PortWorker::Config> configs;
+    QVector<unsigned> portChannels;
+    Alignment alignment;
+    QList<PortWorker*> workers;
+    QList<QThread*> threads;
+    SampleAligner aligner;
+    QTimer mergeTimer;
+    bool paused;
+    qint64 startTime;
+    /// `aligner.dropped()` at last report
+    quint64 lastDropped;
+    LogRateLimiter dropLog;
+
+private slots:
+    /// Moves packs from worker queues to aligner and feeds out
+    void merge();
+};
+
+#endif // MERGEDSOURCE_H
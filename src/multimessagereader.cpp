@@ -0,0 +1,280 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <QPair>
+#include <QtDebug>
+
+#include "multimessagereader.h"
+
+#define STATS_UPDATE_INTERVAL 500 // ms
+
+MultiMessageReader::MultiMessageReader(QIODevice* device, QObject* parent) :
+    AbstractReader(device, parent),
+    statsTimer(this)
+{
+    paused = false;
+
+    // initial settings
+    syncWord = _settingsWidget.syncWord();
+    checksumType = _settingsWidget.checksumType();
+    bigEndian = _settingsWidget.endianness() == BigEndian;
+    skippingBytes = false;
+    _numChannels = 0;
+    onMessageTypesChanged(_settingsWidget.messageTypes());
+
+    connect(&_settingsWidget, &MultiMessageReaderSettings::syncWordChanged,
+            [this](QByteArray word)
+            {
+                syncWord = word;
+                checkSettings();
+            });
+
+    connect(&_settingsWidget, &MultiMessageReaderSettings::messageTypesChanged,
+            this, &MultiMessageReader::onMessageTypesChanged);
+
+    connect(&_settingsWidget, &MultiMessageReaderSettings::endiannessChanged,
+            [this](Endianness e){bigEndian = (e == BigEndian);});
+
+    connect(&_settingsWidget, &MultiMessageReaderSettings::checksumChanged,
+            [this](ChecksumType type){checksumType = type;});
+
+    connect(&_settingsWidget, &MultiMessageReaderSettings::resetStatsRequested,
+            [this]()
+            {
+                stats.clear();
+                updateStats();
+            });
+
+    statsTimer.setInterval(STATS_UPDATE_INTERVAL);
+    connect(&statsTimer, &QTimer::timeout, this, &MultiMessageReader::updateStats);
+}
+
+QWidget* MultiMessageReader::settingsWidget()
+{
+    return &_settingsWidget;
+}
+
+unsigned MultiMessageReader::numChannels() const
+{
+    return _numChannels;
+}
+
+void MultiMessageReader::enable(bool enabled)
+{
+    if (enabled)
+    {
+        stats.clear();
+        skippingBytes = false;
+        buffer.clear();
+        clearHeldValues();
+        statsTimer.start();
+    }
+    else
+    {
+        statsTimer.stop();
+    }
+    updateStats();
+    AbstractReader::enable(enabled);
+}
+
+void MultiMessageReader::updateStats()
+{
+    // readers of a merged source run on a worker thread, widget is
+    // only touched from the GUI thread
+    if (thread() != _settingsWidget.thread())
+    {
+        QString summary = stats.summary(false);
+        QMetaObject::invokeMethod(&_settingsWidget, [this, summary]()
+            {
+                if (_settingsWidget.isVisible()) _settingsWidget.showStats(summary);
+            }, Qt::QueuedConnection);
+        return;
+    }
+
+    // no need to update if nobody is looking
+    if (!_settingsWidget.isVisible()) return;
+
+    _settingsWidget.showStats(stats.summary(false));
+}
+
+void MultiMessageReader::checkSettings()
+{
+    if (syncWord.isEmpty())
+    {
+        _settingsWidget.showMessage("Frame Start is invalid!", true);
+    }
+    else
+    {
+        _settingsWidget.showMessage("Settings are okay.");
+    }
+}
+
+void MultiMessageReader::skipBytes(unsigned n)
+{
+    if (!n) return;
+
+    stats.bytesSkipped += n;
+    if (!skippingBytes)
+    {
+        skippingBytes = true;
+        stats.syncMisses++;
+        countSyncLoss();
+    }
+}
+
+void MultiMessageReader::clearHeldValues()
+{
+    heldValues.fill(std::numeric_limits<double>::quiet_NaN(), _numChannels);
+}
+
+void MultiMessageReader::onMessageTypesChanged(QVector<MessageType> types)
+{
+    // place channels of message types one after another
+    decoders.clear();
+    std::fill_n(decoderTable, 256, -1);
+    unsigned numChannels = 0;
+    for (auto& type : types)
+    {
+        decoderTable[type.id] = decoders.size();
+        decoders.append({type.layout, numChannels});
+        numChannels += type.layout.numChannels();
+    }
+
+    bool changed = numChannels != _numChannels;
+    _numChannels = numChannels;
+    clearHeldValues();
+    if (changed)
+    {
+        updateNumChannels();
+        emit numOfChannelsChanged(_numChannels);
+    }
+}
+
+unsigned MultiMessageReader::readData()
+{
+    // append to the receive buffer without an intermediate copy
+    int oldSize = buffer.size();
+    qint64 bytesAvailable = _device->bytesAvailable();
+    buffer.resize(oldSize + bytesAvailable);
+    qint64 numBytesRead = _device->read(buffer.data() + oldSize, bytesAvailable);
+    if (numBytesRead < 0) numBytesRead = 0;
+    buffer.resize(oldSize + numBytesRead);
+
+    if (syncWord.isEmpty() || decoders.isEmpty())
+    {
+        buffer.clear();
+        return numBytesRead;
+    }
+
+    const uchar* data = (const uchar*) buffer.constData();
+    const uchar* sync = (const uchar*) syncWord.constData();
+    int size = buffer.size();
+    int syncSize = syncWord.size();
+    unsigned csSize = checksumSize(checksumType);
+
+    // received messages, as (payload offset, decoder index)
+    QVector<QPair<int, int>> messages;
+
+    int pos = 0;
+    while (size - pos > syncSize)
+    {
+        if (memcmp(data + pos, sync, syncSize) != 0)
+        {
+            // jump to the next candidate for sync
+            const uchar* next = (const uchar*) memchr(data + pos + 1, sync[0], size - pos - 1);
+            int nextPos = next ? next - data : size;
+            skipBytes(nextPos - pos);
+            pos = nextPos;
+            continue;
+        }
+
+        int di = decoderTable[data[pos + syncSize]];
+        if (di < 0)
+        {
+            // most likely a false sync match
+            if (errorLog.allow()) qCritical() << "Unknown message ID:" << data[pos + syncSize];
+            skipBytes(1);
+            pos++;
+            continue;
+        }
+
+        const FrameLayout& layout = decoders[di].layout;
+        int frameSize = syncSize + 1 + layout.size() + csSize;
+        if (size - pos < frameSize) break;
+
+        // checksum covers message ID and payload
+        const uchar* id = data + pos + syncSize;
+        if (checksumType != Checksum_none)
+        {
+            quint32 calcChecksum = checksum(checksumType, id, 1 + layout.size());
+            quint32 rChecksum = readChecksum(checksumType, id + 1 + layout.size(), bigEndian);
+            if (calcChecksum != rChecksum)
+            {
+                stats.checksumFailures++;
+                countDecodeError();
+                if (errorLog.allow())
+                {
+                    qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
+                }
+                pos += frameSize;
+                continue;
+            }
+        }
+
+        stats.framesOk++;
+        skippingBytes = false;
+        messages.append({pos + syncSize + 1, di});
+        pos += frameSize;
+    }
+
+    if (!messages.isEmpty() && !paused)
+    {
+        // a sample set for each message, other channels hold their values
+        SamplePack samples(messages.size(), _numChannels);
+        for (int i = 0; i < messages.size(); i++)
+        {
+            const MessageDecoder& decoder = decoders[messages[i].second];
+            unsigned first = decoder.firstChannel;
+            unsigned last = first + decoder.layout.numChannels();
+
+            decoder.layout.decode(data + messages[i].first, 1, bigEndian, samples, i, first);
+            for (unsigned ci = 0; ci < first; ci++) samples.data(ci)[i] = heldValues[ci];
+            for (unsigned ci = first; ci < last; ci++) heldValues[ci] = samples.data(ci)[i];
+            for (unsigned ci = last; ci < _numChannels; ci++) samples.data(ci)[i] = heldValues[ci];
+        }
+        feedOut(samples);
+    }
+
+    buffer.remove(0, pos);
+
+    return numBytesRead;
+}
+
+void MultiMessageReader::saveSettings(QSettings* settings)
+{
+    _settingsWidget.saveSettings(settings);
+}
+
+void MultiMessageReader::loadSettings(QSettings* settings)
+{
+    _settingsWidget.loadSettings(settings);
+}
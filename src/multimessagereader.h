@@ -0,0 +1,103 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MULTIMESSAGEREADER_H
+#define MULTIMESSAGEREADER_H
+
+#include <QSettings>
+#include <QTimer>
+#include <QVector>
+
+#include "abstractreader.h"
+#include "multimessagereadersettings.h"
+#include "framestats.h"
+#include "checksum.h"
+
+/**
+ * Reads a framed protocol that multiplexes several message types on
+ * one link. Frame is: sync word, message ID byte, payload and an
+ * optional checksum. Payload size is known from the layout of the
+ * message type.
+ *
+ * Each message type has its own set of channels. Channels of all
+ * message types are placed one after another in the order they are
+ * defined. A message updates only its own channels, other channels
+ * hold their last value (NaN until their first message arrives).
+ */
+class MultiMessageReader : public AbstractReader
+{
+    Q_OBJECT
+
+public:
+    explicit MultiMessageReader(QIODevice* device, QObject *parent = 0);
+    QWidget* settingsWidget();
+    unsigned numChannels() const;
+    /// Clears statistics and held channel values when enabled
+    void enable(bool enabled = true) override;
+    /// Error counters
+    const FrameStats& frameStats() const {return stats;};
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+private:
+    /// Message type after its channels are placed
+    struct MessageDecoder
+    {
+        FrameLayout layout;
+        unsigned firstChannel;
+    };
+
+    MultiMessageReaderSettings _settingsWidget;
+    QByteArray syncWord;
+    ChecksumType checksumType;
+    bool bigEndian;
+    unsigned _numChannels;
+
+    QVector<MessageDecoder> decoders;
+    /// Index into `decoders` for each message ID, -1 if ID is unknown
+    int decoderTable[256];
+    /// Last value of each channel
+    QVector<double> heldValues;
+
+    /// received bytes that are not yet consumed
+    QByteArray buffer;
+    /// bytes are being skipped to find sync
+    bool skippingBytes;
+
+    FrameStats stats;
+    LogRateLimiter errorLog;
+    QTimer statsTimer;
+
+    /// Checks the sync word and shows an error message
+    void checkSettings();
+    /// Counts bytes that are discarded while searching for sync
+    void skipBytes(unsigned n);
+    void updateStats();
+    /// Clears held values of all channels
+    void clearHeldValues();
+
+    unsigned readData() override;
+
+private slots:
+    void onMessageTypesChanged(QVector<MessageType> types);
+};
+
+#endif // MULTIMESSAGEREADER_H
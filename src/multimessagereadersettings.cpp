@@ -0,0 +1,237 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "defines.h"
+#include "setting_defines.h"
+#include "multimessagereadersettings.h"
+#include "ui_multimessagereadersettings.h"
+
+#define DEFAULT_MESSAGES "01: u16,u16\n02: f32"
+
+MultiMessageReaderSettings::MultiMessageReaderSettings(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::MultiMessageReaderSettings)
+{
+    ui->setupUi(this);
+
+    ui->leSyncWord->setMode(false); // hex mode
+    ui->leSyncWord->setText("AA BB");
+
+    ui->cbChecksum->addItem(tr("None"), (int) Checksum_none);
+    ui->cbChecksum->addItem(tr("Sum (8 bit)"), (int) Checksum_sum8);
+    ui->cbChecksum->addItem(tr("CRC-16/CCITT"), (int) Checksum_crc16);
+    ui->cbChecksum->addItem(tr("CRC-32"), (int) Checksum_crc32);
+
+    ui->teMessages->setPlainText(DEFAULT_MESSAGES);
+    onMessagesEdited();
+
+    connect(ui->leSyncWord, &QLineEdit::textChanged,
+            [this]()
+            {
+                emit syncWordChanged(syncWord());
+            });
+
+    connect(ui->teMessages, &QPlainTextEdit::textChanged,
+            this, &MultiMessageReaderSettings::onMessagesEdited);
+
+    connect(ui->endiBox, &EndiannessBox::selectionChanged,
+            this, &MultiMessageReaderSettings::endiannessChanged);
+
+    connect(ui->cbChecksum, &QComboBox::currentIndexChanged,
+            [this]()
+            {
+                emit checksumChanged(checksumType());
+            });
+
+    connect(ui->pbResetStats, &QPushButton::clicked,
+            this, &MultiMessageReaderSettings::resetStatsRequested);
+}
+
+MultiMessageReaderSettings::~MultiMessageReaderSettings()
+{
+    delete ui;
+}
+
+void MultiMessageReaderSettings::showMessage(QString message, bool error)
+{
+    ui->lMessage->setText(message);
+    if (error)
+    {
+        ui->lMessage->setStyleSheet("color: red;");
+    }
+    else
+    {
+        ui->lMessage->setStyleSheet("");
+    }
+}
+
+void MultiMessageReaderSettings::showStats(QString stats)
+{
+    ui->lStats->setText(stats);
+}
+
+QByteArray MultiMessageReaderSettings::syncWord()
+{
+    QString text = ui->leSyncWord->text().remove(' ');
+
+    // check if nibble is missing
+    if (text.size() % 2 == 1)
+    {
+        return QByteArray();
+    }
+    else
+    {
+        return QByteArray::fromHex(text.toLatin1());
+    }
+}
+
+QVector<MessageType> MultiMessageReaderSettings::messageTypes() const
+{
+    return _messageTypes;
+}
+
+Endianness MultiMessageReaderSettings::endianness()
+{
+    return ui->endiBox->currentSelection();
+}
+
+ChecksumType MultiMessageReaderSettings::checksumType() const
+{
+    return static_cast<ChecksumType>(ui->cbChecksum->currentData().toInt());
+}
+
+bool MultiMessageReaderSettings::parseMessageTypes(QString text, QVector<MessageType>* types,
+                                                   QString* error)
+{
+    auto fail = [error](QString message)
+    {
+        if (error != nullptr) *error = message;
+        return false;
+    };
+
+    QVector<MessageType> result;
+    bool idUsed[256] = {false};
+    unsigned totalChannels = 0;
+
+    for (auto line : text.split('\n'))
+    {
+        line = line.trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        int colon = line.indexOf(':');
+        if (colon < 0) return fail(QString("Missing ':' after message ID: %1").arg(line));
+
+        bool ok;
+        unsigned id = line.left(colon).trimmed().toUInt(&ok, 16);
+        if (!ok || id > 0xFF) return fail(QString("Invalid message ID: %1").arg(line.left(colon)));
+        if (idUsed[id]) return fail(QString("Message ID %1 is defined twice!").arg(id, 2, 16, QChar('0')));
+        idUsed[id] = true;
+
+        MessageType type;
+        type.id = id;
+        QString layoutError;
+        if (!type.layout.parse(line.mid(colon + 1), &layoutError))
+        {
+            return fail(QString("Message %1: %2").arg(id, 2, 16, QChar('0')).arg(layoutError));
+        }
+        totalChannels += type.layout.numChannels();
+        result.append(type);
+    }
+
+    if (result.isEmpty()) return fail("No message types defined!");
+    if (totalChannels > MAX_NUM_CHANNELS)
+    {
+        return fail(QString("Messages have more than %1 channels in total!").arg(MAX_NUM_CHANNELS));
+    }
+
+    *types = result;
+    return true;
+}
+
+void MultiMessageReaderSettings::onMessagesEdited()
+{
+    QString error;
+    QVector<MessageType> types;
+    if (!parseMessageTypes(ui->teMessages->toPlainText(), &types, &error))
+    {
+        showMessage(error, true);
+        return;
+    }
+
+    unsigned numChannels = 0;
+    for (auto& type : types) numChannels += type.layout.numChannels();
+    showMessage(QString("Settings OK. [%1 message types, %2 channels]")
+                .arg(types.size()).arg(numChannels));
+
+    _messageTypes = types;
+    emit messageTypesChanged(_messageTypes);
+}
+
+void MultiMessageReaderSettings::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_MultiMessage);
+    settings->setValue(SG_MultiMessage_FrameStart, ui->leSyncWord->text());
+    settings->setValue(SG_MultiMessage_Messages, ui->teMessages->toPlainText());
+    settings->setValue(SG_MultiMessage_Endianness,
+                       endianness() == LittleEndian ? "little" : "big");
+    settings->setValue(SG_MultiMessage_Checksum, checksumTypeToStr(checksumType()));
+    settings->endGroup();
+}
+
+void MultiMessageReaderSettings::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_MultiMessage);
+
+    // load frame start
+    QString frameStartSetting =
+        settings->value(SG_MultiMessage_FrameStart, ui->leSyncWord->text()).toString();
+    auto validator = ui->leSyncWord->validator();
+    validator->fixup(frameStartSetting);
+    int pos = 0;
+    if (validator->validate(frameStartSetting, pos) != QValidator::Invalid)
+    {
+        ui->leSyncWord->setText(frameStartSetting);
+    }
+
+    // load message types
+    ui->teMessages->setPlainText(
+        settings->value(SG_MultiMessage_Messages, ui->teMessages->toPlainText()).toString());
+
+    // load endianness
+    QString endiannessSetting =
+        settings->value(SG_MultiMessage_Endianness, QString()).toString();
+    if (endiannessSetting == "little")
+    {
+        ui->endiBox->setSelection(LittleEndian);
+    }
+    else if (endiannessSetting == "big")
+    {
+        ui->endiBox->setSelection(BigEndian);
+    } // else don't change
+
+    // load checksum
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_MultiMessage_Checksum, QString()).toString());
+    if (csSetting != Checksum_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(ui->cbChecksum->findData((int) csSetting));
+    }
+
+    settings->endGroup();
+}
@@ -0,0 +1,95 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MULTIMESSAGEREADERSETTINGS_H
+#define MULTIMESSAGEREADERSETTINGS_H
+
+#include <QWidget>
+#include <QSettings>
+#include <QVector>
+
+#include "endiannessbox.h"
+#include "checksum.h"
+#include "framelayout.h"
+
+namespace Ui {
+class MultiMessageReaderSettings;
+}
+
+/// A message type of the multi message protocol
+struct MessageType
+{
+    quint8 id;
+    FrameLayout layout;
+};
+
+class MultiMessageReaderSettings : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MultiMessageReaderSettings(QWidget *parent = 0);
+    ~MultiMessageReaderSettings();
+
+    void showMessage(QString message, bool error = false);
+    /// Displays frame statistics
+    void showStats(QString stats);
+
+    QByteArray syncWord();
+    /// Last valid list of message types entered
+    QVector<MessageType> messageTypes() const;
+    Endianness endianness();
+    ChecksumType checksumType() const;
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+    /**
+     * Parses message type definitions. Each line defines a message
+     * type as "ID: layout", ID is a hexadecimal byte, ex: "01:
+     * u16,u16,f32". Empty lines and lines starting with '#' are
+     * ignored. See `FrameLayout` for layout syntax.
+     *
+     * @param error set to a description of the error if not `nullptr`
+     * @return `false` if text is invalid
+     */
+    static bool parseMessageTypes(QString text, QVector<MessageType>* types,
+                                  QString* error = nullptr);
+
+signals:
+    /// If sync word is invalid (empty) emitted with an empty `QByteArray`
+    void syncWordChanged(QByteArray);
+    /// Signaled only when a valid list is entered
+    void messageTypesChanged(QVector<MessageType>);
+    void endiannessChanged(Endianness);
+    void checksumChanged(ChecksumType);
+    /// Reset button for statistics is clicked
+    void resetStatsRequested();
+
+private:
+    Ui::MultiMessageReaderSettings *ui;
+    QVector<MessageType> _messageTypes;
+
+    /// Parses the message type text, shows an error if it's invalid
+    void onMessagesEdited();
+};
+
+#endif // MULTIMESSAGEREADERSETTINGS_H
@@ -0,0 +1,456 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "multiportpanel.h"
+#include "ui_multiportpanel.h"
+
+#include <algorithm>
+#include <QComboBox>
+#include <QMap>
+#include <QPair>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <QSerialPortInfo>
+#include <QtDebug>
+
+#include "defines.h"
+#include "setting_defines.h"
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "framedreader.h"
+#include "complexframedreader.h"
+#include "delimitedreader.h"
+#include "multimessagereader.h"
+
+/// Status label update interval (ms)
+#define STATUS_INTERVAL 1000
+
+enum PortColumn
+{
+    PortColumn_Name,
+    PortColumn_BaudRate,
+    PortColumn_DataBits,
+    PortColumn_Parity,
+    PortColumn_StopBits,
+    PortColumn_FlowControl,
+    PortColumn_Format,
+    PortColumn_FormatSettings,
+    PortColumn_TimeChannel
+};
+
+/// Data formats that can be used per port, names are the same as
+/// saved by `DataFormatPanel`
+static const char* const portFormats[][2] = {
+    {"binary", QT_TRANSLATE_NOOP("MultiPortPanel", "Simple Binary")},
+    {"ascii", QT_TRANSLATE_NOOP("MultiPortPanel", "ASCII")},
+    {"custom", QT_TRANSLATE_NOOP("MultiPortPanel", "Custom Frame")},
+    {"complex", QT_TRANSLATE_NOOP("MultiPortPanel", "Complex Frame")},
+    {"delimited", QT_TRANSLATE_NOOP("MultiPortPanel", "COBS/SLIP Frame")},
+    {"multimessage", QT_TRANSLATE_NOOP("MultiPortPanel", "Multi Message")},
+};
+
+// same setting values as `PortControl`
+static const QMap<QSerialPort::Parity, QString> paritySettingMap({
+        {QSerialPort::NoParity, "none"},
+        {QSerialPort::OddParity, "odd"},
+        {QSerialPort::EvenParity, "even"},
+    });
+
+static const QMap<QSerialPort::FlowControl, QString> flowControlSettingMap({
+        {QSerialPort::NoFlowControl, "none"},
+        {QSerialPort::HardwareControl, "hardware"},
+        {QSerialPort::SoftwareControl, "software"},
+    });
+
+/// Adds items to a combo box and selects the one with `current` data
+static void addItems(QComboBox* box, const QList<QPair<QString, int>>& items, int current)
+{
+    for (auto& item : items)
+    {
+        box->addItem(item.first, item.second);
+    }
+    box->setCurrentIndex(std::max(0, box->findData(current)));
+}
+
+/// Creates a reader for a data format name, `nullptr` if unknown
+static AbstractReader* createReader(QString format, QIODevice* device)
+{
+    if (format == "binary") return new BinaryStreamReader(device);
+    if (format == "ascii") return new AsciiReader(device);
+    if (format == "custom") return new FramedReader(device);
+    if (format == "complex") return new ComplexFramedReader(device);
+    if (format == "delimited") return new DelimitedReader(device);
+    if (format == "multimessage") return new MultiMessageReader(device);
+    return nullptr;
+}
+
+MultiPortPanel::MultiPortPanel(QWidget* parent) :
+    QWidget(parent),
+    ui(new Ui::MultiPortPanel)
+{
+    ui->setupUi(this);
+    lastBytesRead = 0;
+
+    connect(ui->pbAdd, &QPushButton::clicked, [this]()
+            {
+                addPort(PortWorker::Config(), portFormats[0][0]);
+            });
+
+    connect(ui->pbRemove, &QPushButton::clicked, [this]()
+            {
+                int row = ui->twPorts->currentRow();
+                if (row >= 0)
+                {
+                    ui->twPorts->removeRow(row);
+                    delete rows.takeAt(row);
+                }
+            });
+
+    connect(ui->pbStart, &QPushButton::toggled, this, &MultiPortPanel::setRunning);
+
+    connect(&mergedSource, &MergedSource::errorOccurred, [](QString message)
+            {
+                qCritical() << message;
+            });
+
+    statusTimer.setInterval(STATUS_INTERVAL);
+    connect(&statusTimer, &QTimer::timeout, this, &MultiPortPanel::updateStatus);
+}
+
+MultiPortPanel::~MultiPortPanel()
+{
+    mergedSource.stop();
+    qDeleteAll(rows);
+    delete ui;
+}
+
+Source* MultiPortPanel::source()
+{
+    return &mergedSource;
+}
+
+bool MultiPortPanel::isRunning() const
+{
+    return mergedSource.isRunning();
+}
+
+void MultiPortPanel::pause(bool enabled)
+{
+    mergedSource.pause(enabled);
+}
+
+MultiPortPanel::PortRow* MultiPortPanel::addPort(PortWorker::Config config, QString format)
+{
+    int row = ui->twPorts->rowCount();
+    ui->twPorts->insertRow(row);
+    auto portRow = new PortRow;
+    rows.append(portRow);
+
+    auto cbPort = new QComboBox();
+    cbPort->setEditable(true);
+    for (auto& info : QSerialPortInfo::availablePorts())
+    {
+        cbPort->addItem(info.portName());
+    }
+    if (!config.portName.isEmpty()) cbPort->setCurrentText(config.portName);
+    ui->twPorts->setCellWidget(row, PortColumn_Name, cbPort);
+
+    auto cbBaudRate = new QComboBox();
+    cbBaudRate->setEditable(true);
+    for (auto baudRate : QSerialPortInfo::standardBaudRates())
+    {
+        cbBaudRate->addItem(QString::number(baudRate));
+    }
+    cbBaudRate->setCurrentText(QString::number(config.baudRate));
+    ui->twPorts->setCellWidget(row, PortColumn_BaudRate, cbBaudRate);
+
+    auto cbDataBits = new QComboBox();
+    addItems(cbDataBits, {{"8", QSerialPort::Data8}, {"7", QSerialPort::Data7},
+                          {"6", QSerialPort::Data6}, {"5", QSerialPort::Data5}},
+             config.dataBits);
+    ui->twPorts->setCellWidget(row, PortColumn_DataBits, cbDataBits);
+
+    auto cbParity = new QComboBox();
+    addItems(cbParity, {{tr("None"), QSerialPort::NoParity},
+                        {tr("Odd"), QSerialPort::OddParity},
+                        {tr("Even"), QSerialPort::EvenParity}},
+             config.parity);
+    ui->twPorts->setCellWidget(row, PortColumn_Parity, cbParity);
+
+    auto cbStopBits = new QComboBox();
+    addItems(cbStopBits, {{"1", QSerialPort::OneStop}, {"2", QSerialPort::TwoStop}},
+             config.stopBits);
+    ui->twPorts->setCellWidget(row, PortColumn_StopBits, cbStopBits);
+
+    auto cbFlowControl = new QComboBox();
+    addItems(cbFlowControl, {{tr("None"), QSerialPort::NoFlowControl},
+                             {tr("Hardware"), QSerialPort::HardwareControl},
+                             {tr("Software"), QSerialPort::SoftwareControl}},
+             config.flowControl);
+    ui->twPorts->setCellWidget(row, PortColumn_FlowControl, cbFlowControl);
+
+    auto cbFormat = new QComboBox();
+    for (auto& f : portFormats)
+    {
+        cbFormat->addItem(tr(f[1]), QString(f[0]));
+    }
+    int formatIndex = cbFormat->findData(format);
+    if (formatIndex < 0) formatIndex = 0;
+    cbFormat->setCurrentIndex(formatIndex);
+    setFormat(portRow, cbFormat->currentData().toString());
+    connect(cbFormat, &QComboBox::currentIndexChanged, [this, cbFormat, portRow](int)
+            {
+                setFormat(portRow, cbFormat->currentData().toString());
+            });
+    ui->twPorts->setCellWidget(row, PortColumn_Format, cbFormat);
+
+    auto pbFormatSettings = new QPushButton(tr("Settings..."));
+    pbFormatSettings->setToolTip(tr("Data format settings of this port"));
+    connect(pbFormatSettings, &QPushButton::clicked, [this, portRow]()
+            {
+                showFormatSettings(portRow);
+            });
+    ui->twPorts->setCellWidget(row, PortColumn_FormatSettings, pbFormatSettings);
+
+    // channels are shown starting from 1, 0 is "none"
+    auto spTimeChannel = new QSpinBox();
+    spTimeChannel->setRange(0, MAX_NUM_CHANNELS);
+    spTimeChannel->setSpecialValueText(tr("None"));
+    spTimeChannel->setValue(config.timeChannel + 1);
+    spTimeChannel->setToolTip(tr("Channel that carries device timestamps, "
+                                 "used when aligning by device time"));
+    ui->twPorts->setCellWidget(row, PortColumn_TimeChannel, spTimeChannel);
+
+    return portRow;
+}
+
+void MultiPortPanel::setFormat(PortRow* row, QString format)
+{
+    if (row->reader != nullptr && row->format == format) return;
+
+    delete row->reader;
+    row->format = format;
+    row->reader = createReader(format, &row->idleDevice);
+    Q_ASSERT(row->reader != nullptr);
+}
+
+void MultiPortPanel::showFormatSettings(PortRow* row)
+{
+    int index = rows.indexOf(row);
+    auto portName =
+        static_cast<QComboBox*>(ui->twPorts->cellWidget(index, PortColumn_Name))->currentText();
+
+    QDialog dialog(this);
+    dialog.setWindowTitle(tr("Data Format of %1").arg(portName));
+    auto layout = new QVBoxLayout(&dialog);
+    QWidget* settingsWidget = row->reader->settingsWidget();
+    layout->addWidget(settingsWidget);
+    settingsWidget->show();
+
+    auto buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    dialog.exec();
+
+    // widget is owned by the reader, it shouldn't be deleted with dialog
+    settingsWidget->hide();
+    settingsWidget->setParent(nullptr);
+}
+
+QList<PortWorker::Config> MultiPortPanel::portConfigs() const
+{
+    QList<PortWorker::Config> configs;
+    auto table = ui->twPorts;
+    for (int row = 0; row < table->rowCount(); row++)
+    {
+        PortWorker::Config config;
+        config.portName =
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_Name))->currentText();
+        config.baudRate =
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_BaudRate))->currentText().toInt();
+        config.dataBits = QSerialPort::DataBits(
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_DataBits))->currentData().toInt());
+        config.parity = QSerialPort::Parity(
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_Parity))->currentData().toInt());
+        config.stopBits = QSerialPort::StopBits(
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_StopBits))->currentData().toInt());
+        config.flowControl = QSerialPort::FlowControl(
+            static_cast<QComboBox*>(table->cellWidget(row, PortColumn_FlowControl))->currentData().toInt());
+        config.reader = rows[row]->reader;
+        config.timeChannel =
+            static_cast<QSpinBox*>(table->cellWidget(row, PortColumn_TimeChannel))->value() - 1;
+        configs.append(config);
+    }
+    return configs;
+}
+
+void MultiPortPanel::setRunning(bool enabled)
+{
+    if (enabled == isRunning()) return;
+
+    if (enabled)
+    {
+        auto configs = portConfigs();
+        auto alignment = MergedSource::Alignment(ui->cbAlignment->currentIndex());
+        bool valid = !configs.isEmpty();
+        if (!valid) qCritical() << "Add at least one port to start multi port acquisition.";
+
+        for (auto& config : configs)
+        {
+            unsigned numChannels = config.reader->numChannels();
+            if (config.portName.isEmpty() || config.baudRate <= 0)
+            {
+                qCritical() << "Invalid port or baud rate:" << config.portName;
+                valid = false;
+            }
+            if (numChannels == 0)
+            {
+                qCritical() << "Set a fixed number of channels for" << config.portName
+                            << "to merge it with other ports.";
+                valid = false;
+            }
+            if (alignment == MergedSource::DeviceTime &&
+                (config.timeChannel < 0 || unsigned(config.timeChannel) >= numChannels))
+            {
+                qCritical() << "Select a time channel for" << config.portName
+                            << "to align by device time.";
+                valid = false;
+            }
+        }
+
+        if (!valid)
+        {
+            ui->pbStart->setChecked(false);
+            return;
+        }
+
+        mergedSource.setPorts(configs, alignment);
+        mergedSource.start();
+        lastBytesRead = 0;
+        statusTimer.start();
+    }
+    else
+    {
+        mergedSource.stop();
+        statusTimer.stop();
+        ui->lStatus->setText("-");
+    }
+
+    ui->pbStart->setChecked(enabled);
+    ui->pbStart->setText(enabled ? tr("Stop") : tr("Start"));
+    ui->twPorts->setEnabled(!enabled);
+    ui->pbAdd->setEnabled(!enabled);
+    ui->pbRemove->setEnabled(!enabled);
+    ui->cbAlignment->setEnabled(!enabled);
+
+    emit runningChanged(enabled);
+}
+
+void MultiPortPanel::updateStatus()
+{
+    quint64 bytesRead = mergedSource.bytesRead();
+    double rate = double(bytesRead - lastBytesRead) * 1000 / STATUS_INTERVAL;
+    lastBytesRead = bytesRead;
+
+    ui->lStatus->setText(tr("%1 kB/s, %2 dropped")
+                         .arg(rate / 1000, 0, 'f', 1)
+                         .arg(mergedSource.dropped()));
+}
+
+void MultiPortPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_MultiPort);
+    settings->setValue(SG_MultiPort_Alignment,
+                       ui->cbAlignment->currentIndex() == MergedSource::DeviceTime ?
+                       "device" : "arrival");
+
+    auto configs = portConfigs();
+    settings->beginWriteArray(SG_MultiPort_Port);
+    for (int i = 0; i < configs.size(); i++)
+    {
+        auto& config = configs[i];
+        settings->setArrayIndex(i);
+        settings->setValue(SG_MultiPort_PortName, config.portName);
+        settings->setValue(SG_MultiPort_BaudRate, config.baudRate);
+        settings->setValue(SG_MultiPort_DataBits, int(config.dataBits));
+        settings->setValue(SG_MultiPort_Parity, paritySettingMap.value(config.parity));
+        settings->setValue(SG_MultiPort_StopBits, int(config.stopBits));
+        settings->setValue(SG_MultiPort_FlowControl, flowControlSettingMap.value(config.flowControl));
+        settings->setValue(SG_MultiPort_TimeChannel, config.timeChannel);
+        settings->setValue(SG_MultiPort_Format, rows[i]->format);
+        config.reader->saveSettings(settings);
+    }
+    settings->endArray();
+
+    settings->endGroup();
+}
+
+void MultiPortPanel::loadSettings(QSettings* settings)
+{
+    if (isRunning()) return;
+
+    settings->beginGroup(SettingGroup_MultiPort);
+
+    QString alignment = settings->value(SG_MultiPort_Alignment, QString()).toString();
+    if (alignment == "arrival")
+    {
+        ui->cbAlignment->setCurrentIndex(MergedSource::ArrivalTime);
+    }
+    else if (alignment == "device")
+    {
+        ui->cbAlignment->setCurrentIndex(MergedSource::DeviceTime);
+    }
+
+    unsigned size = settings->beginReadArray(SG_MultiPort_Port);
+    if (size)
+    {
+        ui->twPorts->setRowCount(0);
+        qDeleteAll(rows);
+        rows.clear();
+    }
+    for (unsigned i = 0; i < size; i++)
+    {
+        settings->setArrayIndex(i);
+        PortWorker::Config config;
+        config.portName = settings->value(SG_MultiPort_PortName).toString();
+        config.baudRate = settings->value(SG_MultiPort_BaudRate, config.baudRate).toInt();
+        int dataBits = settings->value(SG_MultiPort_DataBits, int(config.dataBits)).toInt();
+        if (dataBits >= 5 && dataBits <= 8) config.dataBits = QSerialPort::DataBits(dataBits);
+        config.parity = paritySettingMap.key(
+            settings->value(SG_MultiPort_Parity).toString(), config.parity);
+        int stopBits = settings->value(SG_MultiPort_StopBits, int(config.stopBits)).toInt();
+        if (stopBits == QSerialPort::OneStop || stopBits == QSerialPort::TwoStop)
+        {
+            config.stopBits = QSerialPort::StopBits(stopBits);
+        }
+        config.flowControl = flowControlSettingMap.key(
+            settings->value(SG_MultiPort_FlowControl).toString(), config.flowControl);
+        config.timeChannel = settings->value(SG_MultiPort_TimeChannel, -1).toInt();
+        QString format = settings->value(SG_MultiPort_Format, portFormats[0][0]).toString();
+        PortRow* row = addPort(config, format);
+        row->reader->loadSettings(settings);
+    }
+    settings->endArray();
+
+    settings->endGroup();
+}
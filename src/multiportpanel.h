@@ -0,0 +1,94 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MULTIPORTPANEL_H
+#define MULTIPORTPANEL_H
+
+#include <QWidget>
+#include <QBuffer>
+#include <QList>
+#include <QSettings>
+#include <QTimer>
+
+#include "abstractreader.h"
+#include "mergedsource.h"
+
+namespace Ui {
+class MultiPortPanel;
+}
+
+/// Configures and runs acquisition from several ports at once
+class MultiPortPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MultiPortPanel(QWidget* parent = 0);
+    ~MultiPortPanel();
+
+    /// Merged source of all ports
+    Source* source();
+    bool isRunning() const;
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+public slots:
+    void pause(bool enabled);
+    /// Starts or stops acquisition
+    void setRunning(bool enabled);
+
+signals:
+    /// Acquisition started or stopped
+    void runningChanged(bool running);
+
+private:
+    /// Data format of a port row
+    struct PortRow
+    {
+        /// reader name, same as the names saved by `DataFormatPanel`
+        QString format;
+        AbstractReader* reader = nullptr;
+        /// device of the reader while not acquiring
+        QBuffer idleDevice;
+
+        ~PortRow() {delete reader;};
+    };
+
+    Ui::MultiPortPanel *ui;
+    MergedSource mergedSource;
+    QTimer statusTimer;
+    quint64 lastBytesRead;
+    /// same order as table rows
+    QList<PortRow*> rows;
+
+    /// Adds a row to the port table
+    PortRow* addPort(PortWorker::Config config, QString format);
+    /// Replaces the reader of a row, settings of previous reader are lost
+    void setFormat(PortRow* row, QString format);
+    /// Shows settings widget of the reader of a row in a dialog
+    void showFormatSettings(PortRow* row);
+    /// Reads port configurations from the table
+    QList<PortWorker::Config> portConfigs() const;
+    void updateStatus();
+};
+
+#endif // MULTIPORTPANEL_H
@@ -0,0 +1,599 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <string.h>
+#include <QMutexLocker>
+#include <QtDebug>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <linux/serial.h>
+#endif
+
+#include "nativeserialport.h"
+#include "perfcounters.h"
+
+#define DEFAULT_READ_SIZE   4096        // bytes
+#define DEFAULT_BUFFER_SIZE (1024*1024) // bytes
+#define WRITE_TIMEOUT       1000        // ms
+#define COMPACT_THRESHOLD   (64*1024)   // bytes, see `readData()`
+
+#ifdef Q_OS_LINUX
+/// Converts a baud rate to termios speed constant
+static bool baudToSpeed(qint32 baud, speed_t* speed)
+{
+    static const struct {qint32 baud; speed_t speed;} speeds[] = {
+        {50, B50}, {75, B75}, {110, B110}, {134, B134}, {150, B150},
+        {200, B200}, {300, B300}, {600, B600}, {1200, B1200},
+        {1800, B1800}, {2400, B2400}, {4800, B4800}, {9600, B9600},
+        {19200, B19200}, {38400, B38400}, {57600, B57600},
+        {115200, B115200}, {230400, B230400}, {460800, B460800},
+        {500000, B500000}, {576000, B576000}, {921600, B921600},
+        {1000000, B1000000}, {1152000, B1152000}, {1500000, B1500000},
+        {2000000, B2000000}, {2500000, B2500000}, {3000000, B3000000},
+        {3500000, B3500000}, {4000000, B4000000}
+    };
+
+    for (auto& s : speeds)
+    {
+        if (s.baud == baud)
+        {
+            *speed = s.speed;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+NativeSerialPort::NativeSerialPort(QObject* parent) :
+    QIODevice(parent),
+    bufferSize(DEFAULT_BUFFER_SIZE),
+    stopRequested(false),
+    notifyPending(false)
+{
+    _baudRate = 9600;
+    _parity = QSerialPort::NoParity;
+    _dataBits = QSerialPort::Data8;
+    _stopBits = QSerialPort::OneStop;
+    _flowControl = QSerialPort::NoFlowControl;
+    readSize = DEFAULT_READ_SIZE;
+    perfCounters = nullptr;
+
+    fd = -1;
+    epollFd = -1;
+    stopFd = -1;
+    readerThread = nullptr;
+    bufferHead = 0;
+}
+
+NativeSerialPort::~NativeSerialPort()
+{
+    close();
+}
+
+bool NativeSerialPort::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NativeSerialPort::setPortName(QString name)
+{
+    _portName = name;
+}
+
+bool NativeSerialPort::setBaudRate(qint32 baudRate)
+{
+    _baudRate = baudRate;
+    return isOpen() ? applySettings() : true;
+}
+
+bool NativeSerialPort::setParity(QSerialPort::Parity parity)
+{
+    _parity = parity;
+    return isOpen() ? applySettings() : true;
+}
+
+bool NativeSerialPort::setDataBits(QSerialPort::DataBits dataBits)
+{
+    _dataBits = dataBits;
+    return isOpen() ? applySettings() : true;
+}
+
+bool NativeSerialPort::setStopBits(QSerialPort::StopBits stopBits)
+{
+    _stopBits = stopBits;
+    return isOpen() ? applySettings() : true;
+}
+
+bool NativeSerialPort::setFlowControl(QSerialPort::FlowControl flowControl)
+{
+    _flowControl = flowControl;
+    return isOpen() ? applySettings() : true;
+}
+
+void NativeSerialPort::setReadSize(unsigned size)
+{
+    // takes effect when port is opened next time
+    readSize = size;
+}
+
+void NativeSerialPort::setBufferSize(unsigned size)
+{
+    bufferSize = size;
+    spaceAvailable.wakeAll();
+}
+
+void NativeSerialPort::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+}
+
+void NativeSerialPort::setError(QString message)
+{
+    setErrorString(message);
+}
+
+bool NativeSerialPort::open(OpenMode mode)
+{
+    if (isOpen())
+    {
+        setError("Port is already open!");
+        emit errorOccurred(QSerialPort::OpenError);
+        return false;
+    }
+
+#ifdef Q_OS_LINUX
+    // same as `QSerialPort`, short names are looked up in /dev
+    QString path = _portName.startsWith('/') ? _portName : "/dev/" + _portName;
+
+    fd = ::open(path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        int err = errno;
+        setError(QString("Can't open %1: %2").arg(path).arg(strerror(err)));
+        if (err == ENOENT)
+        {
+            emit errorOccurred(QSerialPort::DeviceNotFoundError);
+        }
+        else if (err == EACCES || err == EBUSY)
+        {
+            emit errorOccurred(QSerialPort::PermissionError);
+        }
+        else
+        {
+            emit errorOccurred(QSerialPort::OpenError);
+        }
+        return false;
+    }
+
+    // prevent others from opening the port
+    ioctl(fd, TIOCEXCL);
+
+    if (!applySettings())
+    {
+        closeFds();
+        emit errorOccurred(QSerialPort::UnsupportedOperationError);
+        return false;
+    }
+
+    // flush characters to user space as soon as they arrive; not
+    // supported by all drivers (ex: pseudo terminals), that's okay
+    struct serial_struct serial;
+    if (ioctl(fd, TIOCGSERIAL, &serial) == 0)
+    {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &serial);
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event portEvent = {}, stopEvent = {};
+    portEvent.events = EPOLLIN;
+    portEvent.data.fd = fd;
+    stopEvent.events = EPOLLIN;
+    stopEvent.data.fd = stopFd;
+    if (epollFd < 0 || stopFd < 0 ||
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &portEvent) < 0 ||
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &stopEvent) < 0)
+    {
+        setError(QString("Can't create epoll instance: %1").arg(strerror(errno)));
+        closeFds();
+        emit errorOccurred(QSerialPort::OpenError);
+        return false;
+    }
+
+    buffer.clear();
+    bufferHead = 0;
+    notifyPending = false;
+    stopRequested = false;
+
+    // reads are already buffered by us
+    QIODevice::open(mode | QIODevice::Unbuffered);
+
+    readerThread = QThread::create([this](){readLoop();});
+    readerThread->start();
+    return true;
+#else
+    Q_UNUSED(mode);
+    setError("Native serial backend is only available on Linux!");
+    emit errorOccurred(QSerialPort::UnsupportedOperationError);
+    return false;
+#endif
+}
+
+void NativeSerialPort::close()
+{
+    if (!isOpen()) return;
+
+    // emits `aboutToClose`
+    QIODevice::close();
+
+#ifdef Q_OS_LINUX
+    // wake up and stop the reader thread
+    {
+        QMutexLocker locker(&bufferLock);
+        stopRequested = true;
+        spaceAvailable.wakeAll();
+    }
+    quint64 one = 1;
+    if (::write(stopFd, &one, sizeof(one)) < 0)
+    {
+        qWarning() << "Can't signal port reader thread:" << strerror(errno);
+    }
+    readerThread->wait();
+#endif
+    delete readerThread;
+    readerThread = nullptr;
+
+    closeFds();
+
+    QMutexLocker locker(&bufferLock);
+    buffer.clear();
+    bufferHead = 0;
+}
+
+void NativeSerialPort::closeFds()
+{
+#ifdef Q_OS_LINUX
+    if (epollFd >= 0) ::close(epollFd);
+    if (stopFd >= 0) ::close(stopFd);
+    if (fd >= 0) ::close(fd);
+#endif
+    epollFd = stopFd = fd = -1;
+}
+
+bool NativeSerialPort::applySettings()
+{
+#ifdef Q_OS_LINUX
+    struct termios tio;
+    if (tcgetattr(fd, &tio) < 0)
+    {
+        setError(QString("Can't get port attributes: %1").arg(strerror(errno)));
+        return false;
+    }
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+
+    tio.c_cflag &= ~CSIZE;
+    switch (_dataBits)
+    {
+        case QSerialPort::Data5: tio.c_cflag |= CS5; break;
+        case QSerialPort::Data6: tio.c_cflag |= CS6; break;
+        case QSerialPort::Data7: tio.c_cflag |= CS7; break;
+        default:                 tio.c_cflag |= CS8; break;
+    }
+
+    tio.c_cflag &= ~(PARENB | PARODD | CMSPAR);
+    switch (_parity)
+    {
+        case QSerialPort::EvenParity:  tio.c_cflag |= PARENB; break;
+        case QSerialPort::OddParity:   tio.c_cflag |= PARENB | PARODD; break;
+        case QSerialPort::SpaceParity: tio.c_cflag |= PARENB | CMSPAR; break;
+        case QSerialPort::MarkParity:  tio.c_cflag |= PARENB | CMSPAR | PARODD; break;
+        default: break;
+    }
+
+    if (_stopBits == QSerialPort::OneAndHalfStop)
+    {
+        setError("1.5 stop bits isn't supported!");
+        return false;
+    }
+    else if (_stopBits == QSerialPort::TwoStop)
+    {
+        tio.c_cflag |= CSTOPB;
+    }
+    else
+    {
+        tio.c_cflag &= ~CSTOPB;
+    }
+
+    tio.c_cflag &= ~CRTSCTS;
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    if (_flowControl == QSerialPort::HardwareControl)
+    {
+        tio.c_cflag |= CRTSCTS;
+    }
+    else if (_flowControl == QSerialPort::SoftwareControl)
+    {
+        tio.c_iflag |= IXON | IXOFF;
+    }
+
+    // reads never block, reader thread waits with epoll
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    speed_t speed;
+    if (!baudToSpeed(_baudRate, &speed))
+    {
+        setError(QString("Baud rate %1 isn't supported by native backend!").arg(_baudRate));
+        return false;
+    }
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+
+    if (tcsetattr(fd, TCSANOW, &tio) < 0)
+    {
+        setError(QString("Can't set port attributes: %1").arg(strerror(errno)));
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NativeSerialPort::setModemLine(int line, bool set)
+{
+#ifdef Q_OS_LINUX
+    if (fd < 0) return false;
+    return ioctl(fd, set ? TIOCMBIS : TIOCMBIC, &line) == 0;
+#else
+    Q_UNUSED(line);
+    Q_UNUSED(set);
+    return false;
+#endif
+}
+
+bool NativeSerialPort::setDataTerminalReady(bool set)
+{
+#ifdef Q_OS_LINUX
+    return setModemLine(TIOCM_DTR, set);
+#else
+    return setModemLine(0, set);
+#endif
+}
+
+bool NativeSerialPort::setRequestToSend(bool set)
+{
+#ifdef Q_OS_LINUX
+    return setModemLine(TIOCM_RTS, set);
+#else
+    return setModemLine(0, set);
+#endif
+}
+
+QSerialPort::PinoutSignals NativeSerialPort::pinoutSignals()
+{
+    QSerialPort::PinoutSignals pins = QSerialPort::NoSignal;
+#ifdef Q_OS_LINUX
+    int lines;
+    if (fd < 0 || ioctl(fd, TIOCMGET, &lines) < 0) return pins;
+
+    if (lines & TIOCM_CAR) pins |= QSerialPort::DataCarrierDetectSignal;
+    if (lines & TIOCM_DSR) pins |= QSerialPort::DataSetReadySignal;
+    if (lines & TIOCM_RNG) pins |= QSerialPort::RingIndicatorSignal;
+    if (lines & TIOCM_CTS) pins |= QSerialPort::ClearToSendSignal;
+    if (lines & TIOCM_DTR) pins |= QSerialPort::DataTerminalReadySignal;
+    if (lines & TIOCM_RTS) pins |= QSerialPort::RequestToSendSignal;
+#endif
+    return pins;
+}
+
+void NativeSerialPort::readLoop()
+{
+#ifdef Q_OS_LINUX
+    QByteArray chunk(readSize, Qt::Uninitialized);
+    struct epoll_event events[2];
+
+    while (true)
+    {
+        int numEvents = epoll_wait(epollFd, events, 2, -1);
+        if (numEvents < 0)
+        {
+            if (errno == EINTR) continue;
+            QMetaObject::invokeMethod(this, "onReadFailed", Qt::QueuedConnection);
+            return;
+        }
+
+        bool readable = false;
+        for (int i = 0; i < numEvents; i++)
+        {
+            if (events[i].data.fd == stopFd) return;
+            readable = true; // errors and hangups are seen by read
+        }
+        if (!readable) continue;
+
+        // drain the port until it would block
+        quint64 numReads = 0;
+        quint64 numBytes = 0;
+        bool failed = false;
+        while (true)
+        {
+            {
+                // buffer is full, wait for the reader
+                QMutexLocker locker(&bufferLock);
+                while (unsigned(buffer.size() - bufferHead) >= bufferSize && !stopRequested)
+                {
+                    // the reader may not know about the data yet if
+                    // port didn't drain since last notification
+                    if (!notifyPending.exchange(true))
+                    {
+                        QMetaObject::invokeMethod(this, "onDataArrived", Qt::QueuedConnection);
+                    }
+                    spaceAvailable.wait(&bufferLock);
+                }
+                if (stopRequested) return;
+            }
+
+            ssize_t r = ::read(fd, chunk.data(), chunk.size());
+            numReads++;
+            if (r > 0)
+            {
+                QMutexLocker locker(&bufferLock);
+                buffer.append(chunk.constData(), r);
+                numBytes += r;
+                // a short read means kernel buffer is drained, saves
+                // a read that would return EAGAIN
+                if (r < chunk.size()) break;
+            }
+            else if (r < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (r < 0 && errno == EAGAIN)
+            {
+                break;
+            }
+            else // 0 means hangup, ex: device removed
+            {
+                failed = true;
+                break;
+            }
+        }
+
+        if (perfCounters != nullptr)
+        {
+            PerfCounters::inc(perfCounters->portReads, numReads);
+            PerfCounters::inc(perfCounters->portWakeups);
+            PerfCounters::inc(perfCounters->portBytes, numBytes);
+        }
+
+        // a single notification is queued until it's delivered
+        if (numBytes && !notifyPending.exchange(true))
+        {
+            QMetaObject::invokeMethod(this, "onDataArrived", Qt::QueuedConnection);
+        }
+
+        if (failed)
+        {
+            QMetaObject::invokeMethod(this, "onReadFailed", Qt::QueuedConnection);
+            return;
+        }
+    }
+#endif
+}
+
+void NativeSerialPort::onDataArrived()
+{
+    notifyPending = false;
+    if (isOpen()) emit readyRead();
+}
+
+void NativeSerialPort::onReadFailed()
+{
+    if (!isOpen()) return;
+
+    setError("Reading from port failed, most likely device removed.");
+    emit errorOccurred(QSerialPort::ResourceError);
+}
+
+qint64 NativeSerialPort::bytesAvailable() const
+{
+    QMutexLocker locker(&bufferLock);
+    return (buffer.size() - bufferHead) + QIODevice::bytesAvailable();
+}
+
+qint64 NativeSerialPort::readData(char* data, qint64 maxSize)
+{
+    QMutexLocker locker(&bufferLock);
+
+    qint64 n = std::min(maxSize, qint64(buffer.size() - bufferHead));
+    memcpy(data, buffer.constData() + bufferHead, n);
+    bufferHead += n;
+
+    // consumed bytes are dropped lazily, readers may read a few bytes
+    // at a time
+    if (bufferHead == buffer.size())
+    {
+        buffer.resize(0);
+        bufferHead = 0;
+    }
+    else if (bufferHead > COMPACT_THRESHOLD && bufferHead > buffer.size() / 2)
+    {
+        buffer.remove(0, bufferHead);
+        bufferHead = 0;
+    }
+
+    if (n) spaceAvailable.wakeAll();
+    return n;
+}
+
+qint64 NativeSerialPort::writeData(const char* data, qint64 maxSize)
+{
+#ifdef Q_OS_LINUX
+    qint64 written = 0;
+    while (written < maxSize)
+    {
+        ssize_t r = ::write(fd, data + written, maxSize - written);
+        if (r >= 0)
+        {
+            written += r;
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno == EAGAIN)
+        {
+            struct pollfd p = {fd, POLLOUT, 0};
+            if (poll(&p, 1, WRITE_TIMEOUT) <= 0)
+            {
+                setError("Write timeout!");
+                emit errorOccurred(QSerialPort::TimeoutError);
+                return written ? written : -1;
+            }
+        }
+        else
+        {
+            setError(QString("Write failed: %1").arg(strerror(errno)));
+            emit errorOccurred(QSerialPort::WriteError);
+            return -1;
+        }
+    }
+    return written;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+#endif
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NATIVESERIALPORT_H
+#define NATIVESERIALPORT_H
+
+#include <atomic>
+#include <QByteArray>
+#include <QIODevice>
+#include <QMutex>
+#include <QSerialPort>
+#include <QThread>
+#include <QWaitCondition>
+
+class PerfCounters;
+
+/**
+ * Serial port backend that talks to the tty directly (Linux only).
+ *
+ * Port is configured with termios and set to low latency mode. A
+ * reader thread waits on the port with epoll and reads in chunks of
+ * `readSize` into an internal buffer. `readyRead` is signaled once
+ * per batch of reads instead of once per small read, so readers see
+ * bigger chunks and the event loop wakes up less often.
+ *
+ * Mirrors the subset of `QSerialPort` interface used by the
+ * application. Settings can be changed while port is closed, they are
+ * applied when it's opened.
+ */
+class NativeSerialPort : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit NativeSerialPort(QObject* parent = 0);
+    ~NativeSerialPort();
+
+    /// Returns true if native backend is available on this platform
+    static bool isSupported();
+
+    void setPortName(QString name);
+    QString portName() const {return _portName;};
+
+    bool setBaudRate(qint32 baudRate);
+    qint32 baudRate() const {return _baudRate;};
+    bool setParity(QSerialPort::Parity parity);
+    QSerialPort::Parity parity() const {return _parity;};
+    bool setDataBits(QSerialPort::DataBits dataBits);
+    QSerialPort::DataBits dataBits() const {return _dataBits;};
+    bool setStopBits(QSerialPort::StopBits stopBits);
+    QSerialPort::StopBits stopBits() const {return _stopBits;};
+    bool setFlowControl(QSerialPort::FlowControl flowControl);
+
+    bool setDataTerminalReady(bool set);
+    bool setRequestToSend(bool set);
+    QSerialPort::PinoutSignals pinoutSignals();
+
+    /// Size of each read call in bytes
+    void setReadSize(unsigned size);
+    /**
+     * Maximum number of bytes buffered in user space. When buffer is
+     * full reader thread stops reading and bytes are left in kernel
+     * buffer.
+     */
+    void setBufferSize(unsigned size);
+
+    /// Sets the performance counters for reads, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override {return true;};
+    qint64 bytesAvailable() const override;
+
+signals:
+    void errorOccurred(QSerialPort::SerialPortError error);
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QString _portName;
+    qint32 _baudRate;
+    QSerialPort::Parity _parity;
+    QSerialPort::DataBits _dataBits;
+    QSerialPort::StopBits _stopBits;
+    QSerialPort::FlowControl _flowControl;
+    unsigned readSize;
+    std::atomic<unsigned> bufferSize;
+    PerfCounters* perfCounters;
+
+    int fd;                     ///< port file descriptor, -1 if closed
+    int epollFd;
+    int stopFd;                 ///< eventfd to wake up reader thread on close
+    QThread* readerThread;
+
+    /// Data read by the reader thread, protected by `bufferLock`
+    mutable QMutex bufferLock;
+    QByteArray buffer;
+    int bufferHead;             ///< start of unread data in `buffer`
+    /// Signaled when reader consumes data or port is closing
+    QWaitCondition spaceAvailable;
+    std::atomic<bool> stopRequested;
+    /// Set when a `readyRead` is queued but not yet delivered
+    std::atomic<bool> notifyPending;
+
+    /// Applies settings to the open port, returns false on error
+    bool applySettings();
+    /// Sets or clears a modem control line
+    bool setModemLine(int line, bool set);
+    /// Sets `errorString`, errors are reported with `errorOccurred`
+    void setError(QString message);
+    /// Closes all file descriptors
+    void closeFds();
+    /// Reader thread main loop
+    void readLoop();
+
+private slots:
+    /// Delivered in main thread after reader thread appends data
+    void onDataArrived();
+    void onReadFailed();
+};
+
+#endif // NATIVESERIALPORT_H
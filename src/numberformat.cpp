@@ -30,7 +30,11 @@ QMap<NumberFormat, QString> mapping({
         {NumberFormat_int32, "int32"},
         {NumberFormat_float, "float"},
         {NumberFormat_double, "double"},
-        {NumberFormat_pad, "pad"}
+        {NumberFormat_pad, "pad"},
+        {NumberFormat_uint24, "uint24"},
+        {NumberFormat_int24, "int24"},
+        {NumberFormat_uint12p, "uint12p"},
+        {NumberFormat_uint10p, "uint10p"}
     });
 
 QString numberFormatToStr(NumberFormat nf)
@@ -42,3 +46,45 @@ NumberFormat strToNumberFormat(QString str)
 {
     return mapping.key(str, NumberFormat_INVALID);
 }
+
+unsigned numberFormatSize(NumberFormat nf)
+{
+    switch (nf)
+    {
+        case NumberFormat_uint8:
+        case NumberFormat_int8:
+            return 1;
+        case NumberFormat_uint16:
+        case NumberFormat_int16:
+            return 2;
+        case NumberFormat_uint24:
+        case NumberFormat_int24:
+            return 3;
+        case NumberFormat_uint32:
+        case NumberFormat_int32:
+        case NumberFormat_float:
+            return 4;
+        case NumberFormat_double:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+unsigned numberFormatBits(NumberFormat nf)
+{
+    switch (nf)
+    {
+        case NumberFormat_uint12p:
+            return 12;
+        case NumberFormat_uint10p:
+            return 10;
+        default:
+            return numberFormatSize(nf) * 8;
+    }
+}
+
+bool isPackedFormat(NumberFormat nf)
+{
+    return nf == NumberFormat_uint12p || nf == NumberFormat_uint10p;
+}
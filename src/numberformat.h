@@ -33,6 +33,10 @@ enum NumberFormat
     NumberFormat_float,
     NumberFormat_double,
     NumberFormat_pad,
+    NumberFormat_uint24,
+    NumberFormat_int24,
+    NumberFormat_uint12p, ///< 12 bit, 2 values packed in 3 bytes
+    NumberFormat_uint10p, ///< 10 bit, 4 values packed in 5 bytes
     NumberFormat_INVALID ///< used for error cases
 };
 
@@ -42,4 +46,13 @@ QString numberFormatToStr(NumberFormat nf);
 /// Convert string to `NumberFormat`
 NumberFormat strToNumberFormat(QString str);
 
+/// Size of a number in bytes, 0 for pad (variable), packed formats and invalid
+unsigned numberFormatSize(NumberFormat nf);
+
+/// Number of bits of a number, 0 for pad and invalid
+unsigned numberFormatBits(NumberFormat nf);
+
+/// Returns true if numbers are not byte aligned, see `packedformat.h`
+bool isPackedFormat(NumberFormat nf);
+
 #endif // NUMBERFORMAT_H
@@ -29,12 +29,16 @@ NumberFormatBox::NumberFormatBox(QWidget *parent) :
     // setup buttons
     buttonGroup.addButton(ui->rbUint8,  NumberFormat_uint8);
     buttonGroup.addButton(ui->rbUint16, NumberFormat_uint16);
+    buttonGroup.addButton(ui->rbUint24, NumberFormat_uint24);
     buttonGroup.addButton(ui->rbUint32, NumberFormat_uint32);
     buttonGroup.addButton(ui->rbInt8,   NumberFormat_int8);
     buttonGroup.addButton(ui->rbInt16,  NumberFormat_int16);
+    buttonGroup.addButton(ui->rbInt24,  NumberFormat_int24);
     buttonGroup.addButton(ui->rbInt32,  NumberFormat_int32);
     buttonGroup.addButton(ui->rbFloat,  NumberFormat_float);
     buttonGroup.addButton(ui->rbDouble,  NumberFormat_double);
+    buttonGroup.addButton(ui->rbUint12p, NumberFormat_uint12p);
+    buttonGroup.addButton(ui->rbUint10p, NumberFormat_uint10p);
     buttonGroup.addButton(ui->rbPad,  NumberFormat_pad);
 
     connect(&buttonGroup, &QButtonGroup::idToggled,
@@ -68,6 +72,11 @@ void NumberFormatBox::setSelection(NumberFormat nf)
     buttonGroup.button(nf)->setChecked(true);
 }
 
+void NumberFormatBox::setFormatVisible(NumberFormat nf, bool visible)
+{
+    buttonGroup.button(nf)->setVisible(visible);
+}
+
 unsigned NumberFormatBox::padSize() const
 {
     return ui->spPadSize->value();
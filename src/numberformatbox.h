@@ -41,6 +41,9 @@ public:
     NumberFormat currentSelection();
     /// change the currently selected number format
     void setSelection(NumberFormat nf);
+    /// Shows or hides the option for a number format. Used when a
+    /// reader doesn't support a format.
+    void setFormatVisible(NumberFormat nf, bool visible);
     /// returns the pad size (only relevant when NumberFormat_pad is selected)
     unsigned padSize() const;
     /// set the pad size
@@ -0,0 +1,123 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <numeric>
+
+#include "packedformat.h"
+
+/// Reads a group of `Bytes` bytes as a single integer
+template<unsigned Bytes, bool BigEndian>
+static inline quint64 readGroup(const uchar* src)
+{
+    quint64 word = 0;
+    for (unsigned b = 0; b < Bytes; b++)
+    {
+        if (BigEndian)
+        {
+            word = (word << 8) | src[b];
+        }
+        else
+        {
+            word |= quint64(src[b]) << (8 * b);
+        }
+    }
+    return word;
+}
+
+/// Unpacks groups of `N` values, `Bits` bits each
+template<unsigned Bits, unsigned N, bool BigEndian>
+static void unpack(const uchar* src, unsigned numGroups, SamplePack& samples, unsigned index)
+{
+    const unsigned groupBytes = Bits * N / 8;
+    const quint64 mask = (quint64(1) << Bits) - 1;
+    unsigned nc = samples.numChannels();
+
+    // single channel; values go to consecutive samples
+    if (nc == 1)
+    {
+        double* dst = samples.data(0) + index;
+        for (unsigned g = 0; g < numGroups; g++)
+        {
+            quint64 word = readGroup<groupBytes, BigEndian>(src + g * groupBytes);
+            for (unsigned v = 0; v < N; v++)
+            {
+                unsigned shift = BigEndian ? (N - 1 - v) * Bits : v * Bits;
+                dst[g * N + v] = double((word >> shift) & mask);
+            }
+        }
+        return;
+    }
+
+    unsigned ci = 0;
+    unsigned si = index;
+    for (unsigned g = 0; g < numGroups; g++)
+    {
+        quint64 word = readGroup<groupBytes, BigEndian>(src + g * groupBytes);
+        for (unsigned v = 0; v < N; v++)
+        {
+            unsigned shift = BigEndian ? (N - 1 - v) * Bits : v * Bits;
+            samples.data(ci)[si] = double((word >> shift) & mask);
+            if (++ci == nc)
+            {
+                ci = 0;
+                si++;
+            }
+        }
+    }
+}
+
+unsigned packedGroupValues(NumberFormat nf)
+{
+    switch (nf)
+    {
+        case NumberFormat_uint12p: return 2;
+        case NumberFormat_uint10p: return 4;
+        default: return 1;
+    }
+}
+
+unsigned packedGroupBytes(NumberFormat nf)
+{
+    return packedGroupValues(nf) * numberFormatBits(nf) / 8;
+}
+
+unsigned packedSetsPerPackage(NumberFormat nf, unsigned numChannels)
+{
+    unsigned n = packedGroupValues(nf);
+    return n / std::gcd(n, numChannels);
+}
+
+void unpackToChannels(NumberFormat nf, const uchar* src, unsigned numGroups,
+                      bool bigEndian, SamplePack& samples, unsigned index)
+{
+    switch (nf)
+    {
+        case NumberFormat_uint12p:
+            if (bigEndian) unpack<12, 2, true>(src, numGroups, samples, index);
+            else unpack<12, 2, false>(src, numGroups, samples, index);
+            break;
+        case NumberFormat_uint10p:
+            if (bigEndian) unpack<10, 4, true>(src, numGroups, samples, index);
+            else unpack<10, 4, false>(src, numGroups, samples, index);
+            break;
+        default:
+            Q_ASSERT(false);
+            break;
+    }
+}
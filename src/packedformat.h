@@ -0,0 +1,60 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PACKEDFORMAT_H
+#define PACKEDFORMAT_H
+
+#include <QtGlobal>
+
+#include "numberformat.h"
+#include "samplepack.h"
+
+/*
+ * Bit packed number formats.
+ *
+ * Values are packed into groups that are a whole number of bytes; 2
+ * 12-bit values in 3 bytes or 4 10-bit values in 5 bytes. A group is
+ * read as a single integer in selected endianness. With little endian
+ * first value is in the lowest bits, with big endian in the highest
+ * bits. Either way the stream is a continuous bit stream, values are
+ * not aligned to sample sets or channels.
+ */
+
+/// Number of values in a group, 1 for formats that aren't packed
+unsigned packedGroupValues(NumberFormat nf);
+
+/// Size of a group in bytes
+unsigned packedGroupBytes(NumberFormat nf);
+
+/**
+ * Smallest number of sample sets that fills a whole number of groups.
+ * Data should be read in multiples of this.
+ */
+unsigned packedSetsPerPackage(NumberFormat nf, unsigned numChannels);
+
+/**
+ * Unpacks `numGroups` groups at `src` into `samples`. Values are
+ * distributed to channels in order starting from channel 0 of sample
+ * `index`. Number of values should be a multiple of the number of
+ * channels.
+ */
+void unpackToChannels(NumberFormat nf, const uchar* src, unsigned numGroups,
+                      bool bigEndian, SamplePack& samples, unsigned index = 0);
+
+#endif // PACKEDFORMAT_H
@@ -0,0 +1,88 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "perfcounters.h"
+
+PerfCounters::PerfCounters() :
+    readerNs(0), decodeErrors(0), syncLosses(0),
+    replots(0), replotNs(0), paints(0),
+    portReads(0), portWakeups(0), portBytes(0),
+    replotMaxNs(0), deviceQueue(0), bufferBytesPerChannel(0)
+{
+    lastReaderNs = 0;
+    lastReplots = 0;
+    lastReplotNs = 0;
+    lastPaints = 0;
+    lastPortReads = 0;
+    lastPortWakeups = 0;
+    lastPortBytes = 0;
+    timer.start();
+}
+
+void PerfCounters::setMax(std::atomic<qint64>& gauge, qint64 value)
+{
+    qint64 current = gauge.load(std::memory_order_relaxed);
+    while (value > current &&
+           !gauge.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+void PerfCounters::addReplot(qint64 ns)
+{
+    inc(replots);
+    inc(replotNs, ns);
+    setMax(replotMaxNs, ns);
+}
+
+PerfCounters::Rates PerfCounters::takeRates()
+{
+    double elapsed = timer.nsecsElapsed();
+    timer.restart();
+
+    quint64 _readerNs = readerNs.load(std::memory_order_relaxed);
+    quint64 _replots = replots.load(std::memory_order_relaxed);
+    quint64 _replotNs = replotNs.load(std::memory_order_relaxed);
+    quint64 _paints = paints.load(std::memory_order_relaxed);
+    quint64 _portReads = portReads.load(std::memory_order_relaxed);
+    quint64 _portWakeups = portWakeups.load(std::memory_order_relaxed);
+    quint64 _portBytes = portBytes.load(std::memory_order_relaxed);
+
+    Rates r;
+    quint64 numReplots = _replots - lastReplots;
+    r.fps = elapsed > 0 ? (_paints - lastPaints) * 1e9 / elapsed : 0;
+    r.replotAvgNs = numReplots ? double(_replotNs - lastReplotNs) / numReplots : 0;
+    r.replotMaxNs = replotMaxNs.exchange(0, std::memory_order_relaxed);
+    r.readerCpu = elapsed > 0 ? (_readerNs - lastReaderNs) / elapsed : 0;
+    r.decodeErrors = decodeErrors.load(std::memory_order_relaxed);
+    r.syncLosses = syncLosses.load(std::memory_order_relaxed);
+    r.deviceQueue = deviceQueue.load(std::memory_order_relaxed);
+    r.bufferBytesPerChannel = bufferBytesPerChannel.load(std::memory_order_relaxed);
+    quint64 numWakeups = _portWakeups - lastPortWakeups;
+    r.portReadsPerSec = elapsed > 0 ? (_portReads - lastPortReads) * 1e9 / elapsed : 0;
+    r.bytesPerWakeup = numWakeups ? double(_portBytes - lastPortBytes) / numWakeups : 0;
+
+    lastReaderNs = _readerNs;
+    lastReplots = _replots;
+    lastReplotNs = _replotNs;
+    lastPaints = _paints;
+    lastPortReads = _portReads;
+    lastPortWakeups = _portWakeups;
+    lastPortBytes = _portBytes;
+
+    return r;
+}
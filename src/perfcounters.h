@@ -0,0 +1,102 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <atomic>
+#include <QtGlobal>
+#include <QElapsedTimer>
+
+/**
+ * Cheap counters updated by readers, `Stream` and `PlotManager`.
+ * Counters only increase, reader of the counters calculates rates
+ * from the differences (see `PerfCounters::takeRates()`).
+ *
+ * All updates are relaxed atomic operations so that they can be
+ * updated from other threads as well.
+ */
+class PerfCounters
+{
+public:
+    /// Rates calculated over the period between two `takeRates()` calls
+    struct Rates
+    {
+        double fps;                 ///< plot canvas paints per second
+        double replotAvgNs;         ///< average duration of a replot
+        double replotMaxNs;         ///< longest replot in the period
+        double readerCpu;           ///< time spent in readers, 0-1
+        quint64 decodeErrors;       ///< total since start
+        quint64 syncLosses;         ///< total since start
+        qint64 deviceQueue;         ///< bytes waiting in device buffer
+        qint64 bufferBytesPerChannel;
+        double portReadsPerSec;     ///< read calls on port, native backend only
+        double bytesPerWakeup;      ///< average bytes read per port wake up
+    };
+
+    PerfCounters();
+
+    // counters
+    std::atomic<quint64> readerNs;
+    std::atomic<quint64> decodeErrors;
+    std::atomic<quint64> syncLosses;
+    std::atomic<quint64> replots;
+    std::atomic<quint64> replotNs;
+    std::atomic<quint64> paints;
+    std::atomic<quint64> portReads;
+    std::atomic<quint64> portWakeups;
+    std::atomic<quint64> portBytes;
+
+    // gauges
+    std::atomic<qint64> replotMaxNs;  ///< reset by `takeRates()`
+    std::atomic<qint64> deviceQueue;
+    std::atomic<qint64> bufferBytesPerChannel;
+
+    static void inc(std::atomic<quint64>& counter, quint64 n = 1)
+    {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    };
+
+    static void set(std::atomic<qint64>& gauge, qint64 value)
+    {
+        gauge.store(value, std::memory_order_relaxed);
+    };
+
+    /// Sets gauge to `value` if it's bigger
+    static void setMax(std::atomic<qint64>& gauge, qint64 value);
+
+    /// Records a replot duration
+    void addReplot(qint64 ns);
+
+    /// Calculates rates since last call. Should be called from a
+    /// single thread.
+    Rates takeRates();
+
+private:
+    QElapsedTimer timer;
+    quint64 lastReaderNs;
+    quint64 lastReplots;
+    quint64 lastReplotNs;
+    quint64 lastPaints;
+    quint64 lastPortReads;
+    quint64 lastPortWakeups;
+    quint64 lastPortBytes;
+};
+
+#endif // PERFCOUNTERS_H
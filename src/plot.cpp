@@ -23,13 +23,20 @@
 #include <qwt_symbol.h>
 #include <qwt_plot_curve.h>
 #include <qwt_scale_map.h>
+#include <QPainter>
 #include <math.h>
+#include <string.h>
 #include <algorithm>
 
 #include "plot.h"
+#include "latencytracer.h"
+#include "perfcounters.h"
 
 static const int SYMBOL_SHOW_AT_WIDTH = 5;
 static const int SYMBOL_SIZE_MAX = 7;
+/// Extra pixels redrawn at the edge of the scrolled region, so that
+/// line joins and antialiasing of the previous part are covered
+static const int CACHE_EDGE_MARGIN = 2;
 
 Plot::Plot(QWidget* parent) :
     QwtPlot(parent),
@@ -41,6 +48,14 @@ Plot::Plot(QWidget* parent) :
     numOfSamples = 1;
     plotWidth = 1;
     showSymbols = Plot::ShowSymbolsAuto;
+    latencyTracer = nullptr;
+    perfCounters = nullptr;
+    cachedRendering = false;
+    scrollable = false;
+    sampleCount = 0;
+    inCanvasPaint = false;
+    cacheSampleCount = 0;
+    cacheValid = false;
 
     QObject::connect(&zoomer, &Zoomer::unzoomed, this, &Plot::unzoomed);
 
@@ -96,6 +111,256 @@ void Plot::setDispChannels(QVector<const StreamChannel*> channels)
     zoomer.setDispChannels(channels);
 }
 
+void Plot::setLatencyTracer(LatencyTracer* tracer)
+{
+    latencyTracer = tracer;
+}
+
+void Plot::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+}
+
+void Plot::drawCanvas(QPainter* painter)
+{
+    inCanvasPaint = true;
+    QwtPlot::drawCanvas(painter);
+    inCanvasPaint = false;
+    if (latencyTracer != nullptr) latencyTracer->markPainted();
+    if (perfCounters != nullptr) PerfCounters::inc(perfCounters->paints);
+}
+
+void Plot::setCachedRendering(bool enabled)
+{
+    cachedRendering = enabled;
+    if (!enabled) curveCache = QImage();
+    invalidateCache();
+    replot();
+}
+
+void Plot::setSampleCount(quint64 count)
+{
+    scrollable = true;
+    sampleCount = count;
+}
+
+void Plot::invalidateCache()
+{
+    cacheValid = false;
+}
+
+std::function<void()> Plot::cacheRenderJob()
+{
+    if (!cachedRendering) return {};
+
+    // same as `QwtPlot::drawCanvas`, so that paint finds cache up to date
+    updateAxes();
+    QRectF canvasRect = canvas()->contentsRect();
+    qreal dpr = canvas()->devicePixelRatioF();
+    QVector<QwtScaleMap> maps(QwtAxis::AxisPositions);
+    for (int axis = 0; axis < QwtAxis::AxisPositions; axis++)
+    {
+        maps[axis] = canvasMap(axis);
+    }
+
+    return [this, canvasRect, maps, dpr]()
+    {
+        updateCurveCache(canvasRect, maps.constData(), dpr);
+    };
+}
+
+bool Plot::CurveState::operator==(const CurveState& other) const
+{
+    return item == other.item && color == other.color && width == other.width &&
+        symbol == other.symbol && antialiased == other.antialiased;
+}
+
+bool Plot::CacheKey::operator==(const CacheKey& other) const
+{
+    return size == other.size && dpr == other.dpr &&
+        xs1 == other.xs1 && xs2 == other.xs2 && xp1 == other.xp1 && xp2 == other.xp2 &&
+        ys1 == other.ys1 && ys2 == other.ys2 && yp1 == other.yp1 && yp2 == other.yp2 &&
+        curves == other.curves;
+}
+
+Plot::CacheKey Plot::makeCacheKey(const QRectF& canvasRect, const QwtScaleMap maps[],
+                                  qreal dpr) const
+{
+    CacheKey key;
+    key.size = (canvasRect.size() * dpr).toSize();
+    key.dpr = dpr;
+
+    auto& xMap = maps[QwtPlot::xBottom];
+    auto& yMap = maps[QwtPlot::yLeft];
+    key.xs1 = xMap.s1(); key.xs2 = xMap.s2(); key.xp1 = xMap.p1(); key.xp2 = xMap.p2();
+    key.ys1 = yMap.s1(); key.ys2 = yMap.s2(); key.yp1 = yMap.p1(); key.yp2 = yMap.p2();
+
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (!item->isVisible()) continue;
+        auto curve = static_cast<const QwtPlotCurve*>(item);
+        key.curves.append({item, curve->pen().color().rgba(), curve->pen().widthF(),
+                           curve->symbol(),
+                           item->testRenderHint(QwtPlotItem::RenderAntialiased)});
+    }
+
+    return key;
+}
+
+void Plot::drawItems(QPainter* painter, const QRectF& canvasRect,
+                     const QwtScaleMap maps[QwtAxis::AxisPositions]) const
+{
+    if (!cachedRendering || !inCanvasPaint)
+    {
+        QwtPlot::drawItems(painter, canvasRect, maps);
+        return;
+    }
+
+    // items are sorted by z, cached curves are drawn in place of the first curve
+    bool curvesDrawn = false;
+    for (auto item : itemList())
+    {
+        if (!item->isVisible()) continue;
+
+        if (item->rtti() == QwtPlotItem::Rtti_PlotCurve)
+        {
+            if (!curvesDrawn)
+            {
+                updateCurveCache(canvasRect, maps, canvas()->devicePixelRatioF());
+                painter->drawImage(canvasRect.topLeft(), curveCache);
+                curvesDrawn = true;
+            }
+            continue;
+        }
+
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing,
+                               item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(painter, maps[item->xAxis()], maps[item->yAxis()], canvasRect);
+        painter->restore();
+    }
+}
+
+void Plot::updateCurveCache(const QRectF& canvasRect, const QwtScaleMap maps[],
+                            qreal dpr) const
+{
+    CacheKey key = makeCacheKey(canvasRect, maps, dpr);
+    auto& xMap = maps[QwtPlot::xBottom];
+
+    // width of a sample in device pixels, all curves share the same X
+    double sampleWidth = 0;
+    for (auto& cs : key.curves)
+    {
+        auto data = static_cast<const QwtPlotCurve*>(cs.item)->data();
+        size_t n = data->size();
+        if (n < 2) continue;
+        double x0 = data->sample(0).x();
+        double step = (data->sample(n-1).x() - x0) / (n-1);
+        sampleWidth = (xMap.transform(x0 + step) - xMap.transform(x0)) * dpr;
+        break;
+    }
+
+    bool full = !cacheValid || !(key == cacheKey);
+    quint64 newSamples = 0;
+    int shift = 0;              // in device pixels
+    int strip = 0;              // width of the region to redraw at right
+    if (!full && scrollable && sampleCount != cacheSampleCount)
+    {
+        if (sampleCount < cacheSampleCount || sampleWidth <= 0)
+        {
+            full = true;        // cleared, or X isn't increasing to the right
+        }
+        else
+        {
+            newSamples = sampleCount - cacheSampleCount;
+            // rounded from absolute positions so that errors don't accumulate
+            qint64 s = llround(sampleCount * sampleWidth) - llround(cacheSampleCount * sampleWidth);
+            qreal maxPen = 0;
+            for (auto& cs : key.curves) maxPen = std::max(maxPen, cs.width);
+            double stripWidth = (newSamples + 1) * sampleWidth +
+                (maxPen + symbolSize) * dpr + CACHE_EDGE_MARGIN;
+
+            if (s + stripWidth >= key.size.width())
+            {
+                full = true;
+            }
+            else
+            {
+                shift = s;
+                strip = ceil(stripWidth);
+            }
+        }
+    }
+
+    if (full)
+    {
+        if (curveCache.size() != key.size)
+        {
+            curveCache = QImage(key.size, QImage::Format_ARGB32_Premultiplied);
+        }
+        curveCache.setDevicePixelRatio(dpr);
+        curveCache.fill(Qt::transparent);
+
+        QPainter painter(&curveCache);
+        painter.translate(-canvasRect.topLeft());
+        drawCurves(&painter, canvasRect, maps, NAN);
+    }
+    else if (newSamples)
+    {
+        // shift left and clear the region to be redrawn
+        int width = curveCache.width();
+        const int bpp = 4;
+        for (int y = 0; y < curveCache.height(); y++)
+        {
+            uchar* line = curveCache.scanLine(y);
+            if (shift) memmove(line, line + shift * bpp, (width - shift) * bpp);
+            memset(line + (width - strip) * bpp, 0, strip * bpp);
+        }
+
+        QPainter painter(&curveCache);
+        painter.translate(-canvasRect.topLeft());
+        QRectF stripRect(canvasRect.right() - strip / dpr, canvasRect.top(),
+                         strip / dpr, canvasRect.height());
+        painter.setClipRect(stripRect);
+        drawCurves(&painter, canvasRect, maps, xMap.invTransform(stripRect.left()));
+    }
+
+    cacheKey = key;
+    cacheSampleCount = sampleCount;
+    cacheValid = true;
+}
+
+void Plot::drawCurves(QPainter* painter, const QRectF& canvasRect,
+                      const QwtScaleMap maps[], double fromX) const
+{
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (!item->isVisible()) continue;
+        auto curve = static_cast<const QwtPlotCurve*>(item);
+
+        // X is linear, find the first sample to draw without searching
+        int from = 0;
+        size_t n = curve->dataSize();
+        if (!std::isnan(fromX) && n >= 2)
+        {
+            double x0 = curve->sample(0).x();
+            double step = (curve->sample(n-1).x() - x0) / (n-1);
+            if (step > 0)
+            {
+                from = int(std::max(0., floor((fromX - x0) / step) - 1));
+                from = std::min(from, int(n-1));
+            }
+        }
+
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing,
+                               item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        curve->drawSeries(painter, maps[item->xAxis()], maps[item->yAxis()],
+                          canvasRect, from, -1);
+        painter->restore();
+    }
+}
+
 void Plot::setYAxis(bool autoScaled, double yAxisMin, double yAxisMax)
 {
     this->isAutoScaled = autoScaled;
@@ -310,6 +575,9 @@ void Plot::calcSymbolSize()
 
 void Plot::updateSymbols()
 {
+    // new symbols may be allocated at the same address as the old ones
+    invalidateCache();
+
     const QwtPlotItemList curves = itemList( QwtPlotItem::Rtti_PlotCurve );
 
     if (curves.size() > 0)
@@ -324,6 +592,8 @@ void Plot::updateSymbols()
                                        canvasBackground(),
                                        curve->pen(),
                                        QSize(symbolSize, symbolSize));
+                // symbol cache is a `QPixmap`, can't be used off GUI thread
+                symbol->setCachePolicy(QwtSymbol::NoCache);
             }
             curve->setSymbol(symbol);
         }
@@ -339,6 +609,7 @@ void Plot::resizeEvent(QResizeEvent * event)
 void Plot::setNumOfSamples(unsigned value)
 {
     numOfSamples = value;
+    invalidateCache();
     onXScaleChanged();
 }
 
@@ -23,6 +23,9 @@
 #include <QColor>
 #include <QList>
 #include <QAction>
+#include <QImage>
+#include <QVector>
+#include <functional>
 #include <qwt_plot.h>
 #include <qwt_plot_grid.h>
 #include <qwt_plot_shapeitem.h>
@@ -33,6 +36,9 @@
 #include "scalezoomer.h"
 #include "plotsnapshotoverlay.h"
 
+class LatencyTracer;
+class PerfCounters;
+
 class Plot : public QwtPlot
 {
     Q_OBJECT
@@ -53,6 +59,36 @@ public:
     /// Set displayed channels for value tracking (can be null)
     void setDispChannels(QVector<const StreamChannel*> channels);
 
+    /// Latency tracer to notify when canvas is painted, can be `nullptr`
+    void setLatencyTracer(LatencyTracer* tracer);
+    /// Performance counters to count paints, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
+
+    /**
+     * Enables keeping rendered curves in an image. When only new
+     * samples are added since the last paint, image is shifted and
+     * only the newly exposed part is drawn. Any change of scales,
+     * size or curve appearance causes a full redraw.
+     */
+    void setCachedRendering(bool enabled);
+    /**
+     * Sets the total number of samples added to displayed buffers,
+     * used to find how much the curves scrolled since last paint.
+     * Should be called before each replot of a streaming plot. Plots
+     * that don't call this (snapshots) are never scrolled.
+     */
+    void setSampleCount(quint64 count);
+    /// Forces a full redraw of cached curves at next paint
+    void invalidateCache();
+    /**
+     * Updates axes and returns a job that brings the curve cache up
+     * to date, so that next paint only draws the image. Job can run
+     * on another thread, meanwhile this plot, its curves and their
+     * data must not be modified. Returns an empty function if cached
+     * rendering is disabled.
+     */
+    std::function<void()> cacheRenderJob();
+
 public slots:
     void showGrid(bool show = true);
     void showMinorGrid(bool show = true);
@@ -81,6 +117,10 @@ protected:
     /// update the display of symbols depending on `symbolSize`
     void updateSymbols();
 
+    void drawCanvas(QPainter* painter) override;
+    void drawItems(QPainter* painter, const QRectF& canvasRect,
+                   const QwtScaleMap maps[QwtAxis::AxisPositions]) const override;
+
 private:
     bool isAutoScaled;
     double yMin, yMax;
@@ -96,6 +136,53 @@ private:
     QwtPlotTextLabel demoIndicator;
     QwtPlotTextLabel noChannelIndicator;
     ShowSymbols showSymbols;
+    LatencyTracer* latencyTracer;
+    PerfCounters* perfCounters;
+
+    /// Appearance of a curve, cached image depends on it
+    struct CurveState
+    {
+        const QwtPlotItem* item;
+        QRgb color;
+        qreal width;
+        const void* symbol;
+        bool antialiased;
+
+        bool operator==(const CurveState& other) const;
+    };
+
+    /// Parameters that cached image depends on, except the data
+    struct CacheKey
+    {
+        QSize size;             ///< in device pixels
+        qreal dpr;
+        double xs1, xs2, xp1, xp2;
+        double ys1, ys2, yp1, yp2;
+        QVector<CurveState> curves; ///< visible curves only
+
+        bool operator==(const CacheKey& other) const;
+    };
+
+    bool cachedRendering;
+    bool scrollable;            ///< set when `setSampleCount` is used
+    quint64 sampleCount;
+    bool inCanvasPaint;         ///< cache is only used when painting canvas, not exporting
+    mutable QImage curveCache;  ///< only curves, on transparent background
+    mutable CacheKey cacheKey;
+    mutable quint64 cacheSampleCount;
+    mutable bool cacheValid;
+
+    CacheKey makeCacheKey(const QRectF& canvasRect, const QwtScaleMap maps[],
+                          qreal dpr) const;
+    /// Brings `curveCache` up to date, drawing as little as possible
+    void updateCurveCache(const QRectF& canvasRect, const QwtScaleMap maps[],
+                          qreal dpr) const;
+    /**
+     * Draws visible curves. If `fromX` isn't NaN, only the samples
+     * after `fromX` (and the one before it) are drawn.
+     */
+    void drawCurves(QPainter* painter, const QRectF& canvasRect,
+                    const QwtScaleMap maps[], double fromX) const;
 
     void resetAxes();
     void resizeEvent(QResizeEvent * event);
@@ -25,6 +25,8 @@
 
 #include "plot.h"
 #include "plotmanager.h"
+#include "latencytracer.h"
+#include "perfcounters.h"
 #include "setting_defines.h"
 
 PlotManager::PlotManager(QWidget* plotArea, PlotMenu* menu,
@@ -95,6 +97,8 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
     emptyPlot = NULL;
     inScaleSync = false;
     lineThickness = 1;
+    latencyTracer = nullptr;
+    perfCounters = nullptr;
 
     // initalize layout and single widget
     isMulti = false;
@@ -111,6 +115,8 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
             this, &PlotManager::darkBackground);
     connect(&menu->showMultiAction, &QAction::toggled,
             this, &PlotManager::setMulti);
+    connect(&menu->cachedRenderingAction, &QAction::toggled,
+            this, &PlotManager::setCachedRendering);
     connect(&menu->unzoomAction, &QAction::triggered,
             this, &PlotManager::unzoom);
 
@@ -186,6 +192,7 @@ void PlotManager::onChannelInfoChanged(const QModelIndex &topLeft,
         // replot only updated widgets
         if (isMulti)
         {
+            plotWidgets[ci]->invalidateCache();
             plotWidgets[ci]->updateSymbols(); // required for color change
             plotWidgets[ci]->updateLegend(curves[ci]);
             plotWidgets[ci]->setVisible(visible);
@@ -202,6 +209,7 @@ void PlotManager::onChannelInfoChanged(const QModelIndex &topLeft,
     // replot single widget
     if (!isMulti)
     {
+        plotWidgets[0]->invalidateCache();
         plotWidgets[0]->updateSymbols();
         plotWidgets[0]->updateLegend();
         replot();
@@ -335,8 +343,11 @@ Plot* PlotManager::addPlotWidget()
     plot->showLegend(_menu->showLegendAction.isChecked());
     plot->setLegendPosition(_menu->legendPosition());
     plot->setSymbols(_menu->showSymbols());
+    plot->setCachedRendering(_menu->cachedRenderingAction.isChecked());
 
     plot->showDemoIndicator(isDemoShown);
+    plot->setLatencyTracer(latencyTracer);
+    plot->setPerfCounters(perfCounters);
     plot->setYAxis(_autoScaled, _yMin, _yMax);
     plot->setNumOfSamples(_numOfSamples);
 
@@ -368,12 +379,14 @@ void PlotManager::syncScales()
 
     // find maximum extent
     double maxExtent = 0;
+    QVector<double> oldExtents;
     for (auto plot : plotWidgets)
     {
-        if (!plot->isVisible()) continue;
-
         QwtScaleWidget* scaleWidget = plot->axisWidget(QwtPlot::yLeft);
         QwtScaleDraw* scaleDraw = scaleWidget->scaleDraw();
+        oldExtents.append(scaleDraw->minimumExtent());
+        if (!plot->isVisible()) continue;
+
         scaleDraw->setMinimumExtent(0);
 
         const double extent = scaleDraw->extent(scaleWidget->font());
@@ -381,17 +394,17 @@ void PlotManager::syncScales()
             maxExtent = extent;
     }
 
-    // apply maximum extent
-    for (auto plot : plotWidgets)
+    // apply maximum extent, relayout and replot only the plots that changed
+    for (int i = 0; i < plotWidgets.size(); i++)
     {
+        auto plot = plotWidgets[i];
         QwtScaleWidget* scaleWidget = plot->axisWidget(QwtPlot::yLeft);
         scaleWidget->scaleDraw()->setMinimumExtent(maxExtent);
-        scaleWidget->updateGeometry();
-    }
-
-    for (auto plot : plotWidgets)
-    {
-        plot->replot();
+        if (oldExtents[i] != maxExtent)
+        {
+            scaleWidget->updateGeometry();
+            plot->replot();
+        }
     }
 
     inScaleSync = false;
@@ -399,7 +412,7 @@ void PlotManager::syncScales()
 
 void PlotManager::addCurve(QString title, const XFrameBuffer* xBuf, const FrameBuffer* yBuf)
 {
-    auto curve = new QwtPlotCurve(title);
+    auto curve = new FrameBufferCurve(title);
     auto series = new FrameBufferSeries(xBuf, yBuf);
     curve->setSamples(series);
     _addCurve(curve);
@@ -490,11 +503,45 @@ Plot* PlotManager::plotWidget(unsigned curveIndex)
 
 void PlotManager::replot()
 {
+    qint64 start = perfCounters != nullptr ? LatencyTracer::now() : 0;
+
+    for (auto plot : plotWidgets)
+    {
+        // X is given by the stream, curves can be scrolled
+        if (_stream != nullptr && !_stream->hasX())
+        {
+            plot->setSampleCount(_stream->sampleCount());
+        }
+    }
+
+    if (isMulti) renderParallel();
+
+    // Note: scales are synced when Y axis limits change, see `addPlotWidget`
     for (auto plot : plotWidgets)
     {
         plot->replot();
     }
-    if (isMulti) syncScales();
+
+    if (perfCounters != nullptr) perfCounters->addReplot(LatencyTracer::now() - start);
+}
+
+void PlotManager::renderParallel()
+{
+    QList<std::function<void()>> jobs;
+    for (auto plot : plotWidgets)
+    {
+        if (!plot->isVisible()) continue;
+        auto job = plot->cacheRenderJob();
+        if (job) jobs.append(job);
+    }
+    if (jobs.size() < 2) return; // nothing to gain
+
+    // data is only modified on this thread, it's safe while we wait
+    for (auto& job : jobs)
+    {
+        renderPool.start(job);
+    }
+    renderPool.waitForDone();
 }
 
 void PlotManager::showGrid(bool show)
@@ -563,6 +610,14 @@ void PlotManager::setSymbols(Plot::ShowSymbols shown)
     }
 }
 
+void PlotManager::setCachedRendering(bool enabled)
+{
+    for (auto plot : plotWidgets)
+    {
+        plot->setCachedRendering(enabled);
+    }
+}
+
 void PlotManager::setYAxis(bool autoScaled, double yAxisMin, double yAxisMax)
 {
     _autoScaled = autoScaled;
@@ -642,6 +697,24 @@ void PlotManager::setLineThickness(int thickness)
     replot();
 }
 
+void PlotManager::setLatencyTracer(LatencyTracer* tracer)
+{
+    latencyTracer = tracer;
+    for (auto plot : plotWidgets)
+    {
+        plot->setLatencyTracer(tracer);
+    }
+}
+
+void PlotManager::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+    for (auto plot : plotWidgets)
+    {
+        plot->setPerfCounters(counters);
+    }
+}
+
 void PlotManager::exportSvg(QString fileName) const
 {
     QString baseName, suffix;
@@ -27,6 +27,7 @@
 #include <QList>
 #include <QSettings>
 #include <QMenu>
+#include <QThreadPool>
 
 #include <qwt_plot_curve.h>
 #include "plot.h"
@@ -55,6 +56,10 @@ public:
     unsigned numOfCurves();
     /// export SVG
     void exportSvg (QString fileName) const;
+    /// Sets the latency tracer for plot widgets, can be `nullptr`
+    void setLatencyTracer(LatencyTracer* tracer);
+    /// Sets the performance counters, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
 
 public slots:
     /// Enable/Disable multiple plot display
@@ -98,7 +103,10 @@ private:
     double _plotWidth;
     Plot::ShowSymbols showSymbols;
     bool inScaleSync; ///< scaleSync is in progress
+    QThreadPool renderPool; ///< renders curves of multi plots in parallel
     int lineThickness;
+    LatencyTracer* latencyTracer;
+    PerfCounters* perfCounters;
 
     /// Common constructor
     void construct(QWidget* plotArea, PlotMenu* menu);
@@ -112,6 +120,8 @@ private:
     void _addCurve(QwtPlotCurve* curve);
     /// Check and make sure "no visible channels" text is shown
     void checkNoVisChannels();
+    /// Renders cached curves of visible plots on `renderPool`
+    void renderParallel();
 
 private slots:
     void showGrid(bool show = true);
@@ -121,6 +131,7 @@ private slots:
     void unzoom();
     void darkBackground(bool enabled = true);
     void setSymbols(Plot::ShowSymbols shown);
+    void setCachedRendering(bool enabled);
 
     void onNumChannelsChanged(unsigned value);
     void onChannelInfoChanged(const QModelIndex & topLeft,
@@ -31,6 +31,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction("&Dark Background", this),
     showLegendAction("&Legend", this),
     showMultiAction("Multi &Plot", this),
+    cachedRenderingAction("&Cached Rendering", this),
     setSymbolsAction("&Symbols", this),
     setSymbolsAutoAct("Show When &Zoomed", this),
     setSymbolsShowAct("Always &Show", this),
@@ -48,6 +49,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction.setToolTip("Enable Dark Plot Background");
     showLegendAction.setToolTip("Display the Legend on Plot");
     showMultiAction.setToolTip("Display All Channels Separately");
+    cachedRenderingAction.setToolTip("Keep rendered curves in an image and only draw the new samples");
     setSymbolsAction.setToolTip("Show/Hide symbols");
 
     showGridAction.setShortcut(QKeySequence("G"));
@@ -58,12 +60,14 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction.setCheckable(true);
     showLegendAction.setCheckable(true);
     showMultiAction.setCheckable(true);
+    cachedRenderingAction.setCheckable(true);
 
     showGridAction.setChecked(false);
     showMinorGridAction.setChecked(false);
     darkBackgroundAction.setChecked(false);
     showLegendAction.setChecked(true);
     showMultiAction.setChecked(false);
+    cachedRenderingAction.setChecked(true);
 
     // minor grid is only enabled when _major_ grid is enabled
     showMinorGridAction.setEnabled(false);
@@ -144,6 +148,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     addAction(&setLegendPosAction);
     addAction(&showMultiAction);
     addAction(&setSymbolsAction);
+    addAction(&cachedRenderingAction);
 }
 
 PlotMenu::PlotMenu(PlotViewSettings s, QWidget* parent) :
@@ -154,6 +159,7 @@ PlotMenu::PlotMenu(PlotViewSettings s, QWidget* parent) :
     darkBackgroundAction.setChecked(s.darkBackground);
     showLegendAction.setChecked(s.showLegend);
     showMultiAction.setChecked(s.showMulti);
+    cachedRenderingAction.setChecked(s.cachedRendering);
     switch (s.showSymbols)
     {
         case Plot::ShowSymbolsAuto:
@@ -177,6 +183,7 @@ PlotViewSettings PlotMenu::viewSettings() const
             darkBackgroundAction.isChecked(),
             showLegendAction.isChecked(),
             showMultiAction.isChecked(),
+            cachedRenderingAction.isChecked(),
             showSymbols()
         });
 }
@@ -210,6 +217,7 @@ void PlotMenu::saveSettings(QSettings* settings)
     settings->setValue(SG_Plot_MinorGrid, showMinorGridAction.isChecked());
     settings->setValue(SG_Plot_Legend, showLegendAction.isChecked());
     settings->setValue(SG_Plot_MultiPlot, showMultiAction.isChecked());
+    settings->setValue(SG_Plot_CachedRendering, cachedRenderingAction.isChecked());
 
     // save symbol option
     QString showSymbolsStr;
@@ -264,6 +272,8 @@ void PlotMenu::loadSettings(QSettings* settings)
         settings->value(SG_Plot_Legend, showLegendAction.isChecked()).toBool());
     showMultiAction.setChecked(
         settings->value(SG_Plot_MultiPlot, showMultiAction.isChecked()).toBool());
+    cachedRenderingAction.setChecked(
+        settings->value(SG_Plot_CachedRendering, cachedRenderingAction.isChecked()).toBool());
 
     // load symbol option
     QString showSymbolsStr = settings->value(SG_Plot_Symbols, QString()).toString();
@@ -22,6 +22,8 @@
 
 #include <QSerialPortInfo>
 #include <QKeySequence>
+#include <QHostAddress>
+#include <limits>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMap>
@@ -30,6 +32,7 @@
 #include "setting_defines.h"
 
 #define TBPORTLIST_MINWIDTH (200)
+#define TCP_CONNECT_TIMEOUT (3000) // ms
 
 // setting mappings
 const QMap<QSerialPort::Parity, QString> paritySettingMap({
@@ -38,7 +41,15 @@ const QMap<QSerialPort::Parity, QString> paritySettingMap({
         {QSerialPort::EvenParity, "even"},
     });
 
-PortControl::PortControl(QSerialPort* port, QWidget* parent) :
+const QMap<int, QString> sourceSettingMap({
+        {0, "serial"},
+        {1, "udp"},
+        {2, "tcp"},
+    });
+
+PortControl::PortControl(QSerialPort* port, NativeSerialPort* nativePort,
+                         QTcpSocket* tcpSocket, UdpDevice* udpDevice,
+                         QWidget* parent) :
     QWidget(parent),
     ui(new Ui::PortControl),
     portToolBar("Port Toolbar"),
@@ -51,6 +62,45 @@ PortControl::PortControl(QSerialPort* port, QWidget* parent) :
     connect(serialPort, &QSerialPort::errorOccurred,
             this, &PortControl::onPortError);
 
+    this->nativePort = nativePort;
+    connect(nativePort, &NativeSerialPort::errorOccurred,
+            this, &PortControl::onNativePortError);
+
+    // native backend settings
+    if (!NativeSerialPort::isSupported())
+    {
+        ui->cbNativeBackend->setVisible(false);
+        ui->lReadSize->setVisible(false);
+        ui->spReadSize->setVisible(false);
+        ui->lBufferSize->setVisible(false);
+        ui->spBufferSize->setVisible(false);
+    }
+    connect(ui->spBufferSize, QOverload<int>::of(&QSpinBox::valueChanged),
+            [this](int value)
+            {
+                this->nativePort->setBufferSize(value * 1024);
+                this->udpDevice->setBufferSize(value * 1024);
+            });
+
+    // network sources
+    this->tcpSocket = tcpSocket;
+    this->udpDevice = udpDevice;
+    networkOpen = false;
+    connect(tcpSocket, &QAbstractSocket::errorOccurred, [this]()
+            {
+                onNetworkError(this->tcpSocket);
+            });
+    connect(udpDevice, &UdpDevice::errorOccurred, [this]()
+            {
+                onNetworkError(this->udpDevice);
+            });
+    connect(ui->cbSource, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            [this](int)
+            {
+                updateSourceWidgets();
+            });
+    updateSourceWidgets();
+
     // setup actions
     openAction.setCheckable(true);
     openAction.setShortcut(QKeySequence("Ctrl+O"));
@@ -136,6 +186,10 @@ PortControl::PortControl(QSerialPort* port, QWidget* parent) :
                 {
                     serialPort->setDataTerminalReady(ui->ledDTR->isOn());
                 }
+                else if (this->nativePort->isOpen())
+                {
+                    this->nativePort->setDataTerminalReady(ui->ledDTR->isOn());
+                }
             });
 
     connect(ui->pbRTS, &QPushButton::clicked, [this]()
@@ -146,6 +200,10 @@ PortControl::PortControl(QSerialPort* port, QWidget* parent) :
                 {
                     serialPort->setRequestToSend(ui->ledRTS->isOn());
                 }
+                else if (this->nativePort->isOpen())
+                {
+                    this->nativePort->setRequestToSend(ui->ledRTS->isOn());
+                }
             });
 
     // setup pin update leds
@@ -207,6 +265,13 @@ void PortControl::_selectBaudRate(QString baudRate)
             qCritical() << "Can't set baud rate!";
         }
     }
+    else if (nativePort->isOpen())
+    {
+        if (!nativePort->setBaudRate(baudRate.toInt()))
+        {
+            qCritical() << "Can't set baud rate:" << nativePort->errorString();
+        }
+    }
 }
 
 void PortControl::selectParity(int parity)
@@ -218,6 +283,13 @@ void PortControl::selectParity(int parity)
             qCritical() << "Can't set parity option!";
         }
     }
+    else if (nativePort->isOpen())
+    {
+        if (!nativePort->setParity((QSerialPort::Parity) parity))
+        {
+            qCritical() << "Can't set parity option:" << nativePort->errorString();
+        }
+    }
 }
 
 void PortControl::selectDataBits(int dataBits)
@@ -229,6 +301,13 @@ void PortControl::selectDataBits(int dataBits)
             qCritical() << "Can't set numer of data bits!";
         }
     }
+    else if (nativePort->isOpen())
+    {
+        if (!nativePort->setDataBits((QSerialPort::DataBits) dataBits))
+        {
+            qCritical() << "Can't set number of data bits:" << nativePort->errorString();
+        }
+    }
 }
 
 void PortControl::selectStopBits(int stopBits)
@@ -240,6 +319,13 @@ void PortControl::selectStopBits(int stopBits)
             qCritical() << "Can't set number of stop bits!";
         }
     }
+    else if (nativePort->isOpen())
+    {
+        if (!nativePort->setStopBits((QSerialPort::StopBits) stopBits))
+        {
+            qCritical() << "Can't set number of stop bits:" << nativePort->errorString();
+        }
+    }
 }
 
 void PortControl::selectFlowControl(int flowControl)
@@ -251,17 +337,51 @@ void PortControl::selectFlowControl(int flowControl)
             qCritical() << "Can't set flow control option!";
         }
     }
+    else if (nativePort->isOpen())
+    {
+        if (!nativePort->setFlowControl((QSerialPort::FlowControl) flowControl))
+        {
+            qCritical() << "Can't set flow control option:" << nativePort->errorString();
+        }
+    }
 }
 
 void PortControl::togglePort()
 {
-    if (serialPort->isOpen())
+    if (isOpen())
     {
         pinUpdateTimer.stop();
-        serialPort->close();
-        qDebug() << "Closed port:" << serialPort->portName();
+        if (isNetworkOpen())
+        {
+            // cleared first, an error while closing shouldn't toggle again
+            networkOpen = false;
+            device()->close();
+            qDebug() << "Closed network source";
+        }
+        else
+        {
+            if (serialPort->isOpen())
+            {
+                serialPort->close();
+            }
+            else
+            {
+                nativePort->close();
+            }
+            qDebug() << "Closed port:" << serialPort->portName();
+        }
         emit portToggled(false);
     }
+    else if (ui->cbSource->currentIndex() != Source_Serial)
+    {
+        // errors while opening are reported synchronously, they are
+        // handled by `openNetwork` not by `onNetworkError`
+        if (openNetwork())
+        {
+            networkOpen = true;
+            emit portToggled(true);
+        }
+    }
     else
     {
         QString portName;
@@ -293,18 +413,27 @@ void PortControl::togglePort()
         serialPort->setPortName(ui->cbPortList->currentData(PortNameRole).toString());
 
         // open port
-        if (serialPort->open(QIODevice::ReadWrite))
+        if (ui->cbNativeBackend->isChecked() ?
+            openNativePort() : serialPort->open(QIODevice::ReadWrite))
         {
-            // set port settings
-            _selectBaudRate(ui->cbBaudRate->currentText());
-            selectParity((QSerialPort::Parity) parityButtons.checkedId());
-            selectDataBits((QSerialPort::DataBits) dataBitsButtons.checkedId());
-            selectStopBits((QSerialPort::StopBits) stopBitsButtons.checkedId());
-            selectFlowControl((QSerialPort::FlowControl) flowControlButtons.checkedId());
-
-            // set output signals
-            serialPort->setDataTerminalReady(ui->ledDTR->isOn());
-            serialPort->setRequestToSend(ui->ledRTS->isOn());
+            if (serialPort->isOpen())
+            {
+                // set port settings
+                _selectBaudRate(ui->cbBaudRate->currentText());
+                selectParity((QSerialPort::Parity) parityButtons.checkedId());
+                selectDataBits((QSerialPort::DataBits) dataBitsButtons.checkedId());
+                selectStopBits((QSerialPort::StopBits) stopBitsButtons.checkedId());
+                selectFlowControl((QSerialPort::FlowControl) flowControlButtons.checkedId());
+
+                // set output signals
+                serialPort->setDataTerminalReady(ui->ledDTR->isOn());
+                serialPort->setRequestToSend(ui->ledRTS->isOn());
+            }
+            else
+            {
+                nativePort->setDataTerminalReady(ui->ledDTR->isOn());
+                nativePort->setRequestToSend(ui->ledRTS->isOn());
+            }
 
             // update pin signals
             updatePinLeds();
@@ -314,7 +443,125 @@ void PortControl::togglePort()
             emit portToggled(true);
         }
     }
-    openAction.setChecked(serialPort->isOpen());
+    openAction.setChecked(isOpen());
+
+    // backend and source can only be changed while port is closed
+    updateSourceWidgets();
+}
+
+bool PortControl::openNetwork()
+{
+    QString host = ui->leNetHost->text().trimmed();
+    quint16 port = ui->spNetPort->value();
+
+    if (ui->cbSource->currentIndex() == Source_Udp)
+    {
+        udpDevice->setLocalAddress(host.isEmpty() ? QHostAddress(QHostAddress::Any) :
+                                   QHostAddress(host));
+        udpDevice->setLocalPort(port);
+        udpDevice->setBufferSize(ui->spBufferSize->value() * 1024);
+        // failure is reported by `onNetworkError`
+        if (!udpDevice->open(QIODevice::ReadWrite)) return false;
+
+        qDebug() << "Listening on UDP port:" << udpDevice->localPort();
+        return true;
+    }
+
+    if (host.isEmpty())
+    {
+        qWarning() << "Enter a host to connect to!";
+        return false;
+    }
+
+    tcpSocket->connectToHost(host, port);
+    if (!tcpSocket->waitForConnected(TCP_CONNECT_TIMEOUT))
+    {
+        tcpSocket->abort();
+        return false;
+    }
+
+    qDebug() << "Connected to:" << host << port;
+    return true;
+}
+
+bool PortControl::isNetworkOpen() const
+{
+    return udpDevice->isOpen() || tcpSocket->isOpen();
+}
+
+void PortControl::updateSourceWidgets()
+{
+    bool open = isOpen();
+    bool serial = ui->cbSource->currentIndex() == Source_Serial;
+
+    ui->cbSource->setEnabled(!open);
+    ui->lNetAddress->setEnabled(!serial);
+    ui->leNetHost->setEnabled(!serial && !open);
+    ui->spNetPort->setEnabled(!serial && !open);
+
+    // serial port settings are applied immediately, so they stay
+    // enabled while port is open
+    ui->cbPortList->setEnabled(serial);
+    ui->pbReloadPorts->setEnabled(serial);
+    ui->cbBaudRate->setEnabled(serial);
+    ui->frame->setEnabled(serial);
+    ui->frame_2->setEnabled(serial);
+    ui->frame_3->setEnabled(serial);
+    ui->frame_4->setEnabled(serial);
+    ui->pbDTR->setEnabled(serial);
+    ui->pbRTS->setEnabled(serial);
+    tbPortList.setEnabled(serial);
+
+    ui->cbNativeBackend->setEnabled(serial && !open);
+    ui->spReadSize->setEnabled(serial && !open);
+}
+
+void PortControl::onNetworkError(QIODevice* device)
+{
+    qCritical() << "Network error:" << device->errorString();
+
+    // while opening or after closing
+    if (!networkOpen) return;
+
+    if (device->isOpen())
+    {
+        togglePort();
+    }
+    else // closed by remote
+    {
+        networkOpen = false;
+        emit portToggled(false);
+        openAction.setChecked(false);
+        updateSourceWidgets();
+    }
+}
+
+bool PortControl::openNativePort()
+{
+    // port settings are taken from the UI, same as `serialPort`
+    nativePort->setPortName(serialPort->portName());
+    nativePort->setBaudRate(ui->cbBaudRate->currentText().toInt());
+    nativePort->setParity((QSerialPort::Parity) parityButtons.checkedId());
+    nativePort->setDataBits((QSerialPort::DataBits) dataBitsButtons.checkedId());
+    nativePort->setStopBits((QSerialPort::StopBits) stopBitsButtons.checkedId());
+    nativePort->setFlowControl((QSerialPort::FlowControl) flowControlButtons.checkedId());
+    nativePort->setReadSize(ui->spReadSize->value());
+    nativePort->setBufferSize(ui->spBufferSize->value() * 1024);
+
+    return nativePort->open(QIODevice::ReadWrite);
+}
+
+bool PortControl::isOpen() const
+{
+    return serialPort->isOpen() || nativePort->isOpen() || isNetworkOpen();
+}
+
+QIODevice* PortControl::device() const
+{
+    if (nativePort->isOpen()) return nativePort;
+    if (udpDevice->isOpen()) return udpDevice;
+    if (tcpSocket->isOpen()) return tcpSocket;
+    return serialPort;
 }
 
 void PortControl::selectListedPort(QString portName)
@@ -332,7 +579,7 @@ void PortControl::selectListedPort(QString portName)
     if (portName != serialPort->portName())
     {
         // if another port is already open, close it by toggling
-        if (serialPort->isOpen())
+        if (isOpen())
         {
             togglePort();
 
@@ -444,9 +691,25 @@ required privileges or device is already opened by another process.";
     }
 }
 
+void PortControl::onNativePortError(QSerialPort::SerialPortError error)
+{
+    qCritical() << "Port error:" << nativePort->errorString();
+
+    if (error == QSerialPort::ResourceError)
+    {
+        if (nativePort->isOpen())
+        {
+            qWarning() << "Closing port on resource error: " << nativePort->portName();
+            togglePort();
+        }
+        loadPortList();
+    }
+}
+
 void PortControl::updatePinLeds(void)
 {
-    auto pins = serialPort->pinoutSignals();
+    auto pins = nativePort->isOpen() ?
+        nativePort->pinoutSignals() : serialPort->pinoutSignals();
     ui->ledDCD->setOn(pins & QSerialPort::DataCarrierDetectSignal);
     ui->ledDSR->setOn(pins & QSerialPort::DataSetReadySignal);
     ui->ledRI->setOn(pins & QSerialPort::RingIndicatorSignal);
@@ -506,7 +769,7 @@ void PortControl::selectBaudrate(QString baudRate)
 
 void PortControl::openPort()
 {
-    if (!serialPort->isOpen())
+    if (!isOpen())
     {
         openAction.trigger();
     }
@@ -514,23 +777,32 @@ void PortControl::openPort()
 
 unsigned PortControl::maxBitRate() const
 {
-    float baud = serialPort->baudRate();
-    float dataBits = serialPort->dataBits();
-    float parityBits = serialPort->parity() == QSerialPort::NoParity ? 0 : 1;
-
-    float stopBits;
-    if (serialPort->stopBits() == QSerialPort::OneAndHalfStop)
-    {
-        stopBits = 1.5;
-    }
-    else
+    // both backends have the same interface for settings
+    auto bitRate = [](auto* port) -> unsigned
     {
-        stopBits = serialPort->stopBits();
-    }
+        float baud = port->baudRate();
+        float dataBits = port->dataBits();
+        float parityBits = port->parity() == QSerialPort::NoParity ? 0 : 1;
 
-    float frame_size = 1 /* start bit */ + dataBits + parityBits + stopBits;
+        float stopBits;
+        if (port->stopBits() == QSerialPort::OneAndHalfStop)
+        {
+            stopBits = 1.5;
+        }
+        else
+        {
+            stopBits = port->stopBits();
+        }
+
+        float frame_size = 1 /* start bit */ + dataBits + parityBits + stopBits;
 
-    return float(baud) / frame_size;
+        return float(baud) / frame_size;
+    };
+
+    // network isn't limited by a baud rate
+    if (isNetworkOpen()) return std::numeric_limits<unsigned>::max();
+    if (nativePort->isOpen()) return bitRate(nativePort);
+    return bitRate(serialPort);
 }
 
 void PortControl::saveSettings(QSettings* settings)
@@ -542,13 +814,19 @@ void PortControl::saveSettings(QSettings* settings)
     settings->setValue(SG_Port_DataBits, dataBitsButtons.checkedId());
     settings->setValue(SG_Port_StopBits, stopBitsButtons.checkedId());
     settings->setValue(SG_Port_FlowControl, currentFlowControlText());
+    settings->setValue(SG_Port_NativeBackend, ui->cbNativeBackend->isChecked());
+    settings->setValue(SG_Port_ReadSize, ui->spReadSize->value());
+    settings->setValue(SG_Port_BufferSize, ui->spBufferSize->value());
+    settings->setValue(SG_Port_Source, sourceSettingMap.value(ui->cbSource->currentIndex()));
+    settings->setValue(SG_Port_NetHost, ui->leNetHost->text());
+    settings->setValue(SG_Port_NetPort, ui->spNetPort->value());
     settings->endGroup();
 }
 
 void PortControl::loadSettings(QSettings* settings)
 {
     // make sure the port is closed
-    if (serialPort->isOpen()) togglePort();
+    if (isOpen()) togglePort();
 
     settings->beginGroup(SettingGroup_Port);
 
@@ -625,5 +903,23 @@ void PortControl::loadSettings(QSettings* settings)
         ui->rbNoFlowControl->setChecked(true);
     }
 
+    // load native backend settings
+    ui->cbNativeBackend->setChecked(
+        NativeSerialPort::isSupported() &&
+        settings->value(SG_Port_NativeBackend, ui->cbNativeBackend->isChecked()).toBool());
+    ui->spReadSize->setValue(
+        settings->value(SG_Port_ReadSize, ui->spReadSize->value()).toInt());
+    ui->spBufferSize->setValue(
+        settings->value(SG_Port_BufferSize, ui->spBufferSize->value()).toInt());
+
+    // load network source settings
+    QString sourceSetting = settings->value(SG_Port_Source, QString()).toString();
+    ui->cbSource->setCurrentIndex(
+        sourceSettingMap.key(sourceSetting, ui->cbSource->currentIndex()));
+    ui->leNetHost->setText(
+        settings->value(SG_Port_NetHost, ui->leNetHost->text()).toString());
+    ui->spNetPort->setValue(
+        settings->value(SG_Port_NetPort, ui->spNetPort->value()).toInt());
+
     settings->endGroup();
 }
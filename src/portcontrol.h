@@ -29,8 +29,11 @@
 #include <QComboBox>
 #include <QSettings>
 #include <QTimer>
+#include <QTcpSocket>
 
 #include "portlist.h"
+#include "nativeserialport.h"
+#include "udpdevice.h"
 
 namespace Ui {
 class PortControl;
@@ -41,15 +44,27 @@ class PortControl : public QWidget
     Q_OBJECT
 
 public:
-    explicit PortControl(QSerialPort* port, QWidget* parent = 0);
+    explicit PortControl(QSerialPort* port, NativeSerialPort* nativePort,
+                         QTcpSocket* tcpSocket, UdpDevice* udpDevice,
+                         QWidget* parent = 0);
     ~PortControl();
 
     QSerialPort* serialPort;
+    /// Used instead of `serialPort` when native backend is selected
+    NativeSerialPort* nativePort;
+    /// Used when TCP source is selected
+    QTcpSocket* tcpSocket;
+    /// Used when UDP source is selected
+    UdpDevice* udpDevice;
     QToolBar* toolBar();
 
     void selectPort(QString portName);
     void selectBaudrate(QString baudRate);
     void openPort();
+    /// Returns true if port or network source is open
+    bool isOpen() const;
+    /// Returns the device of open port or network source, `serialPort` if closed
+    QIODevice* device() const;
     /// Returns maximum bit rate for current baud rate
     unsigned maxBitRate() const;
 
@@ -61,6 +76,13 @@ public:
 private:
     Ui::PortControl *ui;
 
+    enum SourceType
+    {
+        Source_Serial,
+        Source_Udp,
+        Source_Tcp
+    };
+
     QButtonGroup parityButtons;
     QButtonGroup dataBitsButtons;
     QButtonGroup stopBitsButtons;
@@ -74,6 +96,8 @@ private:
 
     /// Used to refresh pinout signal leds periodically
     QTimer pinUpdateTimer;
+    /// Network source is open and reported with `portToggled`
+    bool networkOpen;
 
     /// Returns the currently selected (entered) "portName" in the UI
     QString selectedPortName();
@@ -81,6 +105,16 @@ private:
     QString currentParityText();
     /// Returns currently selected flow control as text to be saved in settings
     QString currentFlowControlText();
+    /// Configures and opens `nativePort` with current settings
+    bool openNativePort();
+    /// Opens selected network source
+    bool openNetwork();
+    /// Returns true if a network source is open
+    bool isNetworkOpen() const;
+    /// Enables widgets of selected source
+    void updateSourceWidgets();
+    /// Reports an error of a network device and closes it
+    void onNetworkError(QIODevice* device);
 
 private slots:
     void loadPortList();
@@ -98,6 +132,7 @@ private slots:
     void onCbPortListActivated(int index);
     void onTbPortListActivated(int index);
     void onPortError(QSerialPort::SerialPortError error);
+    void onNativePortError(QSerialPort::SerialPortError error);
     void updatePinLeds(void);
 
 signals:
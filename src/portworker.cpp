@@ -0,0 +1,164 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <QCoreApplication>
+#include <QThread>
+
+#include "portworker.h"
+#include "latencytracer.h"
+
+/// Number of decoded packs that can wait in queue
+#define QUEUE_SIZE 1024
+
+PortWorker::PortWorker(Config config, unsigned numChannels, QObject* parent) :
+    QObject(parent), _queue(QUEUE_SIZE), _dropped(0), _bytesRead(0)
+{
+    Q_ASSERT(config.reader != nullptr);
+
+    _config = config;
+    _numChannels = numChannels;
+    port = nullptr;
+    idleDevice = nullptr;
+    lastArrival = 0;
+}
+
+PortWorker::~PortWorker()
+{
+    Q_ASSERT(port == nullptr);
+
+    SamplePack* samples;
+    while (_queue.pop(samples)) delete samples;
+}
+
+void PortWorker::start()
+{
+    port = new QSerialPort(this);
+    port->setPortName(_config.portName);
+    connect(port, &QSerialPort::errorOccurred, this, &PortWorker::onPortError);
+
+    // failure is reported by `onPortError`
+    if (!port->open(QIODevice::ReadOnly)) return;
+    if (!port->setBaudRate(_config.baudRate) ||
+        !port->setDataBits(_config.dataBits) ||
+        !port->setParity(_config.parity) ||
+        !port->setStopBits(_config.stopBits) ||
+        !port->setFlowControl(_config.flowControl))
+    {
+        // reported by `onPortError` but port is still open
+        stop();
+        return;
+    }
+    lastArrival = 0;
+
+    // reader is connected first so that bytes are counted after it reads
+    idleDevice = _config.reader->device();
+    _config.reader->setDevice(port);
+    connect(port, &QSerialPort::readyRead, this, &PortWorker::onReadyRead);
+}
+
+void PortWorker::stop()
+{
+    if (port == nullptr) return;
+
+    auto reader = _config.reader;
+    if (idleDevice != nullptr)
+    {
+        reader->setDevice(idleDevice);
+        idleDevice = nullptr;
+    }
+    // can only be pushed from its current thread
+    if (reader->thread() == QThread::currentThread())
+    {
+        reader->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    // port must be deleted in this thread together with its
+    // notifiers, we may also be called from a signal of the port
+    port->disconnect(this);
+    port->close();
+    port->deleteLater();
+    port = nullptr;
+}
+
+void PortWorker::onReadyRead()
+{
+    _bytesRead.fetch_add(_config.reader->getBytesRead(), std::memory_order_relaxed);
+}
+
+void PortWorker::feedIn(const SamplePack& data)
+{
+    qint64 arrival = data.timestamp() ? data.timestamp() : LatencyTracer::now();
+    unsigned ns = data.numSamples();
+    if (!ns) return;
+
+    // a reader may change its number of channels (ex: ASCII auto),
+    // merged channel layout is fixed while running
+    auto samples = new SamplePack(ns, _numChannels, true);
+    unsigned nc = std::min(data.numChannels(), _numChannels);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        std::copy_n(data.data(ci), ns, samples->data(ci));
+    }
+    for (unsigned ci = nc; ci < _numChannels; ci++)
+    {
+        std::fill_n(samples->data(ci), ns, std::numeric_limits<double>::quiet_NaN());
+    }
+    setTimes(*samples, arrival);
+    samples->setTimestamp(arrival);
+
+    if (!_queue.push(samples))
+    {
+        _dropped.fetch_add(ns, std::memory_order_relaxed);
+        delete samples;
+    }
+}
+
+void PortWorker::setTimes(SamplePack& samples, qint64 arrival)
+{
+    unsigned ns = samples.numSamples();
+    double* times = samples.xData();
+
+    if (_config.timeChannel >= 0 && unsigned(_config.timeChannel) < _numChannels)
+    {
+        std::copy_n(samples.data(_config.timeChannel), ns, times);
+    }
+    else
+    {
+        // samples arrived some time between previous and this read,
+        // spread them evenly
+        qint64 prev = lastArrival ? lastArrival : arrival;
+        double step = double(arrival - prev) / ns;
+        for (unsigned i = 0; i < ns; i++)
+        {
+            times[i] = prev + step * (i + 1);
+        }
+    }
+    lastArrival = arrival;
+}
+
+void PortWorker::onPortError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError ||
+        error == QSerialPort::TimeoutError) return;
+
+    emit errorOccurred(tr("%1: %2").arg(_config.portName, port->errorString()));
+    if (!port->isOpen() || error == QSerialPort::ResourceError) stop();
+}
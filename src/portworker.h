@@ -0,0 +1,117 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PORTWORKER_H
+#define PORTWORKER_H
+
+#include <atomic>
+#include <QObject>
+#include <QSerialPort>
+
+#include "abstractreader.h"
+#include "samplepack.h"
+#include "sink.h"
+#include "spscqueue.h"
+
+/**
+ * Reads and decodes a single serial port on its own thread, for
+ * multi port acquisition (see `MergedSource`).
+ *
+ * Data is decoded by a regular reader, so any data format can be
+ * used. While the worker runs, the reader is moved to the worker
+ * thread and reads the port directly; decoded samples come back to
+ * the worker as its sink. They are pushed to a lock-free queue with
+ * the time of each sample in X channel; either arrival time (spread
+ * over the samples since previous read) or the value of a timestamp
+ * channel sent by the device.
+ *
+ * Reader must be enabled and connected to the worker, then both
+ * moved to the worker thread before `start()` is called. `stop()`
+ * moves the reader back to the main thread. Owner must pop and
+ * delete packs from `queue()`.
+ */
+class PortWorker : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    struct Config
+    {
+        QString portName;
+        qint32 baudRate = 115200;
+        QSerialPort::DataBits dataBits = QSerialPort::Data8;
+        QSerialPort::Parity parity = QSerialPort::NoParity;
+        QSerialPort::StopBits stopBits = QSerialPort::OneStop;
+        QSerialPort::FlowControl flowControl = QSerialPort::NoFlowControl;
+        /// Channel that carries device timestamps, -1 for arrival time
+        int timeChannel = -1;
+        /// Decodes data of the port, not owned. Must not have a
+        /// parent so that it can be moved to the worker thread.
+        AbstractReader* reader = nullptr;
+    };
+
+    /// @param numChannels number of channels pushed to queue,
+    /// samples of reader are padded or cut to this
+    PortWorker(Config config, unsigned numChannels, QObject* parent = 0);
+    ~PortWorker();
+
+    const Config& config() const {return _config;};
+    /// Decoded packs, only the owner thread should pop
+    SpscQueue<SamplePack*>& queue() {return _queue;};
+    /// Number of samples dropped because queue was full
+    quint64 dropped() const {return _dropped.load(std::memory_order_relaxed);};
+    /// Total number of bytes read
+    quint64 bytesRead() const {return _bytesRead.load(std::memory_order_relaxed);};
+
+public slots:
+    /// Opens the port, should be called in worker thread
+    void start();
+    /// Closes the port, should be called in worker thread
+    void stop();
+
+signals:
+    /// Emitted when port can't be opened or fails while reading
+    void errorOccurred(QString message);
+
+protected:
+    /// Decoded samples from the reader
+    void feedIn(const SamplePack& data) override;
+
+private:
+    Config _config;
+    unsigned _numChannels;
+    QSerialPort* port;
+    /// Device of the reader before it was given the port
+    QIODevice* idleDevice;
+    /// Arrival time of previous read (ns), 0 before first read
+    qint64 lastArrival;
+
+    SpscQueue<SamplePack*> _queue;
+    std::atomic<quint64> _dropped;
+    std::atomic<quint64> _bytesRead;
+
+    /// Sets sample times in X channel
+    void setTimes(SamplePack& samples, qint64 arrival);
+
+private slots:
+    void onReadyRead();
+    void onPortError(QSerialPort::SerialPortError error);
+};
+
+#endif // PORTWORKER_H
@@ -0,0 +1,113 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <QtEndian>
+#include <QtDebug>
+
+#include "rawcapture.h"
+
+const char RawCapture::Magic[8] = {'S', 'P', 'R', 'A', 'W', 'C', 'A', 'P'};
+
+/// Buffered chunks are written to file when buffer grows beyond this size
+#define CAPTURE_BUFFER_SIZE (1024 * 1024)
+/// Buffered chunks are written to file at least this often (milliseconds)
+#define CAPTURE_FLUSH_INTERVAL 1000
+
+RawCapture::RawCapture()
+{
+    _bytesCaptured = 0;
+}
+
+RawCapture::~RawCapture()
+{
+    stop();
+}
+
+bool RawCapture::start(QString fileName)
+{
+    Q_ASSERT(!file.isOpen());
+
+    file.setFileName(fileName);
+    // we do our own buffering
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+    {
+        qCritical() << "Opening capture file " << fileName
+                    << " for writing failed:" << file.errorString();
+        return false;
+    }
+
+    buffer.clear();
+    buffer.reserve(CAPTURE_BUFFER_SIZE + 64 * 1024);
+
+    char header[HeaderSize];
+    memcpy(header, Magic, sizeof(Magic));
+    qToLittleEndian<quint32>(Version, header + 8);
+    qToLittleEndian<quint32>(0, header + 12);
+    buffer.append(header, HeaderSize);
+
+    _bytesCaptured = 0;
+    timer.start();
+    flush();
+
+    return true;
+}
+
+void RawCapture::stop()
+{
+    if (!file.isOpen()) return;
+
+    flush();
+    file.close();
+}
+
+bool RawCapture::isCapturing() const
+{
+    return file.isOpen();
+}
+
+void RawCapture::write(const char* data, qint64 size)
+{
+    if (!file.isOpen() || size <= 0) return;
+
+    char chunkHeader[ChunkHeaderSize];
+    qToLittleEndian<quint64>(timer.nsecsElapsed(), chunkHeader);
+    qToLittleEndian<quint32>(size, chunkHeader + 8);
+    buffer.append(chunkHeader, ChunkHeaderSize);
+    buffer.append(data, size);
+    _bytesCaptured += size;
+
+    if (buffer.size() >= CAPTURE_BUFFER_SIZE ||
+        lastFlush.hasExpired(CAPTURE_FLUSH_INTERVAL))
+    {
+        flush();
+    }
+}
+
+void RawCapture::flush()
+{
+    if (buffer.isEmpty()) return;
+
+    if (file.write(buffer) != buffer.size())
+    {
+        qCritical() << "Writing to capture file failed:" << file.errorString();
+    }
+    buffer.resize(0);           // keeps the capacity
+    lastFlush.start();
+}
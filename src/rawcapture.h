@@ -0,0 +1,80 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RAWCAPTURE_H
+#define RAWCAPTURE_H
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+/**
+ * Writes the bytes received from the device to a file exactly as
+ * they are received. Used for debugging protocol issues by replaying
+ * the capture through a reader later (see `CaptureReplayDevice`).
+ *
+ * File format (all integers little endian):
+ *
+ *     header: "SPRAWCAP" (8 bytes), u32 version, u32 reserved
+ *     chunk:  u64 timestamp (ns since capture start), u32 length, bytes...
+ *
+ * Each chunk is a single read from the device. Chunks are collected
+ * in a large buffer and written with unbuffered file writes to avoid
+ * a syscall per read.
+ */
+class RawCapture
+{
+public:
+    static const char Magic[8];
+    static const quint32 Version = 1;
+    static const int HeaderSize = 16;
+    static const int ChunkHeaderSize = 12;
+
+    RawCapture();
+    ~RawCapture();
+
+    /// Starts capturing to given file. File is overwritten.
+    bool start(QString fileName);
+    /// Flushes remaining data and closes the file.
+    void stop();
+    bool isCapturing() const;
+
+    /// Appends a chunk with current timestamp.
+    void write(const char* data, qint64 size);
+
+    /// Writes buffered chunks to file.
+    void flush();
+
+    /// Total number of payload bytes captured since start
+    quint64 bytesCaptured() const {return _bytesCaptured;};
+
+    /// Capture file name
+    QString fileName() const {return file.fileName();};
+
+private:
+    QFile file;
+    QByteArray buffer;
+    QElapsedTimer timer;     ///< chunk timestamps
+    QElapsedTimer lastFlush;
+    quint64 _bytesCaptured;
+};
+
+#endif // RAWCAPTURE_H
@@ -18,7 +18,9 @@
 */
 
 #include <QtGlobal>
+#include <QtNumeric>
 #include <string.h>
+#include <algorithm>
 
 #include "readonlybuffer.h"
 
@@ -36,9 +38,11 @@ ReadOnlyBuffer::ReadOnlyBuffer(const FrameBuffer* source, unsigned start, unsign
     _size = n;
     data = new double[_size];
 
+    _hasGaps = false;
     for (unsigned i = 0; i < n; i++)
     {
         data[i] = source->sample(start + i);
+        if (qIsNaN(data[i])) _hasGaps = true;
     }
 
     /// if not exact copy of source re-calculate limits
@@ -59,6 +63,7 @@ ReadOnlyBuffer::ReadOnlyBuffer(const double* source, unsigned ssize)
     _size = ssize;
     data = new double[_size];
     memcpy(data, source, sizeof(double) * ssize);
+    _hasGaps = std::any_of(data, data + _size, [](double d){return qIsNaN(d);});
     updateLimits();
 }
 
@@ -82,16 +87,30 @@ Range ReadOnlyBuffer::limits() const
     return _limits;
 }
 
+bool ReadOnlyBuffer::hasGaps() const
+{
+    return _hasGaps;
+}
+
 void ReadOnlyBuffer::updateLimits()
 {
     Q_ASSERT(_size);
 
-    _limits.start = data[0];
-    _limits.end = data[0];
+    // NaN samples mark gaps in data, they are skipped
+    bool found = false;
+    _limits = {0, 0};
 
     for (unsigned i = 0; i < _size; i++)
     {
-        if (data[i] > _limits.end)
+        if (qIsNaN(data[i])) continue;
+
+        if (!found)
+        {
+            _limits.start = data[i];
+            _limits.end = data[i];
+            found = true;
+        }
+        else if (data[i] > _limits.end)
         {
             _limits.end = data[i];
         }
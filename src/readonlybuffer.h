@@ -49,11 +49,13 @@ public:
     virtual unsigned size() const;
     virtual double sample(unsigned i) const;
     virtual Range limits() const;
+    virtual bool hasGaps() const;
 
 private:
     double* data;    ///< data storage
     unsigned _size;  ///< data size
     Range _limits;   ///< limits cache
+    bool _hasGaps;   ///< contains NaN samples
 
     // TODO: duplicate with `RingBuffer`
     void updateLimits(); ///< Updates limits cache
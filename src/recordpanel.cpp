@@ -27,6 +27,7 @@
 #include <QFileSystemModel>
 #include <QFileSystemModel>
 #include <QDateTime>
+#include <QSettings>
 #include <QtDebug>
 #include <ctime>
 
@@ -91,6 +92,9 @@ RecordPanel::RecordPanel(Stream* stream, QWidget *parent) :
 
 
     connect(&recordAction, &QAction::toggled, ui->cbWindowsLE, &QWidget::setDisabled);
+    connect(&recordAction, &QAction::toggled, ui->cbCheckpoint, &QWidget::setDisabled);
+    connect(&recordAction, &QAction::toggled, ui->spCheckpointInterval, &QWidget::setDisabled);
+    connect(&recordAction, &QAction::toggled, ui->cbRawCapture, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->cbTimestamp, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->leSeparator, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->pbBrowse, &QWidget::setDisabled);
@@ -126,6 +130,17 @@ bool RecordPanel::recordPaused()
     return ui->cbRecordPaused->isChecked();
 }
 
+RawCapture* RecordPanel::rawCapture()
+{
+    return &_rawCapture;
+}
+
+QString RecordPanel::rawCaptureFileName(QString recordFileName)
+{
+    QFileInfo fileInfo(recordFileName);
+    return fileInfo.path() + "/" + fileInfo.completeBaseName() + ".spraw";
+}
+
 bool RecordPanel::selectFile()
 {
     QString fileName = QFileDialog::getSaveFileName(
@@ -343,6 +358,61 @@ bool RecordPanel::incrementFileName(void)
     return true;
 }
 
+void RecordPanel::recoverInterruptedRecording()
+{
+    QSettings appSettings(PROGRAM_NAME, PROGRAM_NAME);
+    appSettings.beginGroup(SettingGroup_Record);
+    QString fileName = appSettings.value(SG_Record_LastFile).toString();
+    appSettings.remove(SG_Record_LastFile);
+    appSettings.endGroup();
+
+    // a left over checkpoint index means last recording was interrupted
+    QString ckptFileName = DataRecorder::checkpointFileName(fileName);
+    if (fileName.isEmpty() || recordAction.isChecked() ||
+        !QFile::exists(fileName) || !QFile::exists(ckptFileName))
+    {
+        return;
+    }
+
+    qint64 size = QFileInfo(fileName).size();
+    qint64 keep = DataRecorder::recoveredSize(fileName);
+    if (keep < 0) return;       // already reported
+    if (keep == size)
+    {
+        qInfo() << "Last recording was interrupted but it's complete:" << fileName;
+        QFile::remove(ckptFileName);
+        return;
+    }
+
+    QMessageBox mb(parentWidget());
+    mb.setWindowTitle(tr("Recording Was Interrupted"));
+    mb.setIcon(QMessageBox::Warning);
+    mb.setText(tr("Last recording (%1) was interrupted. Its last %2 bytes "
+                  "are not known to be complete.").arg(fileName).arg(size - keep));
+    mb.setInformativeText(tr("Recovering truncates the file from %1 to %2 bytes. "
+                             "Leaving it as is keeps the partially written data.")
+                          .arg(size).arg(keep));
+
+    auto bRecover = mb.addButton(tr("Recover"), QMessageBox::DestructiveRole);
+    auto bLeave   = mb.addButton(tr("Leave As Is"), QMessageBox::RejectRole);
+    mb.setEscapeButton(bLeave);
+    mb.exec();
+
+    if (mb.clickedButton() == bRecover)
+    {
+        if (DataRecorder::recoverRecording(fileName) >= 0)
+        {
+            qWarning() << "Recovered interrupted recording:" << fileName
+                       << "truncated by" << size - keep << "bytes";
+        }
+    }
+    else
+    {
+        // don't ask again
+        QFile::remove(ckptFileName);
+    }
+}
+
 bool RecordPanel::confirmOverwrite(QString fileName)
 {
     // prepare message box
@@ -384,9 +454,26 @@ bool RecordPanel::startRecording(QString fileName)
         channelNames = _stream->infoModel()->channelNames();
     }
 
+    recorder.setCheckpointInterval(
+        ui->cbCheckpoint->isChecked() ? ui->spCheckpointInterval->value() : 0);
+
     if (recorder.startRecording(fileName, getSeparator(), channelNames, currentTimestampOption()))
     {
+        // stored right away, application won't save settings if it crashes
+        if (ui->cbCheckpoint->isChecked())
+        {
+            QSettings appSettings(PROGRAM_NAME, PROGRAM_NAME);
+            appSettings.beginGroup(SettingGroup_Record);
+            appSettings.setValue(SG_Record_LastFile, fileName);
+            appSettings.endGroup();
+        }
         _stream->connectFollower(&recorder);
+
+        // failing raw capture shouldn't prevent recording
+        if (ui->cbRawCapture->isChecked())
+        {
+            _rawCapture.start(rawCaptureFileName(fileName));
+        }
         return true;
     }
     else
@@ -398,6 +485,7 @@ bool RecordPanel::startRecording(QString fileName)
 void RecordPanel::stopRecording(void)
 {
     recorder.stopRecording();
+    _rawCapture.stop();
     _stream->disconnectFollower(&recorder);
 }
 
@@ -440,6 +528,9 @@ void RecordPanel::saveSettings(QSettings* settings)
     settings->setValue(SG_Record_Separator, ui->leSeparator->text());
     settings->setValue(SG_Record_Decimals, ui->spDecimals->text());
     settings->setValue(SG_Record_Timestamp, ui->cbTimestamp->isChecked());
+    settings->setValue(SG_Record_Checkpoint, ui->cbCheckpoint->isChecked());
+    settings->setValue(SG_Record_CheckpointInterval, ui->spCheckpointInterval->value());
+    settings->setValue(SG_Record_RawCapture, ui->cbRawCapture->isChecked());
 
     QString tsFormatStr;
     auto tsOpt = static_cast<DataRecorder::TimestampOption>(ui->cbTimestampFormat->currentData().toInt());
@@ -479,6 +570,12 @@ void RecordPanel::loadSettings(QSettings* settings)
     ui->spDecimals->setValue(settings->value(SG_Record_Decimals, ui->spDecimals->value()).toInt());
     ui->cbTimestamp->setChecked(
         settings->value(SG_Record_Timestamp, ui->cbTimestamp->isChecked()).toBool());
+    ui->cbCheckpoint->setChecked(
+        settings->value(SG_Record_Checkpoint, ui->cbCheckpoint->isChecked()).toBool());
+    ui->spCheckpointInterval->setValue(
+        settings->value(SG_Record_CheckpointInterval, ui->spCheckpointInterval->value()).toInt());
+    ui->cbRawCapture->setChecked(
+        settings->value(SG_Record_RawCapture, ui->cbRawCapture->isChecked()).toBool());
 
     // load timestamp format
     QString tsFormatStr = settings->value(SG_Record_TimestampFormat, "").toString();
@@ -26,6 +26,7 @@
 #include <QAction>
 
 #include "datarecorder.h"
+#include "rawcapture.h"
 #include "stream.h"
 
 namespace Ui {
@@ -44,11 +45,25 @@ public:
 
     bool recordPaused();
 
+    /// Raw byte capture that is started/stopped together with recording
+    RawCapture* rawCapture();
+
+    /// Returns the raw capture file name for given record file
+    static QString rawCaptureFileName(QString recordFileName);
+
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
     void loadSettings(QSettings* settings);
 
+    /**
+     * Checks if the last recording with checkpoints enabled was
+     * interrupted (crash, power loss etc.) and asks the user to
+     * recover it, see `DataRecorder::recoverRecording`. Should only
+     * be called once at startup.
+     */
+    void recoverInterruptedRecording();
+
 signals:
     void recordStarted();
     void recordStopped();
@@ -64,6 +79,7 @@ private:
     QAction recordAction;
     bool overwriteSelected;
     DataRecorder recorder;
+    RawCapture _rawCapture;
     Stream* _stream;
     QString originalBaseFileName;
 
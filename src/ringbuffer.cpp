@@ -18,6 +18,7 @@
 */
 
 #include <QtGlobal>
+#include <QtNumeric>
 
 #include "ringbuffer.h"
 
@@ -26,6 +27,7 @@ RingBuffer::RingBuffer(unsigned n)
     _size = n;
     data = new double[_size]();
     headIndex = 0;
+    numNaN = 0;
 
     limInvalid = false;
     limCache = {0, 0};
@@ -54,6 +56,20 @@ Range RingBuffer::limits() const
     return limCache;
 }
 
+bool RingBuffer::hasGaps() const
+{
+    return numNaN > 0;
+}
+
+void RingBuffer::countNaN()
+{
+    numNaN = 0;
+    for (unsigned i = 0; i < _size; i++)
+    {
+        if (qIsNaN(data[i])) numNaN++;
+    }
+}
+
 void RingBuffer::resize(unsigned n)
 {
     Q_ASSERT(n != _size);
@@ -85,6 +101,7 @@ void RingBuffer::resize(unsigned n)
     data = newData;
     headIndex = 0;
     _size = n;
+    countNaN();
 
     // invalidate bounding rectangle
     limInvalid = true;
@@ -101,7 +118,7 @@ void RingBuffer::addSamples(double* samples, unsigned n)
         {
             for (unsigned i = 0; i < shift; i++)
             {
-                data[i+headIndex] = samples[i];
+                put(i+headIndex, samples[i]);
             }
 
             if (shift == x) // we used all the room at the end
@@ -117,11 +134,11 @@ void RingBuffer::addSamples(double* samples, unsigned n)
         {
             for (unsigned i = 0; i < x; i++) // fill the end part
             {
-                data[i+headIndex] = samples[i];
+                put(i+headIndex, samples[i]);
             }
             for (unsigned i = 0; i < (shift-x); i++) // continue from the beginning
             {
-                data[i] = samples[i+x];
+                put(i, samples[i+x]);
             }
             headIndex = shift-x;
         }
@@ -134,6 +151,7 @@ void RingBuffer::addSamples(double* samples, unsigned n)
             data[i] = samples[i+x];
         }
         headIndex = 0;
+        countNaN();
     }
 
     // invalidate cache
@@ -146,6 +164,7 @@ void RingBuffer::clear()
     {
         data[i] = 0.;
     }
+    numNaN = 0;
 
     limCache = {0, 0};
     limInvalid = false;
@@ -153,12 +172,21 @@ void RingBuffer::clear()
 
 void RingBuffer::updateLimits() const
 {
-    limCache.start = data[0];
-    limCache.end = data[0];
+    // NaN samples mark gaps in data, they are skipped
+    bool found = false;
+    limCache = {0, 0};
 
     for (unsigned i = 0; i < _size; i++)
     {
-        if (data[i] > limCache.end)
+        if (qIsNaN(data[i])) continue;
+
+        if (!found)
+        {
+            limCache.start = data[i];
+            limCache.end = data[i];
+            found = true;
+        }
+        else if (data[i] > limCache.end)
         {
             limCache.end = data[i];
         }
@@ -20,6 +20,8 @@
 #ifndef RINGBUFFER_H
 #define RINGBUFFER_H
 
+#include <QtNumeric>
+
 #include "framebuffer.h"
 
 /// A fast buffer implementation for storing data.
@@ -32,6 +34,7 @@ public:
     virtual unsigned size() const;
     virtual double sample(unsigned i) const;
     virtual Range limits() const;
+    virtual bool hasGaps() const;
     virtual void resize(unsigned n);
     virtual void addSamples(double* samples, unsigned n);
     virtual void clear();
@@ -40,6 +43,17 @@ private:
     unsigned _size;            ///< size of `data`
     double* data;              ///< storage
     unsigned headIndex;        ///< indicates the actual `0` index of the ring buffer
+    unsigned numNaN;           ///< number of NaN samples in `data`
+
+    /// Writes a sample to `data`, keeps `numNaN` up to date
+    void put(unsigned index, double value)
+    {
+        numNaN -= qIsNaN(data[index]);
+        numNaN += qIsNaN(value);
+        data[index] = value;
+    }
+    /// Counts `numNaN` from scratch
+    void countNaN();
 
     mutable bool limInvalid;   ///< Indicates that limits needs to be re-calculated
     mutable Range limCache;    ///< Cache for limits()
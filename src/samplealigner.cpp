@@ -0,0 +1,162 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include "samplealigner.h"
+
+/// Default limit of waiting samples per port
+#define DEFAULT_MAX_PENDING 1000000
+
+SampleAligner::SampleAligner()
+{
+    _numChannels = 0;
+    maxPending = DEFAULT_MAX_PENDING;
+    _dropped = 0;
+}
+
+void SampleAligner::setPorts(const QVector<unsigned>& numChannels)
+{
+    ports.clear();
+    _numChannels = 0;
+    for (unsigned nc : numChannels)
+    {
+        Port port;
+        port.numChannels = nc;
+        port.firstChannel = _numChannels;
+        port.data.resize(nc);
+        port.held.fill(std::numeric_limits<double>::quiet_NaN(), nc);
+        port.seen = false;
+        port.lastTime = 0;
+        port.lastArrival = 0;
+        ports.append(port);
+        _numChannels += nc;
+    }
+}
+
+void SampleAligner::clear()
+{
+    for (auto& port : ports)
+    {
+        port.times.clear();
+        for (auto& d : port.data) d.clear();
+        port.held.fill(std::numeric_limits<double>::quiet_NaN());
+        port.seen = false;
+        port.lastTime = 0;
+        port.lastArrival = 0;
+    }
+    _dropped = 0;
+}
+
+void SampleAligner::push(unsigned port, const SamplePack& pack)
+{
+    Q_ASSERT(port < unsigned(ports.size()));
+    Q_ASSERT(pack.hasX());
+
+    Port& p = ports[port];
+    Q_ASSERT(pack.numChannels() == p.numChannels);
+
+    unsigned ns = pack.numSamples();
+    if (!ns) return;
+
+    const double* times = pack.xData();
+    p.times.reserve(p.times.size() + ns);
+    std::copy_n(times, ns, std::back_inserter(p.times));
+    for (unsigned ci = 0; ci < p.numChannels; ci++)
+    {
+        auto& d = p.data[ci];
+        d.reserve(d.size() + ns);
+        std::copy_n(pack.data(ci), ns, std::back_inserter(d));
+    }
+    p.seen = true;
+    p.lastTime = times[ns-1];
+    p.lastArrival = pack.timestamp();
+
+    if (unsigned(p.times.size()) > maxPending)
+    {
+        unsigned n = p.times.size() - maxPending;
+        dropFront(p, n);
+        _dropped += n;
+    }
+}
+
+SamplePack* SampleAligner::take(double minWatermark, qint64 staleBefore)
+{
+    if (ports.isEmpty()) return nullptr;
+
+    double watermark = std::numeric_limits<double>::infinity();
+    for (auto& port : ports)
+    {
+        // silent port, its remaining samples are still used for hold
+        if (staleBefore && port.lastArrival < staleBefore) continue;
+
+        if (port.seen) watermark = std::min(watermark, port.lastTime);
+        else watermark = std::min(watermark, minWatermark);
+    }
+    watermark = std::max(watermark, minWatermark);
+
+    Port& ref = ports[0];
+    unsigned n = std::upper_bound(ref.times.cbegin(), ref.times.cend(), watermark)
+        - ref.times.cbegin();
+    if (!n) return nullptr;
+
+    auto samples = new SamplePack(n, _numChannels);
+    samples->setTimestamp(qint64(ref.times[0]));
+
+    for (unsigned ci = 0; ci < ref.numChannels; ci++)
+    {
+        std::copy_n(ref.data[ci].cbegin(), n, samples->data(ci));
+    }
+
+    for (int pi = 1; pi < ports.size(); pi++)
+    {
+        Port& port = ports[pi];
+        unsigned avail = port.times.size();
+        unsigned j = 0;         // number of samples at or before current row
+        for (unsigned i = 0; i < n; i++)
+        {
+            double t = ref.times[i];
+            while (j < avail && port.times[j] <= t) j++;
+
+            for (unsigned ci = 0; ci < port.numChannels; ci++)
+            {
+                samples->data(port.firstChannel + ci)[i] =
+                    j ? port.data[ci][j-1] : port.held[ci];
+            }
+        }
+        dropFront(port, j);
+    }
+
+    dropFront(ref, n);
+    return samples;
+}
+
+void SampleAligner::dropFront(Port& port, unsigned n)
+{
+    if (!n) return;
+
+    for (unsigned ci = 0; ci < port.numChannels; ci++)
+    {
+        port.held[ci] = port.data[ci][n-1];
+        port.data[ci].remove(0, n);
+    }
+    port.times.remove(0, n);
+}
@@ -0,0 +1,113 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SAMPLEALIGNER_H
+#define SAMPLEALIGNER_H
+
+#include <limits>
+#include <QVector>
+
+#include "samplepack.h"
+
+/**
+ * Merges samples of several ports into a single channel space, ports
+ * placed one after another.
+ *
+ * Each incoming pack carries the time of each sample in its X
+ * channel, either arrival time or a device timestamp. First port is
+ * the reference; one row is produced for each of its samples. Other
+ * ports are sampled at the reference time, latest sample at or before
+ * the reference time is used (sample and hold). A port that hasn't
+ * received any samples yet is NaN.
+ *
+ * A reference sample is only released when all ports have samples
+ * up to its time (watermark), so a slower port doesn't show stale
+ * values. A port that stopped sending is left out of the watermark
+ * once its last pack arrived long enough ago, see `take()`.
+ */
+class SampleAligner
+{
+public:
+    SampleAligner();
+
+    /// Sets number of channels of each port, clears all data
+    void setPorts(const QVector<unsigned>& numChannels);
+    unsigned numPorts() const {return ports.size();};
+    /// Total number of channels
+    unsigned numChannels() const {return _numChannels;};
+
+    /**
+     * Maximum number of samples waiting per port. When exceeded oldest
+     * samples are dropped. Prevents unbounded growth when a port
+     * stops sending.
+     */
+    void setMaxPending(unsigned max) {maxPending = max;};
+
+    /// Number of samples dropped because of `setMaxPending` limit
+    quint64 dropped() const {return _dropped;};
+
+    /**
+     * Adds samples of a port, time of each sample is in X channel.
+     * Pack timestamp is the arrival time, it's used to detect silent
+     * ports.
+     */
+    void push(unsigned port, const SamplePack& pack);
+
+    /**
+     * Returns aligned samples that are ready, `nullptr` if there
+     * isn't any. Caller takes ownership. Pack timestamp is set to
+     * the time of first row.
+     *
+     * @param minWatermark release samples up to this time even if
+     * some ports haven't caught up, ex: `now - max skew` so that a
+     * silent port doesn't stall others
+     * @param staleBefore ports whose last pack arrived before this
+     * time (see `LatencyTracer::now()`) don't hold back the
+     * watermark, 0 to wait for all ports. Unlike `minWatermark` this
+     * works when sample times aren't arrival times.
+     */
+    SamplePack* take(double minWatermark = -std::numeric_limits<double>::infinity(),
+                     qint64 staleBefore = 0);
+
+    /// Removes all waiting samples, resets `dropped()` counter
+    void clear();
+
+private:
+    struct Port
+    {
+        unsigned numChannels;
+        unsigned firstChannel;
+        QVector<double> times;
+        QVector<QVector<double>> data; ///< per channel
+        QVector<double> held;          ///< last consumed values
+        bool seen;                     ///< received at least one sample
+        double lastTime;
+        qint64 lastArrival;            ///< timestamp of last pack
+    };
+
+    QVector<Port> ports;
+    unsigned _numChannels;
+    unsigned maxPending;
+    quint64 _dropped;
+
+    /// Removes first `n` samples of a port, last one is held
+    static void dropFront(Port& port, unsigned n);
+};
+
+#endif // SAMPLEALIGNER_H
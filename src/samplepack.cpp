@@ -28,6 +28,7 @@ SamplePack::SamplePack(unsigned ns, unsigned nc, bool x)
 
     _numSamples = ns;
     _numChannels = nc;
+    _timestamp = 0;
 
     _yData = new double[_numSamples * _numChannels]();
     if (x)
@@ -47,6 +48,7 @@ SamplePack::SamplePack(const SamplePack& other) :
     if (hasX())
         memcpy(xData(), other.xData(), dataSize);
     memcpy(_yData, other._yData, dataSize * numChannels());
+    _timestamp = other._timestamp;
 }
 
 SamplePack::~SamplePack()
@@ -96,3 +98,13 @@ double* SamplePack::data(unsigned channel)
 {
     return const_cast<double*>(static_cast<const SamplePack&>(*this).data(channel));
 }
+
+qint64 SamplePack::timestamp() const
+{
+    return _timestamp;
+}
+
+void SamplePack::setTimestamp(qint64 ns)
+{
+    _timestamp = ns;
+}
@@ -20,6 +20,8 @@
 #ifndef SAMPLEPACK_H
 #define SAMPLEPACK_H
 
+#include <QtGlobal>
+
 class SamplePack
 {
 public:
@@ -41,8 +43,14 @@ public:
     double* xData();
     double* data(unsigned channel);
 
+    /// Monotonic time (ns) the bytes of this pack arrived, 0 if unknown.
+    /// See `LatencyTracer`.
+    qint64 timestamp() const;
+    void setTimestamp(qint64 ns);
+
 private:
     unsigned _numSamples, _numChannels;
+    qint64 _timestamp;
     double* _xData;
     double* _yData;
 };
@@ -27,12 +27,18 @@ const char SettingGroup_Binary[] = "DataFormat_Binary";
 const char SettingGroup_ASCII[] = "DataFormat_ASCII";
 const char SettingGroup_CustomFrame[] = "DataFormat_CustomFrame";
 const char SettingGroup_ComplexFrame[] = "DataFormat_ComplexFrame";
+const char SettingGroup_FileReplay[] = "DataFormat_FileReplay";
+const char SettingGroup_Delimited[] = "DataFormat_Delimited";
+const char SettingGroup_MultiMessage[] = "DataFormat_MultiMessage";
 const char SettingGroup_Channels[] = "Channels";
 const char SettingGroup_Plot[] = "Plot";
 const char SettingGroup_Commands[] = "Commands";
 const char SettingGroup_Record[] = "Record";
 const char SettingGroup_TextView[] = "TextView";
 const char SettingGroup_UpdateCheck[] = "UpdateCheck";
+const char SettingGroup_Diagnostics[] = "Diagnostics";
+const char SettingGroup_MultiPort[] = "MultiPort";
+const char SettingGroup_LiveExport[] = "LiveExport";
 
 // mainwindow setting keys
 const char SG_MainWindow_Size[] = "size";
@@ -49,9 +55,18 @@ const char SG_Port_Parity[] = "parity";
 const char SG_Port_DataBits[] = "dataBits";
 const char SG_Port_StopBits[] = "stopBits";
 const char SG_Port_FlowControl[] = "flowControl";
+const char SG_Port_NativeBackend[] = "nativeBackend";
+const char SG_Port_ReadSize[] = "readSize";
+const char SG_Port_BufferSize[] = "bufferSize";
+const char SG_Port_Source[] = "source";
+const char SG_Port_NetHost[] = "netHost";
+const char SG_Port_NetPort[] = "netPort";
 
 // data format panel keys
 const char SG_DataFormat_Format[] = "format";
+const char SG_DataFormat_BatchMode[] = "batchMode";
+const char SG_DataFormat_BatchMinBytes[] = "batchMinBytes";
+const char SG_DataFormat_BatchMaxDelay[] = "batchMaxDelay";
 
 // binary stream reader keys
 const char SG_Binary_NumOfChannels[] = "numOfChannels";
@@ -75,6 +90,16 @@ const char SG_CustomFrame_NumberFormat[] = "numberFormat";
 const char SG_CustomFrame_Endianness[] = "endianness";
 const char SG_CustomFrame_Checksum[] = "checksum";
 const char SG_CustomFrame_DebugMode[] = "debugMode";
+const char SG_CustomFrame_Sequence[] = "sequence";
+
+// file replay reader keys
+const char SG_FileReplay_FileName[] = "fileName";
+const char SG_FileReplay_Format[] = "format";
+const char SG_FileReplay_NumOfChannels[] = "numOfChannels";
+const char SG_FileReplay_NumberFormat[] = "numberFormat";
+const char SG_FileReplay_Endianness[] = "endianness";
+const char SG_FileReplay_Rate[] = "rate";
+const char SG_FileReplay_Loop[] = "loop";
 
 // complex framed reader keys
 const char SG_ComplexFrame_NumOfChannels[] = "numOfChannels";
@@ -85,6 +110,19 @@ const char SG_ComplexFrame_NumberFormat[] = "numberFormat";
 const char SG_ComplexFrame_Endianness[] = "endianness";
 const char SG_ComplexFrame_Checksum[] = "checksum";
 const char SG_ComplexFrame_DebugMode[] = "debugMode";
+const char SG_ComplexFrame_Sequence[] = "sequence";
+
+// delimited (COBS/SLIP) reader keys
+const char SG_Delimited_Encoding[] = "encoding";
+const char SG_Delimited_Layout[] = "layout";
+const char SG_Delimited_Endianness[] = "endianness";
+const char SG_Delimited_Checksum[] = "checksum";
+
+// multi message reader keys
+const char SG_MultiMessage_FrameStart[] = "frameStart";
+const char SG_MultiMessage_Messages[] = "messages";
+const char SG_MultiMessage_Endianness[] = "endianness";
+const char SG_MultiMessage_Checksum[] = "checksum";
 
 // channel info keys
 const char SG_Channels_Channel[] = "channel";
@@ -111,6 +149,7 @@ const char SG_Plot_MinorGrid[] = "minorGrid";
 const char SG_Plot_Legend[] = "legend";
 const char SG_Plot_LegendPos[] = "legendPos";
 const char SG_Plot_MultiPlot[] = "multiPlot";
+const char SG_Plot_CachedRendering[] = "cachedRendering";
 const char SG_Plot_Symbols[] = "symbols";
 const char SG_Plot_LineThickness[] = "lineThickness";
 
@@ -130,6 +169,10 @@ const char SG_Record_DisableBuffering[] = "disableBuffering";
 const char SG_Record_Timestamp[]        = "timestamp";
 const char SG_Record_TimestampFormat[]  = "timestampFormat";
 const char SG_Record_Decimals[]         = "decimals";
+const char SG_Record_Checkpoint[]       = "checkpoint";
+const char SG_Record_CheckpointInterval[] = "checkpointInterval";
+const char SG_Record_LastFile[]         = "lastFile";
+const char SG_Record_RawCapture[]       = "rawCapture";
 
 // text view settings keys
 const char SG_TextView_NumLines[] = "numLines";
@@ -139,4 +182,28 @@ const char SG_TextView_Decimals[] = "decimals";
 const char SG_UpdateCheck_Periodic[]  = "periodicCheck";
 const char SG_UpdateCheck_LastCheck[] = "lastCheck";
 
+// diagnostics settings keys
+const char SG_Diagnostics_TraceLatency[] = "traceLatency";
+const char SG_Diagnostics_ShowInStatusBar[] = "showInStatusBar";
+
+// multi port panel keys
+const char SG_MultiPort_Alignment[] = "alignment";
+const char SG_MultiPort_Port[] = "port";
+const char SG_MultiPort_PortName[] = "portName";
+const char SG_MultiPort_BaudRate[] = "baudRate";
+const char SG_MultiPort_DataBits[] = "dataBits";
+const char SG_MultiPort_Parity[] = "parity";
+const char SG_MultiPort_StopBits[] = "stopBits";
+const char SG_MultiPort_FlowControl[] = "flowControl";
+const char SG_MultiPort_TimeChannel[] = "timeChannel";
+const char SG_MultiPort_Format[] = "format";
+
+// live export panel keys
+const char SG_LiveExport_Shm[] = "sharedMemory";
+const char SG_LiveExport_ShmName[] = "sharedMemoryName";
+const char SG_LiveExport_ShmCapacity[] = "sharedMemoryCapacity";
+const char SG_LiveExport_Socket[] = "localSocket";
+const char SG_LiveExport_SocketName[] = "localSocketName";
+const char SG_LiveExport_SocketQueue[] = "localSocketQueue";
+
 #endif // SETTING_DEFINES_H
@@ -0,0 +1,218 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <string.h>
+#include <QtDebug>
+
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "shmexport.h"
+#include "channelinfomodel.h"
+#include "defines.h"
+
+/// Channel table has room for maximum number of channels, so that
+/// segment never has to be resized while readers have it mapped
+#define SHM_MAX_CHANNELS MAX_NUM_CHANNELS
+
+ShmExport::ShmExport(const ChannelInfoModel* infoModel, QObject* parent) :
+    QObject(parent)
+{
+    this->infoModel = infoModel;
+    header = nullptr;
+    mappingSize = 0;
+    numChannels = 0;
+
+    connect(infoModel, &QAbstractItemModel::dataChanged,
+            this, &ShmExport::updateChannelTable);
+    connect(infoModel, &QAbstractItemModel::modelReset,
+            this, &ShmExport::updateChannelTable);
+}
+
+ShmExport::~ShmExport()
+{
+    stop();
+}
+
+bool ShmExport::isSupported()
+{
+#ifdef Q_OS_UNIX
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ShmExport::start(QString name, unsigned capacity)
+{
+    if (isRunning()) stop();
+
+#ifdef Q_OS_UNIX
+    if (!name.startsWith('/')) name.prepend('/');
+    QByteArray cname = name.toLocal8Bit();
+
+    size_t tableOffset = sizeof(ShmHeader);
+    size_t dataOffset = tableOffset + SHM_MAX_CHANNELS * sizeof(ShmChannel);
+    size_t size = dataOffset + size_t(SHM_MAX_CHANNELS) * capacity * sizeof(double);
+
+    // a stale segment may be left from a crash, start fresh
+    shm_unlink(cname.constData());
+    int fd = shm_open(cname.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        qCritical() << "Can't create shared memory" << name << ":" << strerror(errno);
+        return false;
+    }
+
+    if (ftruncate(fd, size) < 0)
+    {
+        qCritical() << "Can't resize shared memory" << name << ":" << strerror(errno);
+        ::close(fd);
+        shm_unlink(cname.constData());
+        return false;
+    }
+
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);                // mapping stays valid
+    if (mem == MAP_FAILED)
+    {
+        qCritical() << "Can't map shared memory" << name << ":" << strerror(errno);
+        shm_unlink(cname.constData());
+        return false;
+    }
+
+    // new segment is zero filled
+    header = static_cast<ShmHeader*>(mem);
+    memcpy(header->magic, "SPLOTSHM", sizeof(header->magic));
+    header->version = SHM_EXPORT_VERSION;
+    header->headerSize = sizeof(ShmHeader);
+    header->maxChannels = SHM_MAX_CHANNELS;
+    header->capacity = capacity;
+    header->channelTableOffset = tableOffset;
+    header->dataOffset = dataOffset;
+
+    _name = name;
+    mappingSize = size;
+    updateChannelTable();
+    return true;
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(capacity);
+    qCritical() << "Shared memory export isn't supported on this platform.";
+    return false;
+#endif
+}
+
+void ShmExport::stop()
+{
+    if (!isRunning()) return;
+
+#ifdef Q_OS_UNIX
+    // readers that still have it mapped keep the memory until they unmap
+    munmap(header, mappingSize);
+    shm_unlink(_name.toLocal8Bit().constData());
+#endif
+    header = nullptr;
+    mappingSize = 0;
+}
+
+quint64 ShmExport::samplesWritten() const
+{
+    if (!isRunning()) return 0;
+    return __atomic_load_n(&header->writeIndex, __ATOMIC_RELAXED);
+}
+
+void ShmExport::setNumChannels(unsigned nc, bool x)
+{
+    numChannels = nc;
+    updateChannelTable();
+
+    Sink::setNumChannels(nc, x);
+}
+
+void ShmExport::updateChannelTable()
+{
+    if (!isRunning()) return;
+
+    // odd sequence tells readers that table is being changed
+    quint64 seq = header->layoutSeq;
+    __atomic_store_n(&header->layoutSeq, seq + 1, __ATOMIC_RELEASE);
+
+    unsigned nc = std::min(numChannels, unsigned(SHM_MAX_CHANNELS));
+    header->numChannels = nc;
+
+    auto table = reinterpret_cast<ShmChannel*>(
+        reinterpret_cast<char*>(header) + header->channelTableOffset);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        ShmChannel& ch = table[ci];
+        memset(&ch, 0, sizeof(ch));
+        if (ci >= unsigned(infoModel->rowCount())) continue;
+
+        QByteArray name = infoModel->name(ci).toUtf8();
+        memcpy(ch.name, name.constData(), std::min(size_t(name.size()), sizeof(ch.name) - 1));
+        ch.gain = infoModel->gain(ci);
+        ch.offset = infoModel->offset(ci);
+        ch.flags = (infoModel->gainEn(ci) ? ShmChannel_GainEn : 0) |
+            (infoModel->offsetEn(ci) ? ShmChannel_OffsetEn : 0);
+    }
+
+    __atomic_store_n(&header->layoutSeq, seq + 2, __ATOMIC_RELEASE);
+}
+
+void ShmExport::feedIn(const SamplePack& data)
+{
+    if (isRunning())
+    {
+        unsigned nc = std::min(data.numChannels(), header->numChannels);
+        quint64 capacity = header->capacity;
+        quint64 index = header->writeIndex;
+        unsigned ns = data.numSamples();
+        double* ring = reinterpret_cast<double*>(
+            reinterpret_cast<char*>(header) + header->dataOffset);
+
+        // only the last `capacity` samples would survive anyway
+        unsigned skip = ns > capacity ? ns - capacity : 0;
+        quint64 start = (index + skip) % capacity;
+        unsigned n = ns - skip;
+        unsigned first = std::min(quint64(n), capacity - start); // until wrap around
+
+        // announce the overwritten range before touching it (seqlock style)
+        __atomic_store_n(&header->writeEnd, index + ns, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            const double* src = data.data(ci) + skip;
+            double* dst = ring + ci * capacity;
+            memcpy(dst + start, src, first * sizeof(double));
+            memcpy(dst, src + first, (n - first) * sizeof(double));
+        }
+
+        header->timestamp = data.timestamp();
+        __atomic_store_n(&header->writeIndex, index + ns, __ATOMIC_RELEASE);
+    }
+
+    Sink::feedIn(data);
+}
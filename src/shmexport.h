@@ -0,0 +1,137 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHMEXPORT_H
+#define SHMEXPORT_H
+
+#include <QObject>
+#include <QString>
+#include <QtGlobal>
+
+#include "sink.h"
+
+class ChannelInfoModel;
+
+/**
+ * Shared memory layout, all fields are in host byte order.
+ *
+ * Segment starts with a `ShmHeader`, followed by `maxChannels`
+ * `ShmChannel` entries at `channelTableOffset` and sample data at
+ * `dataOffset`. Data is a ring of `capacity` samples (doubles) per
+ * channel, stored channel after channel; sample `n` of channel `c`
+ * is at `data[c * capacity + n % capacity]`.
+ *
+ * `writeIndex` is the sequence number of the next sample, it's
+ * increased (with release semantics) after samples are written.
+ * `writeEnd` is set to the new `writeIndex` before samples are
+ * written, so samples from `writeEnd - capacity` on are never being
+ * overwritten. A reader should read `writeIndex` (acquire), copy
+ * samples it needs and then read `writeEnd` (acquire); samples older
+ * than `writeEnd - capacity` of this read may be torn, drop them.
+ *
+ * `layoutSeq` is odd while number of channels or channel table is
+ * being changed and it's increased after each change. Readers should
+ * re-read the channel table when it changes.
+ */
+struct ShmHeader
+{
+    char magic[8];              ///< "SPLOTSHM"
+    quint32 version;            ///< `SHM_EXPORT_VERSION`
+    quint32 headerSize;         ///< size of this struct
+    quint32 maxChannels;        ///< entries in channel table
+    quint32 numChannels;        ///< channels in use
+    quint64 capacity;           ///< samples per channel in ring
+    quint64 channelTableOffset;
+    quint64 dataOffset;
+    quint64 layoutSeq;
+    quint64 writeIndex;
+    qint64 timestamp;           ///< arrival time (monotonic ns) of last written samples, 0 if unknown
+    quint64 writeEnd;           ///< `writeIndex` after the write in progress
+    quint64 reserved[3];
+};
+
+/// Channel metadata, samples are exported with gain and offset applied
+struct ShmChannel
+{
+    char name[56];              ///< UTF-8, null terminated
+    double gain;
+    double offset;
+    quint32 flags;              ///< `ShmChannel_GainEn | ShmChannel_OffsetEn`
+    quint32 reserved;
+};
+
+const quint32 SHM_EXPORT_VERSION = 1;
+const quint32 ShmChannel_GainEn = 1;
+const quint32 ShmChannel_OffsetEn = 2;
+
+static_assert(sizeof(ShmHeader) == 104, "ShmHeader layout changed");
+static_assert(sizeof(ShmChannel) == 80, "ShmChannel layout changed");
+
+/**
+ * A `Sink` that publishes incoming samples into a POSIX shared
+ * memory segment so that other local processes can read the live
+ * stream without copying it through a socket. Should be connected as
+ * a follower of `Stream` to get calibrated samples.
+ *
+ * Writing never blocks; readers that fall behind lose the oldest
+ * samples. See `ShmHeader` for the layout.
+ */
+class ShmExport : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit ShmExport(const ChannelInfoModel* infoModel, QObject* parent = 0);
+    ~ShmExport();
+
+    /// Returns true if shared memory export is available on this platform
+    static bool isSupported();
+
+    /**
+     * Creates the shared memory segment. Existing segment with the
+     * same name is replaced.
+     *
+     * @param name segment name, ex: "/serialplot"
+     * @param capacity samples per channel in ring
+     * @return false on error
+     */
+    bool start(QString name, unsigned capacity);
+    /// Removes the shared memory segment
+    void stop();
+    bool isRunning() const {return header != nullptr;};
+
+    /// Total samples written per channel since start
+    quint64 samplesWritten() const;
+
+protected:
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    const ChannelInfoModel* infoModel;
+    QString _name;
+    ShmHeader* header;          ///< start of the mapping, `nullptr` when stopped
+    size_t mappingSize;
+    unsigned numChannels;
+
+    /// Copies channel names, gains and offsets into channel table
+    void updateChannelTable();
+};
+
+#endif // SHMEXPORT_H
@@ -0,0 +1,83 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one
+ * consumer thread. `push` and `pop` never block; `push` fails when
+ * queue is full, `pop` fails when it's empty.
+ *
+ * Capacity is rounded up to a power of 2.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(unsigned capacity)
+    {
+        unsigned size = 2;
+        while (size < capacity) size *= 2;
+        slots.resize(size);
+        mask = size - 1;
+        head = 0;
+        tail = 0;
+    }
+
+    /// Called by producer, returns false if queue is full
+    bool push(const T& value)
+    {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) return false;
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Called by consumer, returns false if queue is empty
+    bool pop(T& value)
+    {
+        unsigned h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        value = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Number of queued items, approximate if called while in use
+    unsigned size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    unsigned capacity() const {return mask + 1;};
+
+private:
+    std::vector<T> slots;
+    unsigned mask;
+    // head and tail are on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<unsigned> head; ///< next slot to pop
+    alignas(64) std::atomic<unsigned> tail; ///< next slot to push
+};
+
+#endif // SPSCQUEUE_H
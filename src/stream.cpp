@@ -21,16 +21,21 @@
 #include "ringbuffer.h"
 #include "indexbuffer.h"
 #include "linindexbuffer.h"
+#include "latencytracer.h"
+#include "perfcounters.h"
 
 Stream::Stream(unsigned nc, bool x, unsigned ns) :
     _infoModel(nc)
 {
     _numSamples = ns;
+    _sampleCount = 0;
     _paused = false;
 
     xAsIndex = true;
     xMin = 0;
     xMax = 1;
+    latencyTracer = nullptr;
+    perfCounters = nullptr;
 
     // create xdata buffer
     _hasx = x;
@@ -217,6 +222,9 @@ void Stream::feedIn(const SamplePack& pack)
 
     if (_paused) return;
 
+    bool tracing = latencyTracer != nullptr && latencyTracer->isEnabled() && pack.timestamp();
+    qint64 decodeTime = tracing ? LatencyTracer::now() : 0;
+
     unsigned ns = pack.numSamples();
     if (_hasx)
     {
@@ -236,6 +244,14 @@ void Stream::feedIn(const SamplePack& pack)
         double* data = (mPack == nullptr) ? pack.data(ci) : mPack->data(ci);
         buf->addSamples(data, ns);
     }
+    _sampleCount += ns;
+
+    if (tracing)
+    {
+        qint64 t = LatencyTracer::now();
+        latencyTracer->record(LatencyTracer::DecodeToStore, t - decodeTime);
+        latencyTracer->markStored(pack.timestamp(), t);
+    }
 
     Sink::feedIn((mPack == nullptr) ? pack : *mPack);
 
@@ -243,6 +259,23 @@ void Stream::feedIn(const SamplePack& pack)
     emit dataAdded();
 }
 
+void Stream::setLatencyTracer(LatencyTracer* tracer)
+{
+    latencyTracer = tracer;
+}
+
+void Stream::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+    updateBufferGauge();
+}
+
+void Stream::updateBufferGauge()
+{
+    if (perfCounters == nullptr) return;
+    PerfCounters::set(perfCounters->bufferBytesPerChannel, qint64(_numSamples) * sizeof(double));
+}
+
 void Stream::pause(bool paused)
 {
     _paused = paused;
@@ -250,6 +283,7 @@ void Stream::pause(bool paused)
 
 void Stream::clear()
 {
+    _sampleCount = 0;
     for (auto c : channels)
     {
         static_cast<RingBuffer*>(c->yData())->clear();
@@ -266,6 +300,7 @@ void Stream::setNumSamples(unsigned value)
     {
         static_cast<RingBuffer*>(c->yData())->resize(value);
     }
+    updateBufferGauge();
 }
 
 void Stream::setXAxis(bool asIndex, double min, double max)
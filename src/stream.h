@@ -31,6 +31,9 @@
 #include "streamchannel.h"
 #include "framebuffer.h"
 
+class LatencyTracer;
+class PerfCounters;
+
 /**
  * Main waveform storage class. It consists of channels. Channels are
  * synchronized with each other.
@@ -55,6 +58,8 @@ public:
     unsigned numChannels() const;
 
     unsigned numSamples() const;
+    /// Number of samples added since start or last clear
+    quint64 sampleCount() const {return _sampleCount;};
     const StreamChannel* channel(unsigned index) const;
     StreamChannel* channel(unsigned index);
     QVector<const StreamChannel*> allChannels() const;
@@ -66,6 +71,11 @@ public:
     /// Load channel information
     void loadSettings(QSettings* settings);
 
+    /// Sets the latency tracer, can be `nullptr`
+    void setLatencyTracer(LatencyTracer* tracer);
+    /// Sets the performance counters, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
+
 protected:
     // implementations for `Sink`
     virtual void setNumChannels(unsigned nc, bool x);
@@ -94,6 +104,7 @@ public slots:
 
 private:
     unsigned _numSamples;
+    quint64 _sampleCount;
     bool _paused;
 
     bool _hasx;
@@ -105,6 +116,12 @@ private:
     bool xAsIndex;
     double xMin, xMax;
 
+    LatencyTracer* latencyTracer;
+    PerfCounters* perfCounters;
+
+    /// Updates buffer size gauge of `perfCounters`
+    void updateBufferGauge();
+
     /**
      * Applies gain and offset to given pack.
      *
@@ -0,0 +1,262 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <string.h>
+#include <QMutexLocker>
+#include <QtDebug>
+
+#include "udpdevice.h"
+#include "perfcounters.h"
+
+#define DEFAULT_BUFFER_SIZE (1024*1024) // bytes
+#define MAX_BATCH_SIZE      (256*1024)  // bytes, received before notifying
+#define POLL_INTERVAL       100         // ms, to check for stop request
+#define COMPACT_THRESHOLD   (64*1024)   // bytes, see `readData()`
+
+UdpDevice::UdpDevice(QObject* parent) :
+    QIODevice(parent),
+    bufferSize(DEFAULT_BUFFER_SIZE),
+    stopRequested(false),
+    notifyPending(false)
+{
+    localAddress = QHostAddress::Any;
+    _localPort = 0;
+    boundPort = 0;
+    perfCounters = nullptr;
+
+    socket = nullptr;
+    receiverThread = nullptr;
+    bufferHead = 0;
+    lastSenderPort = 0;
+}
+
+UdpDevice::~UdpDevice()
+{
+    close();
+}
+
+void UdpDevice::setLocalAddress(QHostAddress address)
+{
+    localAddress = address;
+}
+
+void UdpDevice::setLocalPort(quint16 port)
+{
+    _localPort = port;
+}
+
+void UdpDevice::setBufferSize(unsigned size)
+{
+    bufferSize = size;
+    spaceAvailable.wakeAll();
+}
+
+void UdpDevice::setPerfCounters(PerfCounters* counters)
+{
+    perfCounters = counters;
+}
+
+bool UdpDevice::open(OpenMode mode)
+{
+    if (isOpen())
+    {
+        setErrorString("Device is already open!");
+        emit errorOccurred(QAbstractSocket::OperationError);
+        return false;
+    }
+
+    // bound here so that errors can be reported synchronously, then
+    // handed over to the receiver thread
+    socket = new QUdpSocket();
+    if (!socket->bind(localAddress, _localPort))
+    {
+        auto error = socket->error();
+        setErrorString(QString("Can't listen on UDP port %1: %2")
+                       .arg(_localPort).arg(socket->errorString()));
+        delete socket;
+        socket = nullptr;
+        emit errorOccurred(error);
+        return false;
+    }
+    boundPort = socket->localPort();
+
+    // bigger kernel buffer rides out short stalls of the receiver
+    socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                            std::min(unsigned(bufferSize), unsigned(MAX_BATCH_SIZE) * 4));
+
+    buffer.clear();
+    bufferHead = 0;
+    lastSender.clear();
+    lastSenderPort = 0;
+    notifyPending = false;
+    stopRequested = false;
+
+    // reads are already buffered by us
+    QIODevice::open(mode | QIODevice::Unbuffered);
+
+    receiverThread = QThread::create([this](){receiveLoop();});
+    socket->moveToThread(receiverThread);
+    receiverThread->start();
+    return true;
+}
+
+void UdpDevice::close()
+{
+    if (!isOpen()) return;
+
+    // emits `aboutToClose`
+    QIODevice::close();
+
+    {
+        QMutexLocker locker(&bufferLock);
+        stopRequested = true;
+        spaceAvailable.wakeAll();
+    }
+    receiverThread->wait();
+    delete receiverThread;
+    receiverThread = nullptr;
+    socket = nullptr;           // deleted by receiver thread
+
+    QMutexLocker locker(&bufferLock);
+    buffer.clear();
+    bufferHead = 0;
+}
+
+void UdpDevice::receiveLoop()
+{
+    QByteArray batch;
+    QHostAddress sender;
+    quint16 senderPort = 0;
+
+    while (!stopRequested)
+    {
+        if (!socket->hasPendingDatagrams() &&
+            !socket->waitForReadyRead(POLL_INTERVAL))
+        {
+            continue;           // timeout or a transient error (ex: ICMP)
+        }
+
+        // drain all pending datagrams, notify once
+        quint64 numDatagrams = 0;
+        batch.resize(0);
+        while (socket->hasPendingDatagrams() && batch.size() < MAX_BATCH_SIZE)
+        {
+            qint64 size = socket->pendingDatagramSize();
+            if (size < 0) break;
+
+            int offset = batch.size();
+            batch.resize(offset + size);
+            qint64 r = socket->readDatagram(batch.data() + offset, size,
+                                            &sender, &senderPort);
+            batch.resize(offset + std::max(qint64(0), r));
+            if (r < 0) break;
+            numDatagrams++;
+        }
+        if (batch.isEmpty()) continue;
+
+        {
+            // buffer is full, wait for the reader
+            QMutexLocker locker(&bufferLock);
+            while (unsigned(buffer.size() - bufferHead) >= bufferSize && !stopRequested)
+            {
+                spaceAvailable.wait(&bufferLock);
+            }
+            if (stopRequested) break;
+
+            buffer.append(batch);
+            lastSender = sender;
+            lastSenderPort = senderPort;
+        }
+
+        if (perfCounters != nullptr)
+        {
+            PerfCounters::inc(perfCounters->portReads, numDatagrams);
+            PerfCounters::inc(perfCounters->portWakeups);
+            PerfCounters::inc(perfCounters->portBytes, batch.size());
+        }
+
+        // a single notification is queued until it's delivered
+        if (!notifyPending.exchange(true))
+        {
+            QMetaObject::invokeMethod(this, "onDataArrived", Qt::QueuedConnection);
+        }
+    }
+
+    // socket belongs to this thread now
+    delete socket;
+}
+
+void UdpDevice::onDataArrived()
+{
+    notifyPending = false;
+    if (isOpen()) emit readyRead();
+}
+
+qint64 UdpDevice::bytesAvailable() const
+{
+    QMutexLocker locker(&bufferLock);
+    return (buffer.size() - bufferHead) + QIODevice::bytesAvailable();
+}
+
+qint64 UdpDevice::readData(char* data, qint64 maxSize)
+{
+    QMutexLocker locker(&bufferLock);
+
+    qint64 n = std::min(maxSize, qint64(buffer.size() - bufferHead));
+    memcpy(data, buffer.constData() + bufferHead, n);
+    bufferHead += n;
+
+    // consumed bytes are dropped lazily, readers may read a few bytes
+    // at a time
+    if (bufferHead == buffer.size())
+    {
+        buffer.resize(0);
+        bufferHead = 0;
+    }
+    else if (bufferHead > COMPACT_THRESHOLD && bufferHead > buffer.size() / 2)
+    {
+        buffer.remove(0, bufferHead);
+        bufferHead = 0;
+    }
+
+    if (n) spaceAvailable.wakeAll();
+    return n;
+}
+
+qint64 UdpDevice::writeData(const char* data, qint64 maxSize)
+{
+    QHostAddress address;
+    quint16 port;
+    {
+        QMutexLocker locker(&bufferLock);
+        address = lastSender;
+        port = lastSenderPort;
+    }
+
+    if (address.isNull())
+    {
+        setErrorString("Nothing received yet, destination is unknown!");
+        return -1;
+    }
+
+    qint64 r = sendSocket.writeDatagram(data, maxSize, address, port);
+    if (r < 0) setErrorString(sendSocket.errorString());
+    return r;
+}
@@ -0,0 +1,116 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UDPDEVICE_H
+#define UDPDEVICE_H
+
+#include <atomic>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QIODevice>
+#include <QMutex>
+#include <QThread>
+#include <QUdpSocket>
+#include <QWaitCondition>
+
+class PerfCounters;
+
+/**
+ * Receives UDP datagrams as a byte stream, so that existing readers
+ * can be used with network devices.
+ *
+ * A receiver thread waits on the socket and drains all pending
+ * datagrams at once into an internal buffer. `readyRead` is signaled
+ * once per batch instead of once per datagram. Datagram boundaries
+ * are not kept; frames should be synchronized by the reader as with
+ * a serial port.
+ *
+ * Written data is sent to the sender of the last received datagram.
+ */
+class UdpDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit UdpDevice(QObject* parent = 0);
+    ~UdpDevice();
+
+    /// Address to listen on, `QHostAddress::Any` by default
+    void setLocalAddress(QHostAddress address);
+    /// Port to listen on, 0 picks a free port (see `localPort()`)
+    void setLocalPort(quint16 port);
+    /// Bound port, valid when open
+    quint16 localPort() const {return boundPort;};
+
+    /**
+     * Maximum number of bytes buffered in user space. When buffer is
+     * full receiver thread stops reading and datagrams are left to
+     * kernel buffer, which drops them when it's full.
+     */
+    void setBufferSize(unsigned size);
+
+    /// Sets the performance counters for reads, can be `nullptr`
+    void setPerfCounters(PerfCounters* counters);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override {return true;};
+    qint64 bytesAvailable() const override;
+
+signals:
+    void errorOccurred(QAbstractSocket::SocketError error);
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QHostAddress localAddress;
+    quint16 _localPort;
+    quint16 boundPort;
+    std::atomic<unsigned> bufferSize;
+    PerfCounters* perfCounters;
+
+    /// Used only by receiver thread after it's started
+    QUdpSocket* socket;
+    QThread* receiverThread;
+    /// Used for writing from the owner thread
+    QUdpSocket sendSocket;
+
+    /// Received data, protected by `bufferLock`
+    mutable QMutex bufferLock;
+    QByteArray buffer;
+    int bufferHead;             ///< start of unread data in `buffer`
+    QHostAddress lastSender;
+    quint16 lastSenderPort;
+    /// Signaled when reader consumes data or device is closing
+    QWaitCondition spaceAvailable;
+    std::atomic<bool> stopRequested;
+    /// Set when a `readyRead` is queued but not yet delivered
+    std::atomic<bool> notifyPending;
+
+    /// Receiver thread main loop
+    void receiveLoop();
+
+private slots:
+    /// Delivered in owner thread after receiver thread appends data
+    void onDataArrived();
+};
+
+#endif // UDPDEVICE_H
@@ -0,0 +1,264 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Microbenchmarks for buffers and stream.
+
+  Each case is repeated until it runs for at least `MIN_CASE_TIME`
+  and the average time per operation is reported. Results can be
+  saved as a baseline (JSON) and later runs can be compared against
+  it. In compare mode exit code is non-zero if any case got slower
+  than the threshold.
+
+  Usage: BenchBuffers [--quick] [--filter TEXT] [--save FILE]
+                      [--compare FILE] [--threshold PERCENT]
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include "ringbuffer.h"
+#include "linindexbuffer.h"
+#include "readonlybuffer.h"
+#include "framebufferseries.h"
+#include "samplepack.h"
+#include "source.h"
+#include "stream.h"
+
+#define MIN_CASE_TIME  200      // ms
+#define MIN_REPEAT     3
+#define DEFAULT_THRESHOLD 10    // percent
+#define PACK_SIZE      100      // samples per feed, similar to a reader
+/// Stream cases over this many samples (all channels) are skipped
+#define MAX_STREAM_SAMPLES (16*1000*1000)
+
+/// Feeds the stream, like a reader would
+class BenchSource : public Source
+{
+public:
+    unsigned nc;
+
+    BenchSource(unsigned nc) {this->nc = nc;}
+    unsigned numChannels() const override {return nc;}
+    bool hasX() const override {return false;}
+    void feed(const SamplePack& data) const {feedOut(data);}
+};
+
+struct Result
+{
+    QString name;
+    double nsPerOp;
+    double nsPerSample;
+};
+
+/// Runs `op` repeatedly and returns average ns per call
+static double measure(std::function<void()> op)
+{
+    op(); // warm up
+    QElapsedTimer timer;
+    unsigned repeat = 0;
+    timer.start();
+    do
+    {
+        op();
+        repeat++;
+    } while (repeat < MIN_REPEAT || timer.elapsed() < MIN_CASE_TIME);
+    return double(timer.nsecsElapsed()) / repeat;
+}
+
+static void fillRandom(double* data, unsigned n, unsigned seed)
+{
+    for (unsigned i = 0; i < n; i++)
+    {
+        data[i] = sin((i + seed) * 0.001) * 100 + ((i * 7919 + seed) % 97);
+    }
+}
+
+static QString sizeStr(unsigned n)
+{
+    if (n >= 1000000) return QString("%1M").arg(n / 1000000);
+    if (n >= 1000) return QString("%1K").arg(n / 1000);
+    return QString::number(n);
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    bool quick = false;
+    QString filter, saveFile, compareFile;
+    double threshold = DEFAULT_THRESHOLD;
+
+    QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); i++)
+    {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "--quick") quick = true;
+        else if (args[i] == "--filter" && hasValue) filter = args[++i];
+        else if (args[i] == "--save" && hasValue) saveFile = args[++i];
+        else if (args[i] == "--compare" && hasValue) compareFile = args[++i];
+        else if (args[i] == "--threshold" && hasValue) threshold = args[++i].toDouble();
+        else
+        {
+            fprintf(stderr, "Unknown argument: %s\n", qPrintable(args[i]));
+            return 2;
+        }
+    }
+
+    // fail before spending minutes on benchmarks with nothing to compare to
+    if (!compareFile.isEmpty() && !QFile::exists(compareFile))
+    {
+        fprintf(stderr, "Baseline file %s doesn't exist, create one on this machine with:\n"
+                "  BenchBuffers --save %s\n",
+                qPrintable(compareFile), qPrintable(compareFile));
+        return 2;
+    }
+
+    std::vector<unsigned> sizes = {1000, 10000, 100000, 1000000, 10000000};
+    if (quick) sizes.pop_back();
+    const unsigned channelCounts[] = {1, 16, 256};
+
+    std::vector<Result> results;
+    auto run = [&](QString name, unsigned samplesPerOp, std::function<void()> op)
+    {
+        if (!filter.isEmpty() && !name.contains(filter, Qt::CaseInsensitive)) return;
+        double ns = measure(op);
+        results.push_back({name, ns, ns / samplesPerOp});
+        printf("%-40s %14.1f ns/op %10.3f ns/sample\n",
+               qPrintable(name), ns, ns / samplesPerOp);
+        fflush(stdout);
+    };
+
+    std::vector<double> pack(PACK_SIZE);
+    fillRandom(pack.data(), PACK_SIZE, 1);
+
+    for (unsigned n : sizes)
+    {
+        RingBuffer rb(n);
+        std::vector<double> full(n);
+        fillRandom(full.data(), n, 0);
+        rb.addSamples(full.data(), n);
+
+        run(QString("RingBuffer::addSamples/%1").arg(sizeStr(n)), PACK_SIZE,
+            [&]{rb.addSamples(pack.data(), PACK_SIZE);});
+
+        // limits after an add, cache is invalid each time
+        run(QString("RingBuffer::limits/%1").arg(sizeStr(n)), n,
+            [&]{rb.addSamples(pack.data(), 1); rb.limits();});
+
+        run(QString("ReadOnlyBuffer::ReadOnlyBuffer/%1").arg(sizeStr(n)), n,
+            [&]{ReadOnlyBuffer rob(&rb); (void) rob.size();});
+
+        LinIndexBuffer xb(n, 0, n - 1);
+        FrameBufferSeries series(&xb, &rb);
+        // zoomed in to the middle 10%
+        QRectF zoomRect(n * 0.45, -1000, n * 0.1, 2000);
+        run(QString("FrameBufferSeries::setRectOfInterest/%1").arg(sizeStr(n)), 1,
+            [&]{series.setRectOfInterest(zoomRect); (void) series.size();});
+    }
+
+    for (unsigned nc : channelCounts)
+    {
+        SamplePack sp(PACK_SIZE, nc);
+        for (unsigned ci = 0; ci < nc; ci++) fillRandom(sp.data(ci), PACK_SIZE, ci);
+
+        for (unsigned n : sizes)
+        {
+            if (quint64(n) * nc > MAX_STREAM_SAMPLES) continue;
+
+            Stream stream(nc, false, n);
+            BenchSource source(nc);
+            source.connectSink(&stream);
+            run(QString("Stream::feedIn/%1x%2").arg(sizeStr(n)).arg(nc), PACK_SIZE * nc,
+                [&]{source.feed(sp);});
+
+            auto info = stream.infoModel();
+            for (unsigned ci = 0; ci < nc; ci++)
+            {
+                info->setData(info->index(ci, ChannelInfoModel::COLUMN_GAIN), Qt::Checked, Qt::CheckStateRole);
+                info->setData(info->index(ci, ChannelInfoModel::COLUMN_GAIN), 2.0, Qt::EditRole);
+                info->setData(info->index(ci, ChannelInfoModel::COLUMN_OFFSET), Qt::Checked, Qt::CheckStateRole);
+                info->setData(info->index(ci, ChannelInfoModel::COLUMN_OFFSET), 1.0, Qt::EditRole);
+            }
+            run(QString("Stream::feedIn+gain/%1x%2").arg(sizeStr(n)).arg(nc), PACK_SIZE * nc,
+                [&]{source.feed(sp);});
+        }
+    }
+
+    if (!saveFile.isEmpty())
+    {
+        QJsonObject obj;
+        for (auto& r : results) obj[r.name] = r.nsPerOp;
+
+        QFile file(saveFile);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            fprintf(stderr, "Couldn't open baseline file for writing: %s\n",
+                    qPrintable(file.errorString()));
+            return 2;
+        }
+        file.write(QJsonDocument(obj).toJson());
+        printf("Baseline saved to %s\n", qPrintable(saveFile));
+    }
+
+    if (!compareFile.isEmpty())
+    {
+        QFile file(compareFile);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            fprintf(stderr, "Couldn't open baseline file: %s\n",
+                    qPrintable(file.errorString()));
+            return 2;
+        }
+        QJsonObject baseline = QJsonDocument::fromJson(file.readAll()).object();
+
+        unsigned numSlower = 0;
+        printf("\n%-40s %14s %14s %9s\n", "case", "baseline", "current", "change");
+        for (auto& r : results)
+        {
+            if (!baseline.contains(r.name)) continue;
+
+            double base = baseline[r.name].toDouble();
+            double change = (r.nsPerOp - base) / base * 100;
+            bool slower = change > threshold;
+            if (slower) numSlower++;
+            printf("%-40s %14.1f %14.1f %+8.1f%%%s\n", qPrintable(r.name),
+                   base, r.nsPerOp, change, slower ? "  SLOWER" : "");
+        }
+
+        if (numSlower)
+        {
+            printf("\n%u case(s) slower than baseline by more than %.0f%%\n",
+                   numSlower, threshold);
+            return 1;
+        }
+    }
+
+    return 0;
+}
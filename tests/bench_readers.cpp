@@ -0,0 +1,445 @@
+/*
+  Copyright © 2026 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Throughput benchmark for readers. Catch version we use doesn't
+  support benchmarks so this is a standalone program.
+
+  A large byte stream is prepared for each case and fed to the reader
+  through a `QBuffer` in chunks, similar to how serial port delivers
+  data. Results are printed as a table. Raw throughput of checksum
+  algorithms is printed first to show validation cost per MB.
+
+  Usage: BenchReaders [--size MB] [--chunk BYTES] [--filter TEXT]
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <QApplication>
+#include <QBuffer>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "framedreader.h"
+#include "complexframedreader.h"
+#include "delimitedreader.h"
+#include "checksum.h"
+#include "sink.h"
+#include "setting_defines.h"
+
+/// Counts the samples it receives, nothing else
+class CountingSink : public Sink
+{
+public:
+    quint64 samples = 0;        ///< total number of values (all channels)
+
+    void feedIn(const SamplePack& data) override
+    {
+        samples += quint64(data.numSamples()) * data.numChannels();
+        Sink::feedIn(data);
+    }
+};
+
+struct Case
+{
+    QString reader;
+    QString format;
+    unsigned channels;
+    ChecksumType checksum;
+    /// Builds the input, only called for cases that run; streams are
+    /// big, building all of them up front would take a lot of memory
+    std::function<QByteArray()> stream;
+    /// Creates and configures the reader
+    std::function<AbstractReader*(QBuffer*, QSettings*)> create;
+};
+
+static unsigned formatSize(NumberFormat nf)
+{
+    switch (nf)
+    {
+        case NumberFormat_uint8: case NumberFormat_int8: return 1;
+        case NumberFormat_uint16: case NumberFormat_int16: return 2;
+        case NumberFormat_uint32: case NumberFormat_int32: case NumberFormat_float: return 4;
+        case NumberFormat_double: return 8;
+        default: return 0;
+    }
+}
+
+/// Appends a sample in [-1, 1] range in given format (little endian)
+static void appendSample(QByteArray& out, double v, NumberFormat nf)
+{
+    char buf[8];
+    switch (nf)
+    {
+        case NumberFormat_uint8: qToLittleEndian<quint8>(lround((v + 1) * 127), buf); break;
+        case NumberFormat_int8: qToLittleEndian<qint8>(lround(v * 127), buf); break;
+        case NumberFormat_uint16: qToLittleEndian<quint16>(lround((v + 1) * 32767), buf); break;
+        case NumberFormat_int16: qToLittleEndian<qint16>(lround(v * 32767), buf); break;
+        case NumberFormat_uint32: qToLittleEndian<quint32>(llround((v + 1) * 2147483647.), buf); break;
+        case NumberFormat_int32: qToLittleEndian<qint32>(lround(v * 2147483647.), buf); break;
+        case NumberFormat_float: qToLittleEndian<float>(v, buf); break;
+        case NumberFormat_double: qToLittleEndian<double>(v, buf); break;
+        default: return;
+    }
+    out.append(buf, formatSize(nf));
+}
+
+static double waveform(unsigned i, unsigned ci)
+{
+    return sin(2 * M_PI * ((i * (ci + 1)) % 1000) / 1000.);
+}
+
+static QByteArray binaryStream(qint64 size, unsigned nc, NumberFormat nf)
+{
+    QByteArray out;
+    out.reserve(size + 64);
+    for (unsigned i = 0; out.size() < size; i++)
+    {
+        for (unsigned ci = 0; ci < nc; ci++) appendSample(out, waveform(i, ci), nf);
+    }
+    return out;
+}
+
+/// Frames of `frameSamples` sample sets with sync word AA BB
+static QByteArray framedStream(qint64 size, unsigned nc, NumberFormat nf,
+                               unsigned frameSamples, ChecksumType checksumType)
+{
+    QByteArray out;
+    out.reserve(size + 1024);
+    unsigned i = 0;
+    while (out.size() < size)
+    {
+        out.append("\xAA\xBB", 2);
+        qint64 payloadStart = out.size();
+        for (unsigned si = 0; si < frameSamples; si++, i++)
+        {
+            for (unsigned ci = 0; ci < nc; ci++) appendSample(out, waveform(i, ci), nf);
+        }
+        if (checksumType != Checksum_none)
+        {
+            quint32 sum = checksum(checksumType, (const uchar*) out.constData() + payloadStart,
+                                   out.size() - payloadStart);
+            char buf[4];
+            qToLittleEndian<quint32>(sum, buf);
+            out.append(buf, checksumSize(checksumType));
+        }
+    }
+    return out;
+}
+
+/// Appends COBS encoding of `data` followed by the delimiter
+static void appendCobs(QByteArray& out, const QByteArray& data)
+{
+    qint64 codePos = out.size();
+    out.append('\x01');
+    uchar code = 1;
+    for (char c : data)
+    {
+        // a full block doesn't imply a zero
+        if (code == 0xFF)
+        {
+            out[codePos] = char(code);
+            codePos = out.size();
+            out.append('\x01');
+            code = 1;
+        }
+        if (c == 0)
+        {
+            out[codePos] = char(code);
+            codePos = out.size();
+            out.append('\x01');
+            code = 1;
+            continue;
+        }
+        out.append(c);
+        code++;
+    }
+    out[codePos] = char(code);
+    out.append('\0');
+}
+
+/// COBS encoded frames of `frameSamples` sample sets
+static QByteArray cobsStream(qint64 size, unsigned nc, NumberFormat nf,
+                             unsigned frameSamples, ChecksumType checksumType)
+{
+    QByteArray out, frame;
+    out.reserve(size + 1024);
+    unsigned i = 0;
+    while (out.size() < size)
+    {
+        frame.clear();
+        for (unsigned si = 0; si < frameSamples; si++, i++)
+        {
+            for (unsigned ci = 0; ci < nc; ci++) appendSample(frame, waveform(i, ci), nf);
+        }
+        if (checksumType != Checksum_none)
+        {
+            quint32 sum = checksum(checksumType, (const uchar*) frame.constData(), frame.size());
+            char buf[4];
+            qToLittleEndian<quint32>(sum, buf);
+            frame.append(buf, checksumSize(checksumType));
+        }
+        appendCobs(out, frame);
+    }
+    return out;
+}
+
+static QByteArray asciiStream(qint64 size, unsigned nc)
+{
+    QByteArray out;
+    out.reserve(size + 1024);
+    for (unsigned i = 0; out.size() < size; i++)
+    {
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            if (ci) out.append(',');
+            out.append(QByteArray::number(waveform(i, ci), 'f', 4));
+        }
+        out.append('\n');
+    }
+    return out;
+}
+
+/**
+ * Feeds the stream to reader in chunks and returns elapsed time in
+ * nanoseconds.
+ */
+static qint64 run(QBuffer* buffer, const QByteArray& stream, int chunkSize)
+{
+    QByteArray& data = buffer->buffer();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (qint64 pos = 0; pos < stream.size(); pos += chunkSize)
+    {
+        // drop consumed bytes so buffer stays small
+        qint64 readPos = buffer->pos();
+        data.remove(0, readPos);
+
+        data.append(stream.constData() + pos, std::min<qint64>(chunkSize, stream.size() - pos));
+        buffer->seek(0);
+
+        // signal directly instead of through the event loop
+        QMetaObject::invokeMethod(buffer, "readyRead", Qt::DirectConnection);
+    }
+
+    return timer.nsecsElapsed();
+}
+
+static void setFramedSettings(QSettings* s, const char* group, unsigned nc,
+                              NumberFormat nf, unsigned frameSamples, ChecksumType checksum)
+{
+    s->beginGroup(group);
+    // keys are same for both framed readers
+    s->setValue(SG_CustomFrame_NumOfChannels, nc);
+    s->setValue(SG_CustomFrame_NumberFormat, numberFormatToStr(nf));
+    s->setValue(SG_CustomFrame_Endianness, "little");
+    s->setValue(SG_CustomFrame_FrameStart, "AA BB");
+    s->setValue(SG_CustomFrame_SizeFieldType, "fixed");
+    s->setValue(SG_CustomFrame_FixedFrameSize, frameSamples * nc * formatSize(nf));
+    s->setValue(SG_CustomFrame_Checksum, checksumTypeToStr(checksum));
+    s->setValue(SG_CustomFrame_DebugMode, false);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        s->setValue(QString("ChannelFormat_%1").arg(ci), numberFormatToStr(nf));
+    }
+    s->endGroup();
+}
+
+/// Prints throughput of checksum calculation over a large buffer
+static void benchChecksums(qint64 size)
+{
+    QByteArray data(size, 0);
+    for (qint64 i = 0; i < size; i++) data[i] = char(i * 7 + (i >> 8));
+    const uchar* p = (const uchar*) data.constData();
+
+    printf("%-14s %10s %10s\n", "checksum", "MB/s", "us/MB");
+    for (ChecksumType type : {Checksum_sum8, Checksum_crc16, Checksum_crc32})
+    {
+        QElapsedTimer timer;
+        timer.start();
+        volatile quint32 result = checksum(type, p, size);
+        Q_UNUSED(result);
+        double seconds = timer.nsecsElapsed() * 1e-9;
+
+        printf("%-14s %10.1f %10.1f\n", qPrintable(checksumTypeToStr(type)),
+               size / seconds / 1e6, seconds * 1e6 / (size / 1e6));
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    // readers need their settings widgets, no need to show anything though
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    qint64 size = 16 * 1024 * 1024;
+    int chunkSize = 4096;
+    QString filter;
+
+    QStringList args = app.arguments();
+    for (int i = 1; i < args.size() - 1; i++)
+    {
+        if (args[i] == "--size") size = args[++i].toLongLong() * 1024 * 1024;
+        else if (args[i] == "--chunk") chunkSize = args[++i].toInt();
+        else if (args[i] == "--filter") filter = args[++i];
+    }
+
+    QTemporaryDir tempDir;
+    const unsigned channelCounts[] = {1, 4, 16};
+    const unsigned frameSamples = 10;
+
+    std::vector<Case> cases;
+    for (unsigned nc : channelCounts)
+    {
+        for (NumberFormat nf : {NumberFormat_uint8, NumberFormat_int16,
+                                NumberFormat_float, NumberFormat_double})
+        {
+            cases.push_back({"Binary", numberFormatToStr(nf), nc, Checksum_none,
+                             [=]{return binaryStream(size, nc, nf);},
+                             [nc, nf](QBuffer* dev, QSettings* s) -> AbstractReader*
+                             {
+                                 s->beginGroup(SettingGroup_Binary);
+                                 s->setValue(SG_Binary_NumOfChannels, nc);
+                                 s->setValue(SG_Binary_NumberFormat, numberFormatToStr(nf));
+                                 s->setValue(SG_Binary_Endianness, "little");
+                                 s->endGroup();
+                                 auto r = new BinaryStreamReader(dev);
+                                 r->loadSettings(s);
+                                 return r;
+                             }});
+        }
+
+        for (NumberFormat nf : {NumberFormat_int16, NumberFormat_float})
+        {
+            for (ChecksumType checksum : {Checksum_none, Checksum_sum8,
+                                          Checksum_crc16, Checksum_crc32})
+            {
+                auto stream = [=]{return framedStream(size, nc, nf, frameSamples, checksum);};
+                cases.push_back({"Framed", numberFormatToStr(nf), nc, checksum, stream,
+                                 [=](QBuffer* dev, QSettings* s) -> AbstractReader*
+                                 {
+                                     setFramedSettings(s, SettingGroup_CustomFrame,
+                                                       nc, nf, frameSamples, checksum);
+                                     auto r = new FramedReader(dev);
+                                     r->loadSettings(s);
+                                     return r;
+                                 }});
+                cases.push_back({"ComplexFramed", numberFormatToStr(nf), nc, checksum, stream,
+                                 [=](QBuffer* dev, QSettings* s) -> AbstractReader*
+                                 {
+                                     setFramedSettings(s, SettingGroup_ComplexFrame,
+                                                       nc, nf, frameSamples, checksum);
+                                     auto r = new ComplexFramedReader(dev);
+                                     r->loadSettings(s);
+                                     return r;
+                                 }});
+                cases.push_back({"Delimited", numberFormatToStr(nf), nc, checksum,
+                                 [=]{return cobsStream(size, nc, nf, frameSamples, checksum);},
+                                 [=](QBuffer* dev, QSettings* s) -> AbstractReader*
+                                 {
+                                     s->beginGroup(SettingGroup_Delimited);
+                                     s->setValue(SG_Delimited_Encoding, "cobs");
+                                     s->setValue(SG_Delimited_Layout,
+                                                 QString("%1*%2").arg(nc).arg(numberFormatToStr(nf)));
+                                     s->setValue(SG_Delimited_Endianness, "little");
+                                     s->setValue(SG_Delimited_Checksum, checksumTypeToStr(checksum));
+                                     s->endGroup();
+                                     auto r = new DelimitedReader(dev);
+                                     r->loadSettings(s);
+                                     return r;
+                                 }});
+            }
+        }
+
+        cases.push_back({"Ascii", "text", nc, Checksum_none, [=]{return asciiStream(size, nc);},
+                         [nc](QBuffer* dev, QSettings* s) -> AbstractReader*
+                         {
+                             s->beginGroup(SettingGroup_ASCII);
+                             s->setValue(SG_ASCII_NumOfChannels, nc);
+                             s->setValue(SG_ASCII_Delimiter, ",");
+                             s->endGroup();
+                             auto r = new AsciiReader(dev);
+                             r->loadSettings(s);
+                             return r;
+                         }});
+    }
+
+    if (filter.isEmpty() || QString("checksum").contains(filter, Qt::CaseInsensitive))
+    {
+        benchChecksums(size);
+    }
+
+    printf("%-14s %-7s %8s %8s %10s %14s\n",
+           "reader", "format", "channels", "checksum", "MB/s", "Msamples/s");
+
+    int caseIndex = 0;
+    for (auto& c : cases)
+    {
+        QString name = QString("%1 %2 %3 %4").arg(c.reader, c.format).arg(c.channels)
+            .arg(checksumTypeToStr(c.checksum));
+        if (!filter.isEmpty() && !name.contains(filter, Qt::CaseInsensitive)) continue;
+
+        QSettings settings(tempDir.filePath(QString("bench%1.ini").arg(caseIndex++)),
+                           QSettings::IniFormat);
+        QBuffer buffer;
+        buffer.open(QIODevice::ReadWrite);
+
+        AbstractReader* reader = c.create(&buffer, &settings);
+        CountingSink sink;
+        reader->connectSink(&sink);
+        reader->enable(true);
+
+        QByteArray stream = c.stream();
+        qint64 ns = run(&buffer, stream, chunkSize);
+        double seconds = ns * 1e-9;
+
+        printf("%-14s %-7s %8u %8s %10.1f %14.2f\n",
+               qPrintable(c.reader), qPrintable(c.format), c.channels,
+               qPrintable(checksumTypeToStr(c.checksum)),
+               stream.size() / seconds / 1e6,
+               sink.samples / seconds / 1e6);
+        fflush(stdout);
+
+        if (sink.samples == 0)
+        {
+            fprintf(stderr, "Warning: no samples were read in this case!\n");
+        }
+
+        reader->enable(false);
+        delete reader;
+    }
+
+    return 0;
+}
@@ -20,12 +20,26 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
 #include "samplepack.h"
 #include "source.h"
 #include "indexbuffer.h"
 #include "linindexbuffer.h"
 #include "ringbuffer.h"
 #include "readonlybuffer.h"
+#include "latencytracer.h"
+#include "perfcounters.h"
+#include "checksum.h"
+#include "decodeplan.h"
+#include "packedformat.h"
+#include "spscqueue.h"
+#include "samplealigner.h"
+#include "channelinfomodel.h"
+#include "shmexport.h"
 
 #include "test_helpers.h"
 
@@ -68,7 +82,10 @@ TEST_CASE("samplepack copy", "[memory]")
         pack.data(2)[i] = i*3;
     }
 
+    pack.setTimestamp(1234);
+
     SamplePack other = pack;
+    REQUIRE(other.timestamp() == 1234);
     // compare
     for (int i = 0; i < 10; i++)
     {
@@ -340,6 +357,58 @@ TEST_CASE("RingBuffer limits", "[memory, buffer]")
     REQUIRE(lim.end == 9.);
 }
 
+TEST_CASE("RingBuffer limits should skip gaps", "[memory, buffer]")
+{
+    RingBuffer buf(4);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    double values[4] = {nan, 3, nan, -2};
+
+    buf.addSamples(values, 4);
+    auto lim = buf.limits();
+    REQUIRE(lim.start == -2.);
+    REQUIRE(lim.end == 3.);
+
+    // all gap
+    buf.addSamples(values, 1);
+    buf.addSamples(values, 1);
+    buf.addSamples(values, 1);
+    buf.addSamples(values, 1);
+    lim = buf.limits();
+    REQUIRE(lim.start == 0.);
+    REQUIRE(lim.end == 0.);
+}
+
+TEST_CASE("RingBuffer tracks gaps", "[memory, buffer]")
+{
+    RingBuffer buf(4);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    double values[4] = {1, nan, 3, 4};
+    REQUIRE_FALSE(buf.hasGaps());
+
+    buf.addSamples(values, 2);
+    REQUIRE(buf.hasGaps());
+    REQUIRE(ReadOnlyBuffer(&buf).hasGaps());
+
+    // gap is pushed out of buffer, after wrapping around
+    buf.addSamples(values + 2, 2);
+    buf.addSamples(values, 1);
+    REQUIRE(buf.hasGaps());
+    buf.addSamples(values, 1);
+    REQUIRE_FALSE(buf.hasGaps());
+    REQUIRE_FALSE(ReadOnlyBuffer(&buf).hasGaps());
+
+    // more samples than size
+    buf.addSamples(values, 4);
+    REQUIRE(buf.hasGaps());
+    buf.resize(2);
+    REQUIRE_FALSE(buf.hasGaps());
+    buf.resize(3);
+    buf.addSamples(values, 2);
+    REQUIRE(buf.hasGaps());
+    buf.clear();
+    REQUIRE_FALSE(buf.hasGaps());
+}
+
 TEST_CASE("RingBuffer clear", "[memory, buffer]")
 {
     RingBuffer buf(10);
@@ -389,3 +458,488 @@ TEST_CASE("ReadOnlyBuffer sliced constructor", "[memory, buffer]")
         REQUIRE(buf.sample(i) == (i + 5));
     }
 }
+
+TEST_CASE("LatencyHistogram buckets", "[latency]")
+{
+    // bucket lower bounds must be increasing and contain the value
+    for (qint64 ns : {0LL, 1LL, 3LL, 4LL, 5LL, 7LL, 8LL, 12LL, 1000LL, 123456789LL})
+    {
+        int i = LatencyHistogram::bucketIndex(ns);
+        REQUIRE(LatencyHistogram::bucketLowerBound(i) <= ns);
+        REQUIRE(LatencyHistogram::bucketLowerBound(i + 1) > ns);
+    }
+}
+
+TEST_CASE("LatencyHistogram percentiles", "[latency]")
+{
+    LatencyHistogram h;
+    REQUIRE(h.percentile(0.5) == 0);
+
+    // 99 fast, 1 slow
+    for (int i = 0; i < 99; i++) h.add(1000);
+    h.add(1000000);
+
+    REQUIRE(h.count() == 100);
+    REQUIRE(h.max() == 1000000);
+    REQUIRE(h.percentile(0.5) >= 1000);
+    REQUIRE(h.percentile(0.5) < 1250);
+    REQUIRE(h.percentile(0.99) < 1250);
+    REQUIRE(h.percentile(1.0) == 1000000);
+
+    h.clear();
+    REQUIRE(h.count() == 0);
+}
+
+TEST_CASE("LatencyTracer records paint of the oldest stored batch", "[latency]")
+{
+    LatencyTracer tracer;
+
+    // disabled tracer shouldn't record
+    tracer.record(LatencyTracer::ReadToDecode, 100);
+    REQUIRE(tracer.histogram(LatencyTracer::ReadToDecode).count() == 0);
+
+    tracer.setEnabled(true);
+    qint64 t = LatencyTracer::now();
+    tracer.markStored(t - 2000000, t - 1000000);
+    tracer.markStored(t, t); // newer batch, shown with the same paint
+    tracer.markPainted();
+    tracer.markPainted(); // nothing pending
+
+    auto& total = tracer.histogram(LatencyTracer::Total);
+    REQUIRE(total.count() == 1);
+    REQUIRE(total.max() >= 2000000);
+    REQUIRE(tracer.histogram(LatencyTracer::StoreToPaint).count() == 1);
+}
+
+TEST_CASE("PerfCounters rates", "[perf]")
+{
+    PerfCounters pc;
+
+    pc.addReplot(1000);
+    pc.addReplot(3000);
+    PerfCounters::inc(pc.decodeErrors, 2);
+    PerfCounters::set(pc.bufferBytesPerChannel, 800);
+
+    auto r = pc.takeRates();
+    REQUIRE(r.replotAvgNs == 2000);
+    REQUIRE(r.replotMaxNs == 3000);
+    REQUIRE(r.decodeErrors == 2);
+    REQUIRE(r.bufferBytesPerChannel == 800);
+
+    // max and averages are per period
+    r = pc.takeRates();
+    REQUIRE(r.replotAvgNs == 0);
+    REQUIRE(r.replotMaxNs == 0);
+    REQUIRE(r.decodeErrors == 2);
+}
+
+TEST_CASE("checksum check values", "[checksum]")
+{
+    const uchar* data = (const uchar*) "123456789";
+
+    REQUIRE(checksumSum8(data, 9) == 0xDD);
+    REQUIRE(checksumCrc16(data, 9) == 0x29B1);
+    REQUIRE(checksumCrc32(data, 9) == 0xCBF43926);
+}
+
+TEST_CASE("checksum calculated in parts", "[checksum]")
+{
+    uchar data[100];
+    for (int i = 0; i < 100; i++) data[i] = i * 13;
+
+    // split at a point that isn't multiple of 8
+    REQUIRE(checksumCrc16(data + 11, 89, checksumCrc16(data, 11)) == checksumCrc16(data, 100));
+    REQUIRE(checksumCrc32(data + 11, 89, checksumCrc32(data, 11)) == checksumCrc32(data, 100));
+}
+
+TEST_CASE("checksum type strings", "[checksum]")
+{
+    REQUIRE(strToChecksumType(checksumTypeToStr(Checksum_crc16)) == Checksum_crc16);
+    // older settings
+    REQUIRE(strToChecksumType("true") == Checksum_sum8);
+    REQUIRE(strToChecksumType("false") == Checksum_none);
+    REQUIRE(strToChecksumType("xyz") == Checksum_INVALID);
+}
+
+TEST_CASE("decoding sample sets with DecodePlan", "[decode]")
+{
+    // u8, pad2, i16 -> 3 channels, 5 bytes per sample set
+    DecodePlan plan;
+    plan.addField(NumberFormat_uint8, 0, 0);
+    plan.addField(NumberFormat_pad, 1, 1);
+    plan.addField(NumberFormat_int16, 3, 2);
+    plan.setSampleSetSize(5);
+    REQUIRE(plan.numFields() == 3);
+
+    const uchar data[] = {0xFF, 0x11, 0x22, 0xFE, 0xFF,
+                          0x01, 0x11, 0x22, 0x00, 0x01};
+
+    SamplePack little(2, 3);
+    plan.decode(data, 2, false, little);
+    REQUIRE(little.data(0)[0] == 255);
+    REQUIRE(little.data(0)[1] == 1);
+    REQUIRE(little.data(1)[0] == 0);
+    REQUIRE(little.data(1)[1] == 0);
+    REQUIRE(little.data(2)[0] == -2);
+    REQUIRE(little.data(2)[1] == 256);
+
+    SamplePack big(2, 3);
+    plan.decode(data, 2, true, big);
+    REQUIRE(big.data(2)[0] == -257);
+    REQUIRE(big.data(2)[1] == 1);
+
+    // into the middle of a larger pack
+    SamplePack offset(3, 4);
+    plan.decode(data + 5, 1, false, offset, 2, 1);
+    REQUIRE(offset.data(1)[2] == 1);
+    REQUIRE(offset.data(3)[2] == 256);
+}
+
+TEST_CASE("DecodePlan contiguous float field", "[decode]")
+{
+    DecodePlan plan;
+    plan.addField(NumberFormat_float, 0, 0);
+    plan.setSampleSetSize(sizeof(float));
+
+    const float values[] = {1.5f, -2.25f, 3.f, 1e6f};
+    SamplePack samples(4, 1);
+    plan.decode((const uchar*) values, 4, false, samples);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(samples.data(0)[i] == values[i]);
+    }
+}
+
+TEST_CASE("DecodePlan interleaved uniform fields", "[decode]")
+{
+    // plain binary stream layout: 3 x i16 back to back
+    DecodePlan plan;
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        plan.addField(NumberFormat_int16, ci * 2, ci);
+    }
+    plan.setSampleSetSize(6);
+
+    const uchar data[] = {0x01, 0x00, 0xFE, 0xFF, 0x00, 0x01,
+                          0x02, 0x00, 0xFD, 0xFF, 0x00, 0x02};
+
+    SamplePack little(2, 3);
+    plan.decode(data, 2, false, little);
+    REQUIRE(little.data(0)[0] == 1);
+    REQUIRE(little.data(1)[0] == -2);
+    REQUIRE(little.data(2)[0] == 256);
+    REQUIRE(little.data(0)[1] == 2);
+    REQUIRE(little.data(1)[1] == -3);
+    REQUIRE(little.data(2)[1] == 512);
+
+    SamplePack big(2, 3);
+    plan.decode(data, 2, true, big);
+    REQUIRE(big.data(0)[0] == 256);
+    REQUIRE(big.data(1)[0] == -257);
+    REQUIRE(big.data(2)[1] == 2);
+
+    // into the middle of a larger pack
+    SamplePack offset(3, 5);
+    plan.decode(data + 6, 1, false, offset, 2, 2);
+    REQUIRE(offset.data(2)[2] == 2);
+    REQUIRE(offset.data(3)[2] == -3);
+    REQUIRE(offset.data(4)[2] == 512);
+}
+
+TEST_CASE("DecodePlan 24 bit fields", "[decode]")
+{
+    DecodePlan plan;
+    plan.addField(NumberFormat_uint24, 0, 0);
+    plan.addField(NumberFormat_int24, 3, 1);
+    plan.setSampleSetSize(6);
+
+    const uchar data[] = {0x01, 0x02, 0x03, 0xFE, 0xFF, 0xFF};
+
+    SamplePack little(1, 2);
+    plan.decode(data, 1, false, little);
+    REQUIRE(little.data(0)[0] == 0x030201);
+    REQUIRE(little.data(1)[0] == -2);
+
+    SamplePack big(1, 2);
+    plan.decode(data, 1, true, big);
+    REQUIRE(big.data(0)[0] == 0x010203);
+    REQUIRE(big.data(1)[0] == -0x10001);
+}
+
+TEST_CASE("packed format sizes", "[decode]")
+{
+    REQUIRE(numberFormatBits(NumberFormat_uint12p) == 12);
+    REQUIRE(numberFormatBits(NumberFormat_uint24) == 24);
+    REQUIRE(packedGroupBytes(NumberFormat_uint12p) == 3);
+    REQUIRE(packedGroupBytes(NumberFormat_uint10p) == 5);
+
+    REQUIRE(packedSetsPerPackage(NumberFormat_uint16, 3) == 1);
+    REQUIRE(packedSetsPerPackage(NumberFormat_uint12p, 1) == 2);
+    REQUIRE(packedSetsPerPackage(NumberFormat_uint12p, 2) == 1);
+    REQUIRE(packedSetsPerPackage(NumberFormat_uint10p, 6) == 2);
+    REQUIRE(packedSetsPerPackage(NumberFormat_uint10p, 3) == 4);
+}
+
+TEST_CASE("unpacking 12 bit values", "[decode]")
+{
+    const uchar data[] = {0x21, 0x43, 0x65, 0x87, 0xA9, 0xCB};
+
+    SamplePack little(4, 1);
+    unpackToChannels(NumberFormat_uint12p, data, 2, false, little);
+    REQUIRE(little.data(0)[0] == 0x321);
+    REQUIRE(little.data(0)[1] == 0x654);
+    REQUIRE(little.data(0)[2] == 0x987);
+    REQUIRE(little.data(0)[3] == 0xCBA);
+
+    SamplePack big(4, 1);
+    unpackToChannels(NumberFormat_uint12p, data, 2, true, big);
+    REQUIRE(big.data(0)[0] == 0x214);
+    REQUIRE(big.data(0)[1] == 0x365);
+    REQUIRE(big.data(0)[3] == 0x9CB);
+
+    // values are distributed to channels in order
+    SamplePack multi(2, 2);
+    unpackToChannels(NumberFormat_uint12p, data, 2, false, multi);
+    REQUIRE(multi.data(0)[0] == 0x321);
+    REQUIRE(multi.data(1)[0] == 0x654);
+    REQUIRE(multi.data(0)[1] == 0x987);
+    REQUIRE(multi.data(1)[1] == 0xCBA);
+}
+
+TEST_CASE("unpacking 10 bit values", "[decode]")
+{
+    const uchar littleData[] = {0x01, 0x08, 0x30, 0xC0, 0xFF};
+    SamplePack little(2, 2);
+    unpackToChannels(NumberFormat_uint10p, littleData, 1, false, little);
+    REQUIRE(little.data(0)[0] == 1);
+    REQUIRE(little.data(1)[0] == 2);
+    REQUIRE(little.data(0)[1] == 3);
+    REQUIRE(little.data(1)[1] == 1023);
+
+    const uchar bigData[] = {0x00, 0x40, 0x20, 0x0F, 0xFF};
+    SamplePack big(4, 1);
+    unpackToChannels(NumberFormat_uint10p, bigData, 1, true, big);
+    REQUIRE(big.data(0)[0] == 1);
+    REQUIRE(big.data(0)[1] == 2);
+    REQUIRE(big.data(0)[2] == 3);
+    REQUIRE(big.data(0)[3] == 1023);
+}
+
+TEST_CASE("SpscQueue push and pop", "[merge]")
+{
+    SpscQueue<int> queue(3);
+    REQUIRE(queue.capacity() == 4);
+
+    int value;
+    REQUIRE_FALSE(queue.pop(value));
+
+    for (int i = 0; i < 4; i++) REQUIRE(queue.push(i));
+    REQUIRE_FALSE(queue.push(4));
+    REQUIRE(queue.size() == 4);
+
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 0);
+
+    // wraps around
+    REQUIRE(queue.push(4));
+    for (int i = 1; i <= 4; i++)
+    {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.pop(value));
+}
+
+TEST_CASE("SpscQueue between threads", "[merge]")
+{
+    const int N = 100000;
+    SpscQueue<int> queue(64);
+
+    std::thread producer([&queue]()
+                         {
+                             for (int i = 0; i < N; i++)
+                             {
+                                 while (!queue.push(i)) std::this_thread::yield();
+                             }
+                         });
+
+    bool inOrder = true;
+    for (int i = 0; i < N; i++)
+    {
+        int value;
+        while (!queue.pop(value)) std::this_thread::yield();
+        if (value != i) inOrder = false;
+    }
+    producer.join();
+
+    REQUIRE(inOrder);
+    REQUIRE(queue.size() == 0);
+}
+
+/// Creates a pack of single channel samples with times in X
+static SamplePack timedPack(std::initializer_list<double> times,
+                            std::initializer_list<double> values)
+{
+    SamplePack pack(times.size(), 1, true);
+    std::copy(times.begin(), times.end(), pack.xData());
+    std::copy(values.begin(), values.end(), pack.data(0));
+    return pack;
+}
+
+TEST_CASE("aligning samples of two ports", "[merge]")
+{
+    SampleAligner aligner;
+    aligner.setPorts({1, 1});
+    REQUIRE(aligner.numChannels() == 2);
+
+    aligner.push(0, timedPack({1, 2, 3, 4}, {10, 20, 30, 40}));
+    // second port hasn't sent anything yet
+    REQUIRE(aligner.take() == nullptr);
+
+    aligner.push(1, timedPack({1.5, 3.5}, {100, 200}));
+    SamplePack* samples = aligner.take();
+    REQUIRE(samples != nullptr);
+
+    // rows up to the latest time of second port
+    REQUIRE(samples->numSamples() == 3);
+    REQUIRE(samples->data(0)[0] == 10);
+    REQUIRE(samples->data(0)[2] == 30);
+    REQUIRE(std::isnan(samples->data(1)[0]));
+    REQUIRE(samples->data(1)[1] == 100);
+    REQUIRE(samples->data(1)[2] == 100);
+    REQUIRE(samples->timestamp() == 1);
+    delete samples;
+
+    REQUIRE(aligner.take() == nullptr);
+
+    // held value is used when there isn't a newer sample
+    aligner.push(1, timedPack({5}, {300}));
+    samples = aligner.take();
+    REQUIRE(samples != nullptr);
+    REQUIRE(samples->numSamples() == 1);
+    REQUIRE(samples->data(0)[0] == 40);
+    REQUIRE(samples->data(1)[0] == 200);
+    delete samples;
+}
+
+TEST_CASE("aligner releases samples of a silent port", "[merge]")
+{
+    SampleAligner aligner;
+    aligner.setPorts({1, 1});
+
+    aligner.push(0, timedPack({1, 2, 3}, {10, 20, 30}));
+    REQUIRE(aligner.take() == nullptr);
+
+    SamplePack* samples = aligner.take(2);
+    REQUIRE(samples != nullptr);
+    REQUIRE(samples->numSamples() == 2);
+    REQUIRE(std::isnan(samples->data(1)[1]));
+    delete samples;
+
+    aligner.setMaxPending(2);
+    aligner.push(0, timedPack({4, 5, 6}, {40, 50, 60}));
+    samples = aligner.take(10);
+    REQUIRE(samples != nullptr);
+    REQUIRE(samples->numSamples() == 2);
+    REQUIRE(samples->data(0)[0] == 50);
+    delete samples;
+    REQUIRE(aligner.dropped() == 1);
+
+    aligner.clear();
+    REQUIRE(aligner.dropped() == 0);
+}
+
+TEST_CASE("aligner leaves out a port that stopped sending", "[merge]")
+{
+    SampleAligner aligner;
+    aligner.setPorts({1, 1});
+
+    // device times, unrelated to arrival times
+    auto pack = timedPack({1, 2, 3}, {10, 20, 30});
+    pack.setTimestamp(1000);
+    aligner.push(0, pack);
+    pack = timedPack({1}, {100});
+    pack.setTimestamp(500);
+    aligner.push(1, pack);
+
+    // second port holds back the watermark until it's stale
+    SamplePack* samples = aligner.take(-std::numeric_limits<double>::infinity(), 400);
+    REQUIRE(samples != nullptr);
+    REQUIRE(samples->numSamples() == 1);
+    delete samples;
+    REQUIRE(aligner.take(-std::numeric_limits<double>::infinity(), 500) == nullptr);
+
+    samples = aligner.take(-std::numeric_limits<double>::infinity(), 600);
+    REQUIRE(samples != nullptr);
+    REQUIRE(samples->numSamples() == 2);
+    REQUIRE(samples->data(0)[1] == 30);
+    REQUIRE(samples->data(1)[1] == 100);
+    delete samples;
+}
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TEST_CASE("shared memory export", "[export]")
+{
+    ChannelInfoModel info(2);
+    info.setData(info.index(1, ChannelInfoModel::COLUMN_NAME), "volts");
+    ShmExport shm(&info);
+    TestSource so(2, false);
+
+    REQUIRE(shm.start("/serialplot_test", 4));
+    so.connectSink(&shm);
+
+    // map it the way an external reader would
+    int fd = shm_open("/serialplot_test", O_RDONLY, 0);
+    REQUIRE(fd >= 0);
+    struct stat st;
+    REQUIRE(fstat(fd, &st) == 0);
+    void* mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    REQUIRE(mem != MAP_FAILED);
+
+    auto header = static_cast<const ShmHeader*>(mem);
+    REQUIRE(memcmp(header->magic, "SPLOTSHM", 8) == 0);
+    REQUIRE(header->version == SHM_EXPORT_VERSION);
+    REQUIRE(header->numChannels == 2);
+    REQUIRE(header->capacity == 4);
+    REQUIRE(header->layoutSeq % 2 == 0);
+
+    auto table = reinterpret_cast<const ShmChannel*>(
+        static_cast<const char*>(mem) + header->channelTableOffset);
+    REQUIRE(QString(table[1].name) == "volts");
+    REQUIRE(table[1].gain == 1);
+
+    auto ring = reinterpret_cast<const double*>(
+        static_cast<const char*>(mem) + header->dataOffset);
+
+    SamplePack pack(3, 2, false);
+    for (unsigned i = 0; i < 3; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = 10 + i;
+    }
+    so._feed(pack);
+    REQUIRE(header->writeIndex == 3);
+    REQUIRE(header->writeEnd == 3);
+    REQUIRE(ring[2] == 2);
+    REQUIRE(ring[4 + 1] == 11);
+
+    // wraps around
+    so._feed(pack);
+    REQUIRE(header->writeIndex == 6);
+    REQUIRE(ring[3] == 0);
+    REQUIRE(ring[0] == 1);
+    REQUIRE(ring[1] == 2);
+    REQUIRE(ring[4 + 1] == 12);
+
+    munmap(mem, st.st_size);
+    shm.stop();
+    REQUIRE(shm_open("/serialplot_test", O_RDONLY, 0) < 0);
+}
+#endif
@@ -1,6 +1,10 @@
 #ifndef TEST_HELPERS_H
 #define TEST_HELPERS_H
 
+#include <QSettings>
+#include <QVector>
+#include <QTemporaryDir>
+
 #include "source.h"
 #include "sink.h"
 
@@ -10,6 +14,8 @@ public:
     int totalFed;
     int _numChannels;
     bool _hasX;
+    /// All fed samples of each channel
+    QVector<QVector<double>> values;
 
     TestSink()
         {
@@ -23,6 +29,11 @@ public:
             REQUIRE(data.numChannels() == numChannels());
 
             totalFed += data.numSamples();
+            for (unsigned ci = 0; ci < data.numChannels(); ci++)
+            {
+                const double* d = data.data(ci);
+                values[ci].append(QVector<double>(d, d + data.numSamples()));
+            }
 
             Sink::feedIn(data);
         };
@@ -31,6 +42,7 @@ public:
         {
             _numChannels = nc;
             _hasX = x;
+            values.resize(nc);
 
             Sink::setNumChannels(nc, x);
         };
@@ -82,5 +94,26 @@ public:
         };
 };
 
+/// Holds the directory of `TestSettings`, as a base class so that it
+/// is created before and removed after the settings file.
+struct TestSettingsDir
+{
+    QTemporaryDir tempDir;
+};
+
+/**
+ * INI settings in a temporary directory, used for loading reader
+ * options that have no setter. File is removed even if the test
+ * fails before reaching its end.
+ */
+class TestSettings : private TestSettingsDir, public QSettings
+{
+public:
+    TestSettings() :
+        QSettings(tempDir.filePath("test.ini"), QSettings::IniFormat)
+        {
+            REQUIRE(tempDir.isValid());
+        };
+};
 
 #endif // TEST_HELPERS_H
@@ -20,13 +20,34 @@
 // This tells Catch to provide a main() - only do this in one cpp file per executable
 #define CATCH_CONFIG_RUNNER
 #include "catch.hpp"
+#include <cmath>
 
 #include <QSignalSpy>
+#include <QTest>
 #include <QBuffer>
+#include <QFile>
+#include <QSettings>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <QLocalSocket>
 #include "binarystreamreader.h"
 #include "asciireader.h"
 #include "framedreader.h"
+#include "complexframedreader.h"
+#include "delimitedreader.h"
+#include "framelayout.h"
+#include "multimessagereader.h"
 #include "demoreader.h"
+#include "rawcapture.h"
+#include "capturereplaydevice.h"
+#include "filereplayreader.h"
+#include "nativeserialport.h"
+#include "udpdevice.h"
+#include "localsocketexport.h"
+#include "channelinfomodel.h"
+#include "perfcounters.h"
+#include "setting_defines.h"
 
 #include "test_helpers.h"
 
@@ -76,6 +97,78 @@ TEST_CASE("disabled BinaryStreamReader shouldn't read", "[reader]")
     REQUIRE(sink.totalFed == 0);
 }
 
+TEST_CASE("reading packed data with BinaryStreamReader", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_Binary);
+    settings.setValue(SG_Binary_NumOfChannels, 3);
+    settings.setValue(SG_Binary_NumberFormat, "uint12p");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    BinaryStreamReader bs(&bufferDev);
+    bs.loadSettings(&settings);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+    REQUIRE(sink._numChannels == 3);
+
+    // 2 sample sets fill 3 groups (9 bytes), trailing bytes are left
+    bufferDev.open(QIODevice::ReadWrite);
+    const char data[13] = {};
+    bufferDev.write(data, sizeof(data));
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(bufferDev.bytesAvailable() == 4);
+}
+
+TEST_CASE("batched reading waits for min bytes or max delay", "[reader]")
+{
+    QBuffer bufferDev;
+    BinaryStreamReader bs(&bufferDev);
+    AbstractReader::BatchPolicy policy;
+    policy.mode = AbstractReader::BatchMode::Fixed;
+    policy.minBytes = 8;
+    policy.maxDelay = 60000;    // never expires during test, flushed instead
+    bs.setBatchPolicy(policy);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const char data[8] = {};
+    bufferDev.write(data, 4);
+    bufferDev.seek(0);
+
+    // not enough bytes, read is delayed
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 0);
+    REQUIRE(bs.batchPending());
+
+    // same path as max delay expiring
+    bs.flushBatch();
+    REQUIRE_FALSE(bs.batchPending());
+    REQUIRE(sink.totalFed == 4);
+
+    auto stats = bs.takeBatchStats();
+    REQUIRE(stats.batches == 1);
+    REQUIRE(stats.avgBytes == 4);
+    REQUIRE(stats.avgDelay >= 0);
+
+    // enough bytes, read immediately
+    bufferDev.write(data, 8);
+    bufferDev.seek(4);
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 12);
+    REQUIRE(bs.takeBatchStats().batches == 1);
+}
+
 TEST_CASE("reading data with AsciiReader", "[reader, ascii]")
 {
     QBuffer bufferDev;
@@ -166,6 +259,611 @@ TEST_CASE("FramedReader shouldn't read when disabled", "[reader]")
     REQUIRE(sink.totalFed == 0);
 }
 
+TEST_CASE("FramedReader counts frame errors and losses", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_CustomFrame);
+    settings.setValue(SG_CustomFrame_Checksum, true);
+    settings.setValue(SG_CustomFrame_Sequence, true);
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    FramedReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const uint8_t data[] = {
+        0x11, 0xAA, 0x22,                         // garbage, 3 bytes skipped
+        0xAA, 0xBB, 2, 0, 0x01, 0x02, 0x03,       // seq 0, OK
+        0xAA, 0xBB, 2, 1, 0x01, 0x02, 0x00,       // seq 1, bad checksum
+        0xAA, 0xBB, 1, 3, 0x05, 0x08,             // seq 3, OK, 2 lost
+        0xAA, 0xBB, 0};                           // invalid size
+    bufferDev.write((const char*) data, sizeof(data));
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    // 2 lost frames are fed as a gap of the same size as the next frame
+    REQUIRE(sink.totalFed == 5);
+
+    const FrameStats& stats = reader.frameStats();
+    REQUIRE(stats.framesOk == 2);
+    REQUIRE(stats.checksumFailures == 1);
+    REQUIRE(stats.sizeErrors == 1);
+    REQUIRE(stats.syncMisses == 1);
+    REQUIRE(stats.bytesSkipped == 3);
+    REQUIRE(stats.framesLost == 2);
+}
+
+TEST_CASE("FramedReader validates CRC-16", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_CustomFrame);
+    settings.setValue(SG_CustomFrame_Checksum, "crc16");
+    settings.setValue(SG_CustomFrame_Endianness, "little");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    FramedReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const uint8_t data[] = {
+        0xAA, 0xBB, 2, 0x01, 0x02, 0x7C, 0x0E,    // OK
+        0xAA, 0xBB, 2, 0x01, 0x03, 0x7C, 0x0E};   // corrupted payload
+    bufferDev.write((const char*) data, sizeof(data));
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(reader.frameStats().framesOk == 1);
+    REQUIRE(reader.frameStats().checksumFailures == 1);
+}
+
+/// Reads `data` with a `ComplexFramedReader` configured by `settings`
+/// (in `SettingGroup_ComplexFrame`), frame start is "AA BB"
+static void readComplexFrames(QSettings& settings, const QByteArray& data,
+                              ComplexFramedReader& reader, TestSink& sink)
+{
+    reader.loadSettings(&settings);
+    reader.enable(true);
+    reader.connectSink(&sink);
+
+    auto buffer = static_cast<QBuffer*>(reader.device());
+    buffer->open(QIODevice::ReadWrite);
+    buffer->write(data);
+    buffer->seek(0);
+
+    QSignalSpy spy(buffer, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+}
+
+TEST_CASE("ComplexFramedReader decodes mixed formats with padding", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_ComplexFrame);
+    settings.setValue(SG_ComplexFrame_NumOfChannels, 3);
+    settings.setValue("ChannelFormat_0", "uint16");
+    settings.setValue("ChannelFormat_1", "pad");
+    settings.setValue("ChannelPadSize_1", 1);
+    settings.setValue("ChannelFormat_2", "int8");
+    settings.setValue(SG_ComplexFrame_Endianness, "little");
+    settings.setValue(SG_ComplexFrame_SizeFieldType, "field1byte");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    ComplexFramedReader reader(&bufferDev);
+    TestSink sink;
+    const uint8_t data[] = {
+        0xAA, 0xBB, 8,
+        0x34, 0x12, 0xFF, 0xFE,
+        0x01, 0x00, 0x00, 0x05};
+    readComplexFrames(settings, QByteArray((const char*) data, sizeof(data)), reader, sink);
+
+    REQUIRE(sink._numChannels == 3);
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(sink.values[0] == QVector<double>({0x1234, 1}));
+    REQUIRE(sink.values[1] == QVector<double>({0, 0}));
+    REQUIRE(sink.values[2] == QVector<double>({-2, 5}));
+}
+
+TEST_CASE("ComplexFramedReader decodes a uniform layout", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_ComplexFrame);
+    settings.setValue(SG_ComplexFrame_NumOfChannels, 2);
+    settings.setValue("ChannelFormat_0", "int16");
+    settings.setValue("ChannelFormat_1", "int16");
+    settings.setValue(SG_ComplexFrame_Endianness, "big");
+    settings.setValue(SG_ComplexFrame_SizeFieldType, "field1byte");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    ComplexFramedReader reader(&bufferDev);
+    TestSink sink;
+    const uint8_t data[] = {
+        0xAA, 0xBB, 8,
+        0x00, 0x01, 0xFF, 0xFF,
+        0x01, 0x00, 0x80, 0x00};
+    readComplexFrames(settings, QByteArray((const char*) data, sizeof(data)), reader, sink);
+
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(sink.values[0] == QVector<double>({1, 256}));
+    REQUIRE(sink.values[1] == QVector<double>({-1, -32768}));
+}
+
+TEST_CASE("ComplexFramedReader validates CRC-16", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_ComplexFrame);
+    settings.setValue(SG_ComplexFrame_NumOfChannels, 1);
+    settings.setValue("ChannelFormat_0", "uint8");
+    settings.setValue(SG_ComplexFrame_Checksum, "crc16");
+    settings.setValue(SG_ComplexFrame_Endianness, "little");
+    settings.setValue(SG_ComplexFrame_SizeFieldType, "field1byte");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    ComplexFramedReader reader(&bufferDev);
+    TestSink sink;
+    const uint8_t data[] = {
+        0xAA, 0xBB, 2, 0x01, 0x02, 0x7C, 0x0E,    // OK
+        0xAA, 0xBB, 2, 0x01, 0x03, 0x7C, 0x0E};   // corrupted payload
+    readComplexFrames(settings, QByteArray((const char*) data, sizeof(data)), reader, sink);
+
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(sink.values[0] == QVector<double>({1, 2}));
+    REQUIRE(reader.frameStats().framesOk == 1);
+    REQUIRE(reader.frameStats().checksumFailures == 1);
+}
+
+TEST_CASE("ComplexFramedReader decodes packed 12 bit frames", "[reader]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_ComplexFrame);
+    settings.setValue(SG_ComplexFrame_NumOfChannels, 2);
+    settings.setValue("ChannelFormat_0", "uint12p");
+    settings.setValue("ChannelFormat_1", "uint12p");
+    settings.setValue(SG_ComplexFrame_Endianness, "little");
+    settings.setValue(SG_ComplexFrame_SizeFieldType, "field1byte");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    ComplexFramedReader reader(&bufferDev);
+    TestSink sink;
+    const uint8_t data[] = {
+        0xAA, 0xBB, 6,
+        0x23, 0xC1, 0xAB,                         // 0x123, 0xABC
+        0x01, 0xF0, 0xFF};                        // 0x001, 0xFFF
+    readComplexFrames(settings, QByteArray((const char*) data, sizeof(data)), reader, sink);
+
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(sink.values[0] == QVector<double>({0x123, 0x001}));
+    REQUIRE(sink.values[1] == QVector<double>({0xABC, 0xFFF}));
+}
+
+TEST_CASE("parsing a frame layout", "[reader, delimited]")
+{
+    FrameLayout layout;
+    REQUIRE(layout.parse("u16, 2*f32, pad2, int8"));
+    REQUIRE(layout.numChannels() == 4);
+    REQUIRE(layout.size() == 13);
+    REQUIRE(layout.fields()[1].offset == 2);
+    REQUIRE(layout.fields()[2].offset == 6);
+    REQUIRE(layout.fields()[3].offset == 12);
+    REQUIRE(layout.fields()[3].format == NumberFormat_int8);
+
+    // invalid text doesn't change the layout
+    QString error;
+    REQUIRE_FALSE(layout.parse("u16,foo", &error));
+    REQUIRE_FALSE(error.isEmpty());
+    REQUIRE(layout.numChannels() == 4);
+    REQUIRE_FALSE(layout.parse("pad4"));
+    REQUIRE_FALSE(layout.parse("0*u8"));
+}
+
+TEST_CASE("decoding COBS and SLIP frames", "[reader, delimited]")
+{
+    uchar cobs[] = {0x02, 0x05, 0x02, 0x01};
+    REQUIRE(DelimitedReader::decodeCobs(cobs, sizeof(cobs)) == 3);
+    REQUIRE(cobs[0] == 0x05);
+    REQUIRE(cobs[1] == 0x00);
+    REQUIRE(cobs[2] == 0x01);
+
+    uchar cobsBad[] = {0x05, 0x01};
+    REQUIRE(DelimitedReader::decodeCobs(cobsBad, sizeof(cobsBad)) == -1);
+
+    uchar slip[] = {0xDB, 0xDC, 0x01, 0xDB, 0xDD};
+    REQUIRE(DelimitedReader::decodeSlip(slip, sizeof(slip)) == 3);
+    REQUIRE(slip[0] == 0xC0);
+    REQUIRE(slip[1] == 0x01);
+    REQUIRE(slip[2] == 0xDB);
+
+    uchar slipBad[] = {0xDB, 0x01};
+    REQUIRE(DelimitedReader::decodeSlip(slipBad, sizeof(slipBad)) == -1);
+    uchar slipTrailing[] = {0x01, 0xDB};
+    REQUIRE(DelimitedReader::decodeSlip(slipTrailing, sizeof(slipTrailing)) == -1);
+}
+
+TEST_CASE("reading data with DelimitedReader", "[reader, delimited]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_Delimited);
+    settings.setValue(SG_Delimited_Encoding, "cobs");
+    settings.setValue(SG_Delimited_Layout, "u8,i16");
+    settings.setValue(SG_Delimited_Endianness, "little");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    DelimitedReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+    REQUIRE(sink._numChannels == 2);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const uint8_t data[] = {
+        0x00,                                     // start of the first frame
+        0x02, 0x05, 0x02, 0x01, 0x00,             // 5, 256
+        0x04, 0x07, 0xFF, 0xFF, 0x00,             // 7, -1
+        0x05, 0x01, 0x00,                         // malformed
+        0x02, 0x01};                              // incomplete
+    bufferDev.write((const char*) data, sizeof(data));
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 2);
+    REQUIRE(reader.frameStats().framesOk == 2);
+    REQUIRE(reader.frameStats().sizeErrors == 1);
+}
+
+TEST_CASE("parsing message type definitions", "[reader, multimessage]")
+{
+    QVector<MessageType> types;
+    REQUIRE(MultiMessageReaderSettings::parseMessageTypes(
+                "# comment\n01: u16,u16\n\n0x1F: 4*f32\n", &types));
+    REQUIRE(types.size() == 2);
+    REQUIRE(types[0].id == 0x01);
+    REQUIRE(types[0].layout.numChannels() == 2);
+    REQUIRE(types[1].id == 0x1F);
+    REQUIRE(types[1].layout.numChannels() == 4);
+
+    QString error;
+    REQUIRE_FALSE(MultiMessageReaderSettings::parseMessageTypes("01: u8\n01: u16", &types, &error));
+    REQUIRE_FALSE(error.isEmpty());
+    REQUIRE_FALSE(MultiMessageReaderSettings::parseMessageTypes("100: u8", &types));
+    REQUIRE_FALSE(MultiMessageReaderSettings::parseMessageTypes("01 u8", &types));
+    REQUIRE_FALSE(MultiMessageReaderSettings::parseMessageTypes("", &types));
+    REQUIRE(types.size() == 2);
+}
+
+TEST_CASE("reading data with MultiMessageReader", "[reader, multimessage]")
+{
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_MultiMessage);
+    settings.setValue(SG_MultiMessage_FrameStart, "AA BB");
+    settings.setValue(SG_MultiMessage_Messages, "01: u8\n02: u16,u16");
+    settings.setValue(SG_MultiMessage_Endianness, "little");
+    settings.setValue(SG_MultiMessage_Checksum, "none");
+    settings.endGroup();
+
+    QBuffer bufferDev;
+    MultiMessageReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+    REQUIRE(sink._numChannels == 3);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const uint8_t data[] = {
+        0xAA, 0xBB, 0x01, 0x05,                   // message 1
+        0xAA, 0xBB, 0x02, 0x01, 0x00, 0x02, 0x00, // message 2
+        0x11,                                     // garbage
+        0xAA, 0xBB, 0x07,                         // unknown ID, 4 bytes skipped in total
+        0xAA, 0xBB, 0x01, 0x09,                   // message 1
+        0xAA, 0xBB, 0x02, 0x01};                  // incomplete
+    bufferDev.write((const char*) data, sizeof(data));
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 3);
+
+    // a sample set per message, channels of other messages hold
+    // their last value and are NaN until their first message
+    REQUIRE(sink.values[0] == QVector<double>({5, 5, 9}));
+    REQUIRE(std::isnan(sink.values[1][0]));
+    REQUIRE(std::isnan(sink.values[2][0]));
+    REQUIRE(sink.values[1].mid(1) == QVector<double>({1, 1}));
+    REQUIRE(sink.values[2].mid(1) == QVector<double>({2, 2}));
+
+    const FrameStats& stats = reader.frameStats();
+    REQUIRE(stats.framesOk == 3);
+    REQUIRE(stats.syncMisses == 1);
+    REQUIRE(stats.bytesSkipped == 4);
+}
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+TEST_CASE("reading a pseudo terminal with NativeSerialPort", "[reader, native]")
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    REQUIRE(master >= 0);
+    REQUIRE(grantpt(master) == 0);
+    REQUIRE(unlockpt(master) == 0);
+
+    PerfCounters counters;
+    NativeSerialPort port;
+    port.setPortName(ptsname(master));
+    port.setPerfCounters(&counters);
+    REQUIRE(port.open(QIODevice::ReadWrite));
+
+    BinaryStreamReader bs(&port);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    const char data[] = {0x01, 0x02, 0x03, 0x04};
+    REQUIRE(write(master, data, sizeof(data)) == sizeof(data));
+
+    QSignalSpy spy(&port, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(1000));
+    REQUIRE(sink.totalFed == 4);
+    REQUIRE(counters.portBytes == 4);
+    REQUIRE(counters.portReads >= 1);
+
+    // writes go to the other end
+    REQUIRE(port.write("ok", 2) == 2);
+    char received[2];
+    REQUIRE(read(master, received, 2) == 2);
+    REQUIRE(received[0] == 'o');
+
+    port.close();
+    REQUIRE_FALSE(port.isOpen());
+    close(master);
+}
+
+TEST_CASE("NativeSerialPort keeps reading when its buffer is full", "[reader, native]")
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    REQUIRE(master >= 0);
+    REQUIRE(grantpt(master) == 0);
+    REQUIRE(unlockpt(master) == 0);
+
+    // every read returns a full chunk, port never drains before
+    // buffer is full
+    NativeSerialPort port;
+    port.setPortName(ptsname(master));
+    port.setReadSize(16);
+    port.setBufferSize(64);
+    REQUIRE(port.open(QIODevice::ReadWrite));
+
+    BinaryStreamReader bs(&port);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    QByteArray data(2048, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); i++) data[i] = char(i % 100);
+    REQUIRE(write(master, data.constData(), data.size()) == data.size());
+
+    REQUIRE(QTest::qWaitFor([&]{return sink.totalFed == data.size();}, 2000));
+    REQUIRE(sink.values[0][0] == 0);
+    REQUIRE(sink.values[0][data.size() - 1] == (data.size() - 1) % 100);
+
+    port.close();
+    close(master);
+}
+#endif
+
+TEST_CASE("reading UDP datagrams with UdpDevice", "[reader, network]")
+{
+    PerfCounters counters;
+    UdpDevice udp;
+    udp.setLocalAddress(QHostAddress::LocalHost);
+    udp.setLocalPort(0);
+    udp.setPerfCounters(&counters);
+    REQUIRE(udp.open(QIODevice::ReadWrite));
+    REQUIRE(udp.localPort() != 0);
+
+    BinaryStreamReader bs(&udp);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    QUdpSocket sender;
+    const char data[] = {0x01, 0x02, 0x03, 0x04};
+    for (int i = 0; i < 3; i++)
+    {
+        REQUIRE(sender.writeDatagram(data, sizeof(data),
+                                     QHostAddress::LocalHost, udp.localPort()) == 4);
+    }
+
+    // datagrams may arrive in one or more batches
+    QSignalSpy spy(&udp, SIGNAL(readyRead()));
+    while (sink.totalFed < 12 && spy.wait(1000));
+    REQUIRE(sink.totalFed == 12);
+    REQUIRE(sink.values[0] == QVector<double>({1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4}));
+    REQUIRE(counters.portReads == 3);
+    REQUIRE(counters.portBytes == 12);
+
+    // replies go to the sender
+    REQUIRE(udp.write("ok", 2) == 2);
+    REQUIRE(sender.waitForReadyRead(1000));
+    char received[2];
+    REQUIRE(sender.readDatagram(received, 2) == 2);
+    REQUIRE(received[0] == 'o');
+
+    udp.close();
+    REQUIRE_FALSE(udp.isOpen());
+}
+
+TEST_CASE("reading a TCP stream", "[reader, network]")
+{
+    QTcpServer server;
+    REQUIRE(server.listen(QHostAddress::LocalHost));
+
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    REQUIRE(socket.waitForConnected(1000));
+    REQUIRE(server.waitForNewConnection(1000));
+    QTcpSocket* client = server.nextPendingConnection();
+
+    BinaryStreamReader bs(&socket);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    const char data[] = {0x01, 0x02, 0x03, 0x04};
+    client->write(data, sizeof(data));
+    client->flush();
+
+    QSignalSpy spy(&socket, SIGNAL(readyRead()));
+    while (sink.totalFed < 4 && spy.wait(1000));
+    REQUIRE(sink.totalFed == 4);
+    REQUIRE(sink.values[0] == QVector<double>({1, 2, 3, 4}));
+
+    // remote close is reported as an error, see `PortControl::onNetworkError`
+    qRegisterMetaType<QAbstractSocket::SocketError>();
+    QSignalSpy errorSpy(&socket, &QAbstractSocket::errorOccurred);
+    client->disconnectFromHost();
+    REQUIRE((errorSpy.count() || errorSpy.wait(1000)));
+    REQUIRE(socket.error() == QAbstractSocket::RemoteHostClosedError);
+}
+
+TEST_CASE("failing to open network sources", "[reader, network]")
+{
+    // a port that is known to be free, nobody listens on it
+    QTcpServer server;
+    REQUIRE(server.listen(QHostAddress::LocalHost));
+    quint16 port = server.serverPort();
+    server.close();
+
+    qRegisterMetaType<QAbstractSocket::SocketError>();
+    QTcpSocket socket;
+    QSignalSpy tcpErrorSpy(&socket, &QAbstractSocket::errorOccurred);
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    // error is emitted before `waitForConnected` returns
+    REQUIRE_FALSE(socket.waitForConnected(1000));
+    REQUIRE(tcpErrorSpy.count() == 1);
+    REQUIRE(socket.error() == QAbstractSocket::ConnectionRefusedError);
+    REQUIRE_FALSE(socket.isOpen());
+
+    // port is already taken
+    QUdpSocket taken;
+    REQUIRE(taken.bind(QHostAddress::LocalHost, 0));
+
+    UdpDevice udp;
+    udp.setLocalAddress(QHostAddress::LocalHost);
+    udp.setLocalPort(taken.localPort());
+    QSignalSpy udpErrorSpy(&udp, &UdpDevice::errorOccurred);
+    REQUIRE_FALSE(udp.open(QIODevice::ReadWrite));
+    REQUIRE(udpErrorSpy.count() == 1);
+    REQUIRE_FALSE(udp.isOpen());
+    REQUIRE_FALSE(udp.errorString().isEmpty());
+}
+
+/// Reads a local export message, returns payload without the type
+static QByteArray readExportMessage(QLocalSocket& socket, quint32* type)
+{
+    quint32 size;
+    while (socket.bytesAvailable() < qint64(sizeof(size)))
+    {
+        if (!socket.waitForReadyRead(1000)) return QByteArray();
+    }
+    socket.peek(reinterpret_cast<char*>(&size), sizeof(size));
+    while (socket.bytesAvailable() < qint64(sizeof(size) + size))
+    {
+        if (!socket.waitForReadyRead(1000)) return QByteArray();
+    }
+    socket.skip(sizeof(size));
+    socket.read(reinterpret_cast<char*>(type), sizeof(*type));
+    return socket.read(size - sizeof(*type));
+}
+
+TEST_CASE("streaming samples over a local socket", "[export, network]")
+{
+    ChannelInfoModel info(2);
+    info.setData(info.index(0, ChannelInfoModel::COLUMN_NAME), "volts");
+    LocalSocketExport exporter(&info);
+    REQUIRE(exporter.start("serialplot_test"));
+
+    TestSource so(2, false);
+    so.connectSink(&exporter);
+
+    QLocalSocket client;
+    client.connectToServer(exporter.fullServerName());
+    REQUIRE(client.waitForConnected(1000));
+    REQUIRE(QTest::qWaitFor([&]{return exporter.numClients() == 1;}, 1000));
+
+    quint32 type = 0;
+    QByteArray payload = readExportMessage(client, &type);
+    REQUIRE(type == LocalExport_Channels);
+    REQUIRE(*reinterpret_cast<const quint32*>(payload.constData()) == 2);
+    REQUIRE(payload.mid(8, 5) == "volts");
+
+    SamplePack pack(3, 2, false);
+    for (unsigned i = 0; i < 3; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = 10 + i;
+    }
+    so._feed(pack);
+
+    payload = readExportMessage(client, &type);
+    REQUIRE(type == LocalExport_Samples);
+    REQUIRE(payload.size() == 24 + 6 * sizeof(double));
+    const char* p = payload.constData();
+    REQUIRE(*reinterpret_cast<const quint64*>(p) == 0);
+    REQUIRE(*reinterpret_cast<const quint32*>(p + 16) == 2);
+    REQUIRE(*reinterpret_cast<const quint32*>(p + 20) == 3);
+    auto samples = reinterpret_cast<const double*>(p + 24);
+    REQUIRE(samples[2] == 2);
+    REQUIRE(samples[3] == 10);
+
+    // client doesn't read while samples are fed, old ones are dropped
+    exporter.setMaxQueueSize(200 * 1024);
+    SamplePack bigPack(10000, 2, false);
+    for (int i = 0; i < 10; i++) so._feed(bigPack);
+    REQUIRE(exporter.droppedMessages() > 0);
+
+    quint64 lastSeq = 0;
+    while (lastSeq < 3 + 9 * 10000)
+    {
+        payload = readExportMessage(client, &type);
+        REQUIRE(type == LocalExport_Samples);
+        quint64 seq = *reinterpret_cast<const quint64*>(payload.constData());
+        REQUIRE(seq > lastSeq);
+        REQUIRE((seq - 3) % 10000 == 0);
+        lastSeq = seq;
+    }
+
+    client.disconnectFromServer();
+    REQUIRE(QTest::qWaitFor([&]{return exporter.numClients() == 0;}, 1000));
+    exporter.stop();
+}
+
 TEST_CASE("Generating data with DemoReader", "[reader, demo]")
 {
     QBuffer bufferDev;          // not actually used
@@ -198,6 +896,84 @@ TEST_CASE("DemoReader shouldn't generate data when paused", "[reader, demo]")
     REQUIRE(sink.totalFed == 0);
 }
 
+TEST_CASE("capturing raw bytes and replaying them", "[reader, capture]")
+{
+    const char* fileName = "test_capture.spraw";
+
+    RawCapture capture;
+    REQUIRE(capture.start(fileName));
+
+    QBuffer bufferDev;
+    BinaryStreamReader bs(&bufferDev);
+    bs.setRawCapture(&capture);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const char data[] = {0x01, 0x02, 0x03, 0x04};
+    bufferDev.write(data, 4);
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    capture.stop();
+    REQUIRE(capture.bytesCaptured() == 4);
+    REQUIRE(QFile(fileName).size() ==
+            RawCapture::HeaderSize + RawCapture::ChunkHeaderSize + 4);
+
+    // replay through another reader
+    CaptureReplayDevice replay;
+    REQUIRE(replay.openCapture(fileName));
+    replay.setSpeed(0);
+
+    BinaryStreamReader bs2(&replay);
+    bs2.enable(true);
+    TestSink sink2;
+    bs2.connectSink(&sink2);
+
+    QSignalSpy finishedSpy(&replay, SIGNAL(finished()));
+    replay.start();
+    REQUIRE(finishedSpy.wait(1000));
+    REQUIRE(replay.bytesReplayed() == 4);
+    REQUIRE(sink2.totalFed == 4);
+
+    QFile::remove(fileName);
+}
+
+TEST_CASE("replaying a CSV recording with FileReplayReader", "[reader, replay]")
+{
+    const char* fileName = "test_replay.csv";
+    QFile csv(fileName);
+    REQUIRE(csv.open(QIODevice::WriteOnly));
+    csv.write("Channel 1,Channel 2\n1,2\n3,\n5,6\n");
+    csv.close();
+
+    TestSettings settings;
+    settings.beginGroup(SettingGroup_FileReplay);
+    settings.setValue(SG_FileReplay_FileName, fileName);
+    settings.setValue(SG_FileReplay_Format, "csv");
+    settings.endGroup();
+
+    QBuffer bufferDev;          // not actually used
+    FileReplayReader reader(&bufferDev);
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    QSignalSpy spy(&reader, SIGNAL(finished()));
+    REQUIRE(reader.start());
+    REQUIRE(spy.wait(1000));
+    REQUIRE(sink._numChannels == 2);
+    REQUIRE(sink.totalFed == 3);
+    REQUIRE(reader.samplesReplayed() == 3);
+
+    QFile::remove(fileName);
+}
+
 // Note: this is added because `QApplication` must be created for widgets
 #include <QApplication>
 int main(int argc, char* argv[])
@@ -20,7 +20,9 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch.hpp"
 
+#include <limits>
 #include <QDir>
+#include <QFileInfo>
 #include "datarecorder.h"
 #include "test_helpers.h"
 
@@ -47,7 +49,8 @@ TEST_CASE("test recording single channel", "[recorder]")
     }
 
     // test
-    rec.startRecording(fileName, ",", channelNames, false);
+    rec.startRecording(fileName, ",", channelNames,
+                       DataRecorder::TimestampOption::disabled);
     source._feed(samples);
     rec.stopRecording();
 
@@ -87,7 +90,8 @@ TEST_CASE("test recording multiple channels", "[recorder]")
     }
 
     // test
-    rec.startRecording(fileName, ",", channelNames, false);
+    rec.startRecording(fileName, ",", channelNames,
+                       DataRecorder::TimestampOption::disabled);
     source._feed(samples);
     rec.stopRecording();
 
@@ -105,3 +109,111 @@ TEST_CASE("test recording multiple channels", "[recorder]")
     // cleanup
     if (QFile::exists(fileName)) QFile::remove(fileName);
 }
+
+TEST_CASE("gaps are recorded as empty fields", "[recorder]")
+{
+    DataRecorder rec;
+    TestSource source(2, false);
+
+    // temporary file, remove if exists
+    auto fileName = QDir::tempPath() + QString("/" TEST_FILE_NAME);
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+
+    source.connectSink(&rec);
+
+    // middle sample is a gap
+    QStringList channelNames({"Channel 1", "Channel 2"});
+    SamplePack samples(3, 2);
+    for (int ci = 0; ci < 2; ci++)
+    {
+        samples.data(ci)[0] = ci+1;
+        samples.data(ci)[1] = std::numeric_limits<double>::quiet_NaN();
+        samples.data(ci)[2] = ci+3;
+    }
+
+    rec.startRecording(fileName, ",", channelNames,
+                       DataRecorder::TimestampOption::disabled);
+    source._feed(samples);
+    rec.stopRecording();
+
+    QFile recordFile(fileName);
+    REQUIRE(recordFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    REQUIRE((recordFile.readLine() == "Channel 1,Channel 2\n"));
+    REQUIRE((recordFile.readLine() == "1,2\n"));
+    REQUIRE((recordFile.readLine() == ",\n"));
+    REQUIRE((recordFile.readLine() == "3,4\n"));
+
+    // cleanup
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+}
+
+TEST_CASE("recovering an interrupted recording drops the partial line", "[recorder]")
+{
+    auto fileName = QDir::tempPath() + QString("/" TEST_FILE_NAME);
+    QFile::remove(DataRecorder::checkpointFileName(fileName));
+
+    // simulate a recording that ended mid-line
+    {
+        QFile recordFile(fileName);
+        REQUIRE(recordFile.open(QIODevice::WriteOnly));
+        recordFile.write("Channel 1\n1\n2\n3");
+    }
+
+    // asking doesn't modify the file
+    REQUIRE(DataRecorder::recoveredSize(fileName) == 14);
+    REQUIRE(QFileInfo(fileName).size() == 15);
+
+    REQUIRE(DataRecorder::recoverRecording(fileName) == 14);
+
+    QFile recordFile(fileName);
+    REQUIRE(recordFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    REQUIRE((recordFile.readAll() == "Channel 1\n1\n2\n"));
+
+    // cleanup
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+}
+
+TEST_CASE("recovering a checkpointed recording", "[recorder]")
+{
+    DataRecorder rec;
+    TestSource source(1, false);
+
+    // temporary file, remove if exists
+    auto fileName = QDir::tempPath() + QString("/" TEST_FILE_NAME);
+    auto ckptName = DataRecorder::checkpointFileName(fileName);
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+    if (QFile::exists(ckptName + ".bak")) QFile::remove(ckptName + ".bak");
+
+    source.connectSink(&rec);
+
+    SamplePack samples(3, 1);
+    for (int i = 0; i < 3; i++)
+    {
+        samples.data(0)[i] = i+1;
+    }
+
+    rec.setDecimals(0);
+    rec.setCheckpointInterval(60000); // long enough to not trigger by itself
+    REQUIRE(rec.startRecording(fileName, ",", {"Channel 1"},
+                               DataRecorder::TimestampOption::disabled));
+    source._feed(samples);
+    rec.checkpoint();
+    REQUIRE(rec.durableSamples() == 3);
+
+    // keep the checkpoint, as if we crashed after writing some more data
+    REQUIRE(QFile::copy(ckptName, ckptName + ".bak"));
+    source._feed(samples);
+    rec.stopRecording();
+    REQUIRE_FALSE(QFile::exists(ckptName)); // removed on clean stop
+    REQUIRE(QFile::rename(ckptName + ".bak", ckptName));
+
+    REQUIRE(DataRecorder::recoverRecording(fileName) > 0);
+    REQUIRE_FALSE(QFile::exists(ckptName));
+
+    QFile recordFile(fileName);
+    REQUIRE(recordFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    REQUIRE((recordFile.readAll() == "Channel 1\n1\n2\n3\n"));
+
+    // cleanup
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+}